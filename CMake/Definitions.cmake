@@ -21,6 +21,7 @@ foreach(
   SCREEN_READER_INTEGRATION
   UNPACKED_MPQS
   UNPACKED_SAVES
+  DISABLE_MEMORY_MAPPED_ASSETS
   DEVILUTIONX_WINDOWS_NO_WCHAR
 )
   if(${def_name})
@@ -0,0 +1,179 @@
+#include "data/record_cache.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+
+#include "config.h"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+std::string CacheDirectory;
+
+constexpr char CacheMagic[4] = { 'D', 'X', 'R', 'C' };
+// Bump whenever the layout of the header or of the stored values changes.
+constexpr uint32_t CacheFormatVersion = 2;
+
+struct CacheHeader {
+	char magic[4];
+	uint32_t formatVersion;
+	uint64_t key;
+	uint64_t payloadSize;
+	uint64_t payloadChecksum;
+};
+
+/** @brief Values are stored as they are laid out in memory, so a cache written by a build with other sizes or byte order is a miss. */
+constexpr uint8_t AbiTag[] = {
+	std::endian::native == std::endian::little ? 1 : 2,
+	sizeof(bool),
+	sizeof(short),
+	sizeof(int),
+	sizeof(long),
+	sizeof(long long),
+	sizeof(size_t),
+	sizeof(float),
+	sizeof(double),
+	alignof(std::max_align_t),
+};
+
+uint64_t Fnv1a(std::string_view data, uint64_t hash = 0xcbf29ce484222325)
+{
+	for (const char c : data) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+std::string GetCachePath(std::string_view dataFilePath)
+{
+	std::string path = StrCat(CacheDirectory, DIRECTORY_SEPARATOR_STR, dataFilePath, ".bin");
+	for (size_t i = CacheDirectory.size() + 1; i < path.size(); ++i) {
+		if (path[i] == '\\' || path[i] == '/')
+			path[i] = '_';
+	}
+	return path;
+}
+
+uint64_t GetPayloadChecksum(const std::vector<std::byte> &payload)
+{
+	return Fnv1a({ reinterpret_cast<const char *>(payload.data()), payload.size() });
+}
+
+uint64_t GetCacheKey(const DataFile &dataFile, uint32_t schemaVersion)
+{
+	uint64_t key = Fnv1a(PROJECT_VERSION);
+	key = Fnv1a({ reinterpret_cast<const char *>(AbiTag), sizeof(AbiTag) }, key);
+	key = Fnv1a({ reinterpret_cast<const char *>(&schemaVersion), sizeof(schemaVersion) }, key);
+	return Fnv1a({ dataFile.data(), dataFile.size() }, key);
+}
+
+} // namespace
+
+void SetRecordCacheDirectory(std::string path)
+{
+	CacheDirectory = std::move(path);
+}
+
+RecordCache::RecordCache(std::string_view dataFilePath, const DataFile &dataFile, uint32_t schemaVersion)
+    : key_(GetCacheKey(dataFile, schemaVersion))
+{
+	if (CacheDirectory.empty())
+		return;
+	path_ = GetCachePath(dataFilePath);
+
+	FILE *file = OpenFile(path_.c_str(), "rb");
+	if (file == nullptr)
+		return;
+	CacheHeader header;
+	if (std::fread(&header, sizeof(header), 1, file) == 1
+	    && std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0
+	    && header.formatVersion == CacheFormatVersion
+	    && header.key == key_) {
+		data_.resize(static_cast<size_t>(header.payloadSize));
+		replaying_ = (data_.empty() || std::fread(data_.data(), data_.size(), 1, file) == 1)
+		    && GetPayloadChecksum(data_) == header.payloadChecksum;
+	}
+	std::fclose(file);
+	if (!replaying_) {
+		LogVerbose("Record cache {} is out of date", path_);
+		data_.clear();
+	}
+}
+
+void RecordCache::writeString(std::string_view value)
+{
+	if (path_.empty()) return;
+	write(static_cast<uint32_t>(value.size()));
+	const auto *bytes = reinterpret_cast<const std::byte *>(value.data());
+	data_.insert(data_.end(), bytes, bytes + value.size());
+}
+
+std::string_view RecordCache::readString()
+{
+	uint32_t size;
+	read(size);
+	const std::byte *bytes = take(size);
+	if (bytes == nullptr)
+		return {};
+	return { reinterpret_cast<const char *>(bytes), size };
+}
+
+const std::byte *RecordCache::take(size_t size)
+{
+	if (overrun_ || data_.size() - pos_ < size) {
+		// The loader reads more than was recorded, finishReplay() turns this into a miss.
+		overrun_ = true;
+		return nullptr;
+	}
+	const std::byte *result = data_.data() + pos_;
+	pos_ += size;
+	return result;
+}
+
+bool RecordCache::finishReplay()
+{
+	if (!replaying_ || (!overrun_ && pos_ == data_.size()))
+		return true;
+
+	LogWarn("Record cache {} doesn't match the data file loader, parsing the file again", path_);
+	replaying_ = false;
+	overrun_ = false;
+	pos_ = 0;
+	data_.clear();
+	return false;
+}
+
+void RecordCache::save()
+{
+	if (replaying_ || path_.empty())
+		return;
+
+	RecursivelyCreateDir(CacheDirectory.c_str());
+	const std::string tempPath = StrCat(path_, ".tmp");
+	FILE *file = OpenFile(tempPath.c_str(), "wb");
+	if (file == nullptr) {
+		LogWarn("Failed to create record cache {}", tempPath);
+		return;
+	}
+	CacheHeader header {};
+	std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+	header.formatVersion = CacheFormatVersion;
+	header.key = key_;
+	header.payloadSize = data_.size();
+	header.payloadChecksum = GetPayloadChecksum(data_);
+	const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+	    && (data_.empty() || std::fwrite(data_.data(), data_.size(), 1, file) == 1);
+	std::fclose(file);
+	if (!written || !SyncAndReplaceFile(tempPath.c_str(), path_.c_str())) {
+		LogWarn("Failed to write record cache {}", path_);
+		RemoveFile(tempPath.c_str());
+	}
+}
+
+} // namespace devilution
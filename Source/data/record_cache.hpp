@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "data/file.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Sets the directory used to cache parsed data files, an empty path disables the cache.
+ */
+void SetRecordCacheDirectory(std::string path);
+
+/**
+ * @brief Binary cache of the values a RecordReader reads from a data file
+ *
+ * Values are stored in the order they are read, so a loader that reads the same file the same way can replay them
+ * instead of parsing the text. The cache is keyed by a hash of the file contents, the game version, the loader's schema
+ * version and the sizes and byte order of the build. Anything else is a miss and the file is parsed (and cached) again.
+ *
+ * A cache is never trusted further than that: loaders run in a loop until finishReplay() accepts the pass, so a cache
+ * that doesn't match what the loader reads is parsed again instead of failing.
+ */
+class RecordCache {
+public:
+	/**
+	 * @brief Opens the cache for a data file, replaying it if it matches the file contents.
+	 * @param dataFilePath path used to load the data file, including the /txtdata/ prefix
+	 * @param dataFile the loaded data file
+	 * @param schemaVersion bump whenever the loader reads different values, or values of a different type
+	 */
+	RecordCache(std::string_view dataFilePath, const DataFile &dataFile, uint32_t schemaVersion);
+
+	[[nodiscard]] bool replaying() const
+	{
+		return replaying_;
+	}
+
+	/**
+	 * @brief Checks that a replay read exactly the recorded values.
+	 *
+	 * Otherwise the cache is a miss: it switches to recording and the loader has to read the data file again.
+	 * @return false if the loader has to run again
+	 */
+	bool finishReplay();
+
+	/**
+	 * @brief Stops recording, used when a loader reads a value that can't be stored (e.g. a function pointer).
+	 */
+	void disable()
+	{
+		path_.clear();
+		data_.clear();
+	}
+
+	template <typename T>
+	void write(const T &value)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>);
+		if (path_.empty()) return;
+		const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+		data_.insert(data_.end(), bytes, bytes + sizeof(T));
+	}
+
+	void writeString(std::string_view value);
+
+	template <typename T>
+	void read(T &out)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>);
+		if (const std::byte *bytes = take(sizeof(T)); bytes != nullptr)
+			std::memcpy(&out, bytes, sizeof(T));
+		else
+			std::memset(&out, 0, sizeof(T));
+	}
+
+	/**
+	 * @brief Reads a string stored with writeString, the view is valid for the lifetime of the cache.
+	 */
+	std::string_view readString();
+
+	/**
+	 * @brief Writes the recorded values to disk, does nothing when replaying or when the cache is disabled.
+	 */
+	void save();
+
+private:
+	/** @brief Returns the next size bytes of the replay, or nullptr if the cache is too short */
+	const std::byte *take(size_t size);
+
+	std::string path_;
+	uint64_t key_;
+	std::vector<std::byte> data_;
+	size_t pos_ = 0;
+	bool replaying_ = false;
+	bool overrun_ = false;
+};
+
+} // namespace devilution
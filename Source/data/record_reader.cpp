@@ -4,6 +4,8 @@ namespace devilution {
 
 void RecordReader::advance()
 {
+	if (replaying())
+		return;
 	if (needsIncrement_) {
 		++it_;
 	} else {
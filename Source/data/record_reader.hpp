@@ -9,11 +9,15 @@
 
 #include "data/file.hpp"
 #include "data/iterators.hpp"
+#include "data/record_cache.hpp"
 
 namespace devilution {
 
 /**
  * @brief A record reader that treats every error as fatal.
+ *
+ * When given a RecordCache the reader stores every value it parses, or replays the cached values without parsing
+ * the record at all.
  */
 class RecordReader {
 public:
@@ -24,86 +28,131 @@ public:
 	{
 	}
 
+	RecordReader(DataFileRecord &record, std::string_view filename, RecordCache &cache)
+	    : RecordReader(record, filename)
+	{
+		cache_ = &cache;
+	}
+
 	template <typename T>
 	typename std::enable_if_t<std::is_integral_v<T>, void>
 	readInt(std::string_view name, T &out)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseInt(out), name, field);
+		record(out);
 	}
 
 	template <typename T>
 	typename std::enable_if_t<std::is_integral_v<T>, void>
 	readOptionalInt(std::string_view name, T &out)
 	{
+		bool present;
+		if (replay(present)) {
+			if (present) cache_->read(out);
+			return;
+		}
 		DataFileField field = nextField();
-		if (field.value().empty()) return;
+		present = !field.value().empty();
+		record(present);
+		if (!present) return;
 		failOnError(field.parseInt(out), name, field);
+		record(out);
 	}
 
 	template <typename T, size_t N>
 	void readIntArray(std::string_view name, T (&out)[N])
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseIntArray(out), name, field);
+		record(out);
 	}
 
 	template <typename T, size_t N, typename F>
 	void readEnumArray(std::string_view name, std::optional<T> fillMissing, T (&out)[N], F &&parseFn)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseEnumArray(out, fillMissing, parseFn), name, field, DataFileField::Error::InvalidValue);
+		record(out);
 	}
 
 	template <typename T, size_t N>
 	void readIntArray(std::string_view name, std::array<T, N> &out)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseIntArray(out), name, field);
+		record(out);
 	}
 
 	template <typename T>
 	typename std::enable_if_t<std::is_integral_v<T>, void>
 	readFixed6(std::string_view name, T &out)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseFixed6(out), name, field);
+		record(out);
 	}
 
 	void readBool(std::string_view name, bool &out)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseBool(out), name, field);
+		record(out);
 	}
 
 	void readString(std::string_view name, std::string &out)
 	{
+		if (replaying()) {
+			out = cache_->readString();
+			return;
+		}
 		advance();
 		out = (*it_).value();
+		if (cache_ != nullptr) cache_->writeString(out);
 	}
 
 	template <typename T, typename F>
 	void read(std::string_view name, T &out, F &&parseFn)
 	{
+		if constexpr (IsCacheable<T>) {
+			if (replay(out)) return;
+		} else if (cache_ != nullptr) {
+			cache_->disable();
+		}
 		DataFileField field = nextField();
 		tl::expected<T, std::string> result = parseFn(field.value());
 		failOnError(result, name, field, DataFileField::Error::InvalidValue);
 		out = *std::move(result);
+		if constexpr (IsCacheable<T>) record(out);
 	}
 
 	template <typename T, typename F>
 	void readEnumList(std::string_view name, T &out, F &&parseFn)
 	{
+		if (replay(out)) return;
 		DataFileField field = nextField();
 		failOnError(field.parseEnumList(out, std::forward<F>(parseFn)),
 		    name, field, DataFileField::Error::InvalidValue);
+		record(out);
 	}
 
 	std::string_view value()
 	{
+		if (replaying()) {
+			// Peeks at the field, the next read returns the same field again.
+			return cache_->readString();
+		}
 		advance();
 		needsIncrement_ = false;
-		return (*it_).value();
+		const std::string_view result = (*it_).value();
+		if (cache_ != nullptr) cache_->writeString(result);
+		return result;
 	}
 
 	void advance();
@@ -115,6 +164,28 @@ public:
 	}
 
 private:
+	template <typename T>
+	static constexpr bool IsCacheable = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+	[[nodiscard]] bool replaying() const
+	{
+		return cache_ != nullptr && cache_->replaying();
+	}
+
+	template <typename T>
+	bool replay(T &out)
+	{
+		if (!replaying()) return false;
+		cache_->read(out);
+		return true;
+	}
+
+	template <typename T>
+	void record(const T &value)
+	{
+		if (cache_ != nullptr) cache_->write(value);
+	}
+
 	template <typename T>
 	void failOnError(const tl::expected<T, DataFileField::Error> &result, std::string_view name, const DataFileField &field)
 	{
@@ -134,6 +205,7 @@ private:
 	FieldIterator it_;
 	const FieldIterator end_;
 	std::string_view filename_;
+	RecordCache *cache_ = nullptr;
 	bool needsIncrement_ = false;
 };
 
@@ -18,6 +18,7 @@
 #include "capture.h"
 #include "control.h"
 #include "cursor.h"
+#include "data/record_cache.hpp"
 #include "dead.h"
 #ifdef _DEBUG
 #include "debug.h"
@@ -31,6 +32,7 @@
 #include "diablo_msg.hpp"
 #include "DiabloUI/ui_flags.hpp"
 #include "doom.h"
+#include "engine/asset_loader.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "mods/mod_init.h"
 #include "engine/clx_sprite.hpp"
@@ -42,6 +44,7 @@
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
 #include "engine/sound.h"
+#include "engine/tick_profiler.hpp"
 #include "game_mode.hpp"
 #include "gamemenu.h"
 #include "gmenu.h"
@@ -843,6 +846,7 @@ void GameEventHandler(const SDL_Event &event, uint16_t modState)
 void RunGameLoop(interface_mode uMsg)
 {
 	demo::NotifyGameLoopStart();
+	TickProfilerReset();
 
 	nthread_ignore_mutex(true);
 	StartGame(uMsg);
@@ -933,6 +937,8 @@ void RunGameLoop(interface_mode uMsg)
 	}
 
 	demo::NotifyGameLoopEnd();
+	if (TickProfilerEnabled)
+		WriteTickProfileCsv();
 
 	if (gbIsMultiplayer) {
 		pfile_write_hero(/*writeGameData=*/false);
@@ -984,6 +990,7 @@ void PrintHelpOption(std::string_view flags, std::string_view description)
 	PrintHelpOption("-n", _(/* TRANSLATORS: Commandline Option */ "Skip startup videos"));
 	PrintHelpOption("-f", _(/* TRANSLATORS: Commandline Option */ "Display frames per second"));
 	PrintHelpOption("--verbose", _(/* TRANSLATORS: Commandline Option */ "Enable verbose logging"));
+	PrintHelpOption("--tick-profile", _(/* TRANSLATORS: Commandline Option */ "Time game logic phases and write tick_profile.csv"));
 #ifndef DISABLE_DEMOMODE
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
@@ -1116,6 +1123,8 @@ void DiabloParseFlags(int argc, char **argv)
 			gbVanilla = true;
 		} else if (arg == "--verbose") {
 			SDL_LogSetAllPriority(SDL_LOG_PRIORITY_VERBOSE);
+		} else if (arg == "--tick-profile") {
+			TickProfilerEnabled = true;
 #ifdef _DEBUG
 		} else if (arg == "-i") {
 			DebugDisableNetworkTimeout = true;
@@ -1456,38 +1465,47 @@ void UpdateMonsterLights()
 	}
 }
 
+void SetGameLogicStep(GameLogicStep step)
+{
+	if (TickProfilerEnabled)
+		TickProfilerEnterStep(step);
+	gGameLogicStep = step;
+}
+
 void GameLogic()
 {
 	if (!ProcessInput()) {
 		return;
 	}
 	if (gbProcessPlayers) {
-		gGameLogicStep = GameLogicStep::ProcessPlayers;
+		SetGameLogicStep(GameLogicStep::ProcessPlayers);
 		ProcessPlayers();
 	}
 	if (leveltype != DTYPE_TOWN) {
-		gGameLogicStep = GameLogicStep::ProcessMonsters;
+		SetGameLogicStep(GameLogicStep::ProcessMonsters);
 #ifdef _DEBUG
 		if (!DebugInvisible)
 #endif
 			ProcessMonsters();
-		gGameLogicStep = GameLogicStep::ProcessObjects;
+		SetGameLogicStep(GameLogicStep::ProcessObjects);
 		ProcessObjects();
-		gGameLogicStep = GameLogicStep::ProcessMissiles;
+		SetGameLogicStep(GameLogicStep::ProcessMissiles);
 		ProcessMissiles();
-		gGameLogicStep = GameLogicStep::ProcessItems;
+		SetGameLogicStep(GameLogicStep::ProcessItems);
 		ProcessItems();
+		SetGameLogicStep(GameLogicStep::ProcessLightList);
 		ProcessLightList();
+		SetGameLogicStep(GameLogicStep::ProcessVisionList);
 		ProcessVisionList();
 	} else {
-		gGameLogicStep = GameLogicStep::ProcessTowners;
+		SetGameLogicStep(GameLogicStep::ProcessTowners);
 		ProcessTowners();
-		gGameLogicStep = GameLogicStep::ProcessItemsTown;
+		SetGameLogicStep(GameLogicStep::ProcessItemsTown);
 		ProcessItems();
-		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
+		SetGameLogicStep(GameLogicStep::ProcessMissilesTown);
 		ProcessMissiles();
 	}
-	gGameLogicStep = GameLogicStep::None;
+	SetGameLogicStep(GameLogicStep::None);
 
 #ifdef _DEBUG
 	if (DebugScrollViewEnabled && (SDL_GetModState() & KMOD_SHIFT) != 0) {
@@ -2614,6 +2632,9 @@ int DiabloMain(int argc, char **argv)
 	// Finally load game data
 	LoadGameArchives();
 
+	// Parsed data files are cached so later runs can skip parsing the text.
+	SetRecordCacheDirectory(StrCat(paths::PrefPath(), "cache"));
+
 	// Load dynamic data before we go into the menu as we need to initialise player characters in memory pretty early.
 	LoadPlayerDataFiles();
 
@@ -3022,7 +3043,7 @@ void LoadGameLevelSyncPlayerEntry(lvl_entry lvldir)
 void LoadGameLevelLightVision()
 {
 	if (leveltype != DTYPE_TOWN) {
-		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                                          // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 		ProcessLightList();
 		ProcessVisionList();
@@ -3219,6 +3240,48 @@ void LoadGameLevelCalculateCursor()
 	CheckCursMove();
 }
 
+void PrefetchLevelGraphics(dungeon_type type)
+{
+	std::string_view base;
+	std::string_view special;
+	switch (type) {
+	case DTYPE_TOWN:
+		base = gbIsHellfire ? "nlevels\\towndata\\town" : "levels\\towndata\\town";
+		special = "levels\\towndata\\towns";
+		break;
+	case DTYPE_CATHEDRAL:
+		base = "levels\\l1data\\l1";
+		special = "levels\\l1data\\l1s";
+		break;
+	case DTYPE_CATACOMBS:
+		base = "levels\\l2data\\l2";
+		special = "levels\\l2data\\l2s";
+		break;
+	case DTYPE_CAVES:
+		base = "levels\\l3data\\l3";
+		special = "levels\\l1data\\l1s";
+		break;
+	case DTYPE_HELL:
+		base = "levels\\l4data\\l4";
+		special = "levels\\l2data\\l2s";
+		break;
+	case DTYPE_NEST:
+		base = "nlevels\\l6data\\l6";
+		special = "levels\\l1data\\l1s";
+		break;
+	case DTYPE_CRYPT:
+		base = "nlevels\\l5data\\l5";
+		special = "nlevels\\l5data\\l5s";
+		break;
+	default:
+		return;
+	}
+	// The same files as LoadLvlGFX, LoadMinData and LoadLevelSOLData
+	for (const std::string_view extension : { ".cel", ".til", ".min", ".sol" })
+		PrefetchAsset(StrCat(base, extension));
+	PrefetchAsset(StrCat(special, DEVILUTIONX_CEL_EXT));
+}
+
 tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 {
 	_music_id neededTrack = GetLevelMusic(leveltype);
@@ -46,9 +46,14 @@ enum class GameLogicStep : uint8_t {
 	ProcessObjects,
 	ProcessMissiles,
 	ProcessItems,
+	ProcessLightList,
+	ProcessVisionList,
 	ProcessTowners,
 	ProcessItemsTown,
 	ProcessMissilesTown,
+
+	FIRST = None,
+	LAST = ProcessMissilesTown
 };
 
 enum class MouseActionType : uint8_t {
@@ -95,6 +100,8 @@ void diablo_focus_unpause();
 bool PressEscKey();
 void DisableInputEventHandler(const SDL_Event &event, uint16_t modState);
 tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir);
+/** @brief Starts reading the tiles of the given level type in the background, to speed up entering such a level. */
+void PrefetchLevelGraphics(dungeon_type type);
 bool IsDiabloAlive(bool playSFX);
 void PrintScreen(SDL_Keycode vkey);
 
@@ -19,6 +19,13 @@ public:
 	virtual int create(std::string_view addrstr) = 0;
 	virtual int join(std::string_view addrstr) = 0;
 	virtual bool SNetReceiveMessage(uint8_t *sender, void **data, size_t *size) = 0;
+
+	/** @brief Nanoseconds the last received message was queued for after being read from the network, 0 if unknown. */
+	virtual uint64_t SNetGetMessageQueueTime()
+	{
+		return 0;
+	}
+
 	virtual bool SNetSendMessage(uint8_t dest, void *data, size_t size) = 0;
 	virtual bool SNetReceiveTurns(char **data, size_t *size, uint32_t *status) = 0;
 	virtual bool SNetSendTurn(char *data, size_t size) = 0;
@@ -212,10 +212,12 @@ tl::expected<void, PacketError> base::RecvLocal(packet &pkt)
 
 bool base::SNetReceiveMessage(uint8_t *sender, void **data, size_t *size)
 {
-	poll();
+	// The caller drains the queue in a loop, only go back to the sockets once it has run dry
+	if (message_queue.empty())
+		poll();
 	if (message_queue.empty())
 		return false;
-	message_last = message_queue.front();
+	message_last = std::move(message_queue.front());
 	message_queue.pop_front();
 	*sender = message_last.sender;
 	*size = message_last.payload.size();
@@ -223,6 +225,14 @@ bool base::SNetReceiveMessage(uint8_t *sender, void **data, size_t *size)
 	return true;
 }
 
+uint64_t base::SNetGetMessageQueueTime()
+{
+	if (message_last.received == std::chrono::steady_clock::time_point {})
+		return 0;
+	const auto queued = std::chrono::steady_clock::now() - message_last.received;
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(queued).count());
+}
+
 bool base::SNetSendMessage(uint8_t playerId, void *data, size_t size)
 {
 	if (playerId != SNPLAYER_OTHERS && playerId >= MAX_PLRS)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -19,6 +20,7 @@ namespace net {
 class base : public abstract_net {
 public:
 	bool SNetReceiveMessage(uint8_t *sender, void **data, size_t *size) override;
+	uint64_t SNetGetMessageQueueTime() override;
 	bool SNetSendMessage(uint8_t playerId, void *data, size_t size) override;
 	bool SNetReceiveTurns(char **data, size_t *size, uint32_t *status) override;
 	bool SNetSendTurn(char *data, size_t size) override;
@@ -48,6 +50,7 @@ protected:
 	struct message_t {
 		uint8_t sender;
 		buffer_t payload;
+		std::chrono::steady_clock::time_point received;
 		message_t()
 		    : sender(-1)
 		    , payload({})
@@ -55,7 +58,8 @@ protected:
 		}
 		message_t(int s, buffer_t p)
 		    : sender(s)
-		    , payload(p)
+		    , payload(std::move(p))
+		    , received(std::chrono::steady_clock::now())
 		{
 		}
 	};
@@ -1,5 +1,6 @@
 #include "dvlnet/frame_queue.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "appfat.h"
@@ -25,29 +26,42 @@ framesize_t frame_queue::Size() const
 	return current_size;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::Read(framesize_t s)
+tl::expected<void, PacketError> frame_queue::Read(unsigned char *dst, framesize_t s)
 {
 	if (current_size < s)
 		return tl::make_unexpected(FrameQueueError());
-	buffer_t ret;
-	while (s > 0 && s >= buffer_deque.front().size()) {
-		framesize_t bufferSize = static_cast<framesize_t>(buffer_deque.front().size());
-		s -= bufferSize;
-		current_size -= bufferSize;
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().end());
-		buffer_deque.pop_front();
-	}
-	if (s > 0) {
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		buffer_deque.front().erase(buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		current_size -= s;
+	current_size -= s;
+	while (s > 0) {
+		buffer_t &front = buffer_deque.front();
+		const size_t chunkSize = std::min<size_t>(s, front.size() - front_offset);
+		std::memcpy(dst, front.data() + front_offset, chunkSize);
+		dst += chunkSize;
+		s -= static_cast<framesize_t>(chunkSize);
+		front_offset += chunkSize;
+		if (front_offset == front.size()) {
+			RecycleBuffer(std::move(front));
+			buffer_deque.pop_front();
+			front_offset = 0;
+		}
 	}
-	return ret;
+	return {};
+}
+
+void frame_queue::RecycleBuffer(buffer_t &&buf)
+{
+	if (buffer_pool.size() >= max_pooled_buffers)
+		return;
+	buf.clear();
+	buffer_pool.push_back(std::move(buf));
+}
+
+buffer_t frame_queue::AcquireBuffer()
+{
+	if (buffer_pool.empty())
+		return {};
+	buffer_t buf = std::move(buffer_pool.back());
+	buffer_pool.pop_back();
+	return buf;
 }
 
 void frame_queue::Write(buffer_t buf)
@@ -61,10 +75,10 @@ tl::expected<bool, PacketError> frame_queue::PacketReady()
 	if (nextsize == 0) {
 		if (Size() < sizeof(framesize_t))
 			return false;
-		tl::expected<buffer_t, PacketError> szbuf = Read(sizeof(framesize_t));
-		if (!szbuf.has_value())
-			return tl::make_unexpected(szbuf.error());
-		nextsize = LoadLE32(szbuf->data());
+		unsigned char szbuf[sizeof(framesize_t)];
+		if (tl::expected<void, PacketError> result = Read(szbuf, sizeof(szbuf)); !result.has_value())
+			return tl::make_unexpected(result.error());
+		nextsize = LoadLE32(szbuf);
 		if (nextsize == 0)
 			return tl::make_unexpected(FrameQueueError());
 	}
@@ -75,18 +89,22 @@ tl::expected<buffer_t, PacketError> frame_queue::ReadPacket()
 {
 	if (nextsize == 0 || Size() < nextsize)
 		return tl::make_unexpected(FrameQueueError());
-	tl::expected<buffer_t, PacketError> ret = Read(nextsize);
+	buffer_t ret(nextsize);
+	tl::expected<void, PacketError> result = Read(ret.data(), nextsize);
 	nextsize = 0;
+	if (!result.has_value())
+		return tl::make_unexpected(result.error());
 	return ret;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(buffer_t packetbuf)
+tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(const buffer_t &packetbuf)
 {
 	buffer_t ret;
 	framesize_t size = static_cast<framesize_t>(packetbuf.size());
 	if (size > max_frame_size)
 		return tl::make_unexpected("Buffer exceeds maximum frame size");
 	static_assert(sizeof(size) == 4, "framesize_t is not 4 bytes");
+	ret.reserve(sizeof(size) + packetbuf.size());
 	unsigned char sizeBuf[4];
 	WriteLE32(sizeBuf, size);
 	ret.insert(ret.end(), sizeBuf, sizeBuf + 4);
@@ -20,19 +20,32 @@ public:
 	constexpr static framesize_t max_frame_size = 0xFFFF;
 
 private:
+	/** @brief How many fully read buffers are kept around for AcquireBuffer(). */
+	constexpr static size_t max_pooled_buffers = 4;
+
 	framesize_t current_size = 0;
 	std::deque<buffer_t> buffer_deque;
+	/** @brief Number of bytes of buffer_deque.front() that have already been read. */
+	size_t front_offset = 0;
 	framesize_t nextsize = 0;
+	std::vector<buffer_t> buffer_pool;
 
 	framesize_t Size() const;
-	tl::expected<buffer_t, PacketError> Read(framesize_t s);
+	tl::expected<void, PacketError> Read(unsigned char *dst, framesize_t s);
+	void RecycleBuffer(buffer_t &&buf);
 
 public:
 	tl::expected<bool, PacketError> PacketReady();
 	tl::expected<buffer_t, PacketError> ReadPacket();
 	void Write(buffer_t buf);
 
-	static tl::expected<buffer_t, PacketError> MakeFrame(buffer_t packetbuf);
+	/**
+	 * @brief Returns an empty buffer to receive into, reusing the allocation
+	 * of a buffer that has been fully read if there is one.
+	 */
+	buffer_t AcquireBuffer();
+
+	static tl::expected<buffer_t, PacketError> MakeFrame(const buffer_t &packetbuf);
 };
 
 } // namespace net
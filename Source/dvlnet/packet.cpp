@@ -205,14 +205,13 @@ tl::expected<void, PacketError> packet_in::Create(buffer_t buf)
 	if (buf.size() < sizeof(packet_type) + 2 * sizeof(plr_t))
 		return tl::make_unexpected(PacketError());
 
-	decrypted_buffer = std::move(buf);
-	have_decrypted = true;
-
 	// TCP server implementation forwards the original data to clients
 	// so although we are not decrypting anything,
-	// we save a copy in encrypted_buffer anyway
-	encrypted_buffer = decrypted_buffer;
+	// we keep it in encrypted_buffer and parse it from there
+	encrypted_buffer = std::move(buf);
 	have_encrypted = true;
+	have_decrypted = true;
+	unread = encrypted_buffer;
 	return {};
 }
 
@@ -241,6 +240,7 @@ tl::expected<void, PacketError> packet_in::Decrypt(buffer_t buf)
 		return tl::make_unexpected(PacketError());
 
 	have_decrypted = true;
+	unread = decrypted_buffer;
 	return {};
 }
 #endif
@@ -254,10 +254,7 @@ void packet_out::Encrypt()
 		return;
 
 	auto lenCleartext = decrypted_buffer.size();
-	encrypted_buffer.insert(encrypted_buffer.begin(),
-	    crypto_secretbox_NONCEBYTES, 0);
-	encrypted_buffer.insert(encrypted_buffer.end(),
-	    crypto_secretbox_MACBYTES + lenCleartext, 0);
+	encrypted_buffer.resize(crypto_secretbox_NONCEBYTES + crypto_secretbox_MACBYTES + lenCleartext);
 	randombytes_buf(encrypted_buffer.data(), crypto_secretbox_NONCEBYTES);
 	int status = crypto_secretbox_easy(
 	    encrypted_buffer.data() + crypto_secretbox_NONCEBYTES,
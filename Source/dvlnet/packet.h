@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 
@@ -163,6 +164,10 @@ public:
 	template <class T>
 	tl::expected<void, PacketError> process_element(T &x);
 	tl::expected<void, PacketError> Decrypt(buffer_t buf);
+
+private:
+	/** @brief Part of the decrypted data that process_data() hasn't consumed yet. */
+	std::span<const unsigned char> unread;
 };
 
 class packet_out : public packet_proc<packet_out> {
@@ -227,8 +232,8 @@ tl::expected<void, PacketError> packet_proc<P>::process_data()
 
 inline tl::expected<void, PacketError> packet_in::process_element(buffer_t &x)
 {
-	x.insert(x.begin(), decrypted_buffer.begin(), decrypted_buffer.end());
-	decrypted_buffer.resize(0);
+	x.assign(unread.begin(), unread.end());
+	unread = {};
 	return {};
 }
 
@@ -237,18 +242,17 @@ tl::expected<void, PacketError> packet_in::process_element(T &x)
 {
 	static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Unsupported T");
 	static_assert(sizeof(T) == 4 || sizeof(T) == 2 || sizeof(T) == 1, "Unsupported T");
-	if (decrypted_buffer.size() < sizeof(T)) {
+	if (unread.size() < sizeof(T)) {
 		return tl::make_unexpected(PacketError());
 	}
 	if (sizeof(T) == 4) {
-		x = static_cast<T>(LoadLE32(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE32(unread.data()));
 	} else if (sizeof(T) == 2) {
-		x = static_cast<T>(LoadLE16(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE16(unread.data()));
 	} else if (sizeof(T) == 1) {
-		std::memcpy(&x, decrypted_buffer.data(), sizeof(T));
+		std::memcpy(&x, unread.data(), sizeof(T));
 	}
-	decrypted_buffer.erase(decrypted_buffer.begin(),
-	    decrypted_buffer.begin() + sizeof(T));
+	unread = unread.subspan(sizeof(T));
 	return {};
 }
 
@@ -95,7 +95,7 @@ tl::expected<void, PacketError> protocol_zt::send(const endpoint &peer, const bu
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(data);
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	peer_list[peer].send_queue.push_back(*frame);
+	peer_list[peer].send_queue.push_back(std::move(*frame));
 	return {};
 }
 
@@ -160,7 +160,9 @@ bool protocol_zt::recv_peer(const endpoint &peer)
 	while (true) {
 		auto len = lwip_recv(state.fd, buf, sizeof(buf), 0);
 		if (len >= 0) {
-			state.recv_queue.Write(buffer_t(buf, buf + len));
+			buffer_t chunk = state.recv_queue.AcquireBuffer();
+			chunk.assign(buf, buf + len);
+			state.recv_queue.Write(std::move(chunk));
 		} else {
 			return errno == EAGAIN || errno == EWOULDBLOCK;
 		}
@@ -262,7 +264,7 @@ bool protocol_zt::recv(endpoint &peer, buffer_t &data)
 			continue;
 		}
 		peer = p.first;
-		data = *packet;
+		data = std::move(*packet);
 		return true;
 	}
 	return false;
@@ -153,6 +153,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 	}
 	recv_buffer.resize(bytesRead);
 	recv_queue.Write(std::move(recv_buffer));
+	recv_buffer = recv_queue.AcquireBuffer();
 	recv_buffer.resize(frame_queue::max_frame_size);
 	while (true) {
 		tl::expected<bool, PacketError> ready = recv_queue.PacketReady();
@@ -164,7 +165,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 			break;
 		tl::expected<void, PacketError> result
 		    = recv_queue.ReadPacket()
-		          .and_then([this](buffer_t &&pktData) { return pktfty->make_packet(pktData); })
+		          .and_then([this](buffer_t &&pktData) { return pktfty->make_packet(std::move(pktData)); })
 		          .and_then([this](std::unique_ptr<packet> &&pkt) { return RecvLocal(*pkt); });
 		if (!result.has_value()) {
 			RaiseIoHandlerError(result.error());
@@ -192,7 +193,7 @@ tl::expected<void, PacketError> tcp_client::send(packet &pkt)
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
+	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(std::move(*frame));
 	asio::mutable_buffer buf = asio::buffer(*framePtr);
 	asio::async_write(sock, buf, [this, frame = std::move(framePtr)](const asio::error_code &error, size_t bytesSent) {
 		HandleSend(error, bytesSent);
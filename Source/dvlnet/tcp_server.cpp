@@ -13,6 +13,18 @@
 
 namespace devilution::net {
 
+namespace {
+
+tl::expected<std::shared_ptr<const buffer_t>, PacketError> MakeSharedFrame(packet &pkt)
+{
+	return frame_queue::MakeFrame(pkt.Data())
+	    .transform([](buffer_t &&frame) {
+		    return std::make_shared<const buffer_t>(std::move(frame));
+	    });
+}
+
+} // namespace
+
 tcp_server::tcp_server(asio::io_context &ioc, const std::string &bindaddr,
     unsigned short port, packet_factory &pktfty)
     : ioc(ioc)
@@ -76,6 +88,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 	}
 	con->recv_buffer.resize(bytesRead);
 	con->recv_queue.Write(std::move(con->recv_buffer));
+	con->recv_buffer = con->recv_queue.AcquireBuffer();
 	con->recv_buffer.resize(frame_queue::max_frame_size);
 	while (true) {
 		tl::expected<bool, PacketError> ready = con->recv_queue.PacketReady();
@@ -92,7 +105,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 			DropConnection(con);
 			return;
 		}
-		tl::expected<std::unique_ptr<packet>, PacketError> pkt = pktfty.make_packet(*pktData);
+		tl::expected<std::unique_ptr<packet>, PacketError> pkt = pktfty.make_packet(std::move(*pktData));
 		if (!pkt.has_value()) {
 			Log("make_packet: {}", pkt.error().what());
 			DropConnection(con);
@@ -163,12 +176,16 @@ tl::expected<void, PacketError> tcp_server::HandleReceivePacket(packet &pkt)
 tl::expected<void, PacketError> tcp_server::SendPacket(packet &pkt)
 {
 	if (pkt.Destination() == PLR_BROADCAST) {
+		// Frame the packet once and share the frame between all recipients
+		tl::expected<std::shared_ptr<const buffer_t>, PacketError> frame = MakeSharedFrame(pkt);
+		if (!frame.has_value()) {
+			LogError("Failed to send packet {}: {}", static_cast<uint8_t>(pkt.Type()), frame.error().what());
+			return {};
+		}
 		for (size_t i = 0; i < Players.size(); ++i) {
 			if (i == pkt.Source() || !connections[i])
 				continue;
-			tl::expected<void, PacketError> result = StartSend(connections[i], pkt);
-			if (!result.has_value())
-				LogError("Failed to send packet {} to player {}: {}", static_cast<uint8_t>(pkt.Type()), i, result.error().what());
+			StartSend(connections[i], *frame);
 		}
 		return {};
 	}
@@ -181,16 +198,20 @@ tl::expected<void, PacketError> tcp_server::SendPacket(packet &pkt)
 
 tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, packet &pkt)
 {
-	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
+	tl::expected<std::shared_ptr<const buffer_t>, PacketError> frame = MakeSharedFrame(pkt);
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
-	asio::mutable_buffer buf = asio::buffer(*framePtr);
+	StartSend(con, std::move(*frame));
+	return {};
+}
+
+void tcp_server::StartSend(const scc &con, std::shared_ptr<const buffer_t> frame)
+{
+	asio::const_buffer buf = asio::buffer(*frame);
 	asio::async_write(con->socket, buf,
-	    [this, con, frame = std::move(framePtr)](const asio::error_code &ec, size_t bytesSent) {
+	    [this, con, frame = std::move(frame)](const asio::error_code &ec, size_t bytesSent) {
 		    HandleSend(con, ec, bytesSent);
 	    });
-	return {};
 }
 
 void tcp_server::HandleSend(const scc &con, const asio::error_code &ec,
@@ -137,16 +137,20 @@ void LoadEffectsData()
 	const std::string_view filename = "txtdata\\sound\\effects.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	sgSFX.clear();
-	sgSFX.reserve(dataFile.numRecords());
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		TSFX &item = sgSFX.emplace_back();
-		reader.advance(); // Skip the first column (effect ID).
-		reader.readEnumList("flags", item.bFlags, ParseSfxFlag);
-		reader.readString("path", item.pszName);
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		sgSFX.clear();
+		sgSFX.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			TSFX &item = sgSFX.emplace_back();
+			reader.advance(); // Skip the first column (effect ID).
+			reader.readEnumList("flags", item.bFlags, ParseSfxFlag);
+			reader.readString("path", item.pszName);
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 	sgSFX.shrink_to_fit();
 	// We're not actually parsing the IDs yet, thus this sanity check here.
 	assert(static_cast<size_t>(SfxID::LAST) + 1 == sgSFX.size());
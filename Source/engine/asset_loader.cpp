@@ -0,0 +1,392 @@
+#include "engine/asset_loader.hpp"
+
+#ifndef UNPACKED_MPQS
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "appfat.h"
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+#include "mpq/mpq_common.hpp"
+#include "mpq/mpq_reader.hpp"
+#include "mpq/mpq_sdl_rwops.hpp"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+#endif
+
+namespace devilution {
+
+#ifdef UNPACKED_MPQS
+// The files are read straight from the file system, so there's nothing to gain from reading them ahead.
+void PrefetchAsset(std::string_view /*path*/, AssetLoadPriority /*priority*/)
+{
+}
+
+void StopAssetLoader()
+{
+}
+#else
+namespace {
+
+/** @brief Prefetch requests are ignored while more than this is waiting to be used, and the oldest data is dropped. */
+constexpr size_t MaxPrefetchedBytes = 32 * 1024 * 1024;
+
+enum class PrefetchState : uint8_t {
+	Queued,
+	Reading,
+	Ready,
+};
+
+struct PrefetchEntry {
+	MpqFileHash hash;
+	std::string path;
+	AssetLoadPriority priority;
+	PrefetchState state;
+	AssetData data;
+};
+
+SdlMutex LoaderMutex;
+SDL_cond *WorkAvailable;
+SDL_cond *ReadFinished;
+SDL_Thread *LoaderThread;
+/** @brief Lets OpenPrefetchedAsset skip locking the mutex when nothing was ever prefetched. */
+std::atomic<bool> LoaderRunning;
+bool StopRequested;
+
+/** @brief Every prefetched file, in the order they were requested. Guarded by LoaderMutex. */
+std::vector<std::unique_ptr<PrefetchEntry>> Entries;
+/** @brief Size of the Ready entries. Guarded by LoaderMutex. */
+size_t PrefetchedBytes;
+
+PrefetchEntry *FindEntry(const MpqFileHash &hash)
+{
+	for (const std::unique_ptr<PrefetchEntry> &entry : Entries) {
+		if (entry->hash == hash)
+			return entry.get();
+	}
+	return nullptr;
+}
+
+void EraseEntry(const PrefetchEntry *entry)
+{
+	for (auto it = Entries.begin(); it != Entries.end(); ++it) {
+		if (it->get() == entry) {
+			Entries.erase(it);
+			return;
+		}
+	}
+}
+
+PrefetchEntry *NextQueuedEntry()
+{
+	PrefetchEntry *next = nullptr;
+	for (const std::unique_ptr<PrefetchEntry> &entry : Entries) {
+		if (entry->state != PrefetchState::Queued)
+			continue;
+		if (next == nullptr || entry->priority < next->priority)
+			next = entry.get();
+		if (next->priority == AssetLoadPriority::Urgent)
+			break;
+	}
+	return next;
+}
+
+void DropOldestReadyEntries()
+{
+	for (auto it = Entries.begin(); it != Entries.end() && PrefetchedBytes > MaxPrefetchedBytes;) {
+		if ((*it)->state != PrefetchState::Ready) {
+			++it;
+			continue;
+		}
+		PrefetchedBytes -= (*it)->data.size;
+		it = Entries.erase(it);
+	}
+}
+
+/**
+ * @brief Archives cloned for the loader thread, so it doesn't share the file positions of the main thread.
+ *
+ * Keyed by the archive id rather than its address, since a reloaded archive (e.g. after a language change) can end up
+ * at the same address.
+ */
+struct ClonedArchive {
+	uint32_t archiveId;
+	MpqArchive clone;
+};
+
+MpqArchive *GetClonedArchive(std::vector<ClonedArchive> &clones, MpqArchive &original)
+{
+	for (ClonedArchive &cloned : clones) {
+		if (cloned.archiveId == original.id())
+			return &cloned.clone;
+	}
+	int32_t error = 0;
+	std::optional<MpqArchive> clone = original.Clone(error);
+	if (!clone) {
+		LogError("Failed to clone archive for the asset loader: {}", MpqArchive::ErrorMessage(error));
+		return nullptr;
+	}
+	return &clones.emplace_back(ClonedArchive { original.id(), std::move(*clone) }).clone;
+}
+
+std::optional<AssetData> ReadAsset(std::string_view path, std::vector<ClonedArchive> &clones)
+{
+	// Files outside of the archives are opened directly by OpenAsset.
+	AssetRef ref = FindAsset(path);
+	if (ref.archive == nullptr)
+		return std::nullopt;
+	MpqArchive *archive = GetClonedArchive(clones, *ref.archive);
+	if (archive == nullptr)
+		return std::nullopt;
+
+	int32_t error = 0;
+	const size_t size = archive->GetUnpackedFileSize(ref.fileNumber, error);
+	if (error != 0)
+		return std::nullopt;
+	AssetHandle handle { SDL_RWops_FromMpqFile(*archive, ref.fileNumber, ref.filename, /*threadsafe=*/false) };
+	if (!handle.ok())
+		return std::nullopt;
+	AssetData result { std::unique_ptr<char[]> { new char[size] }, size };
+	if (size > 0 && !handle.read(result.data.get(), size))
+		return std::nullopt;
+	return result;
+}
+
+int SDLCALL LoaderMain(void * /*data*/)
+{
+	std::vector<ClonedArchive> clones;
+	LoaderMutex.lock();
+	while (true) {
+		PrefetchEntry *entry = nullptr;
+		while (!StopRequested && (entry = NextQueuedEntry()) == nullptr)
+			SDL_CondWait(WorkAvailable, LoaderMutex.get());
+		if (StopRequested)
+			break;
+		entry->state = PrefetchState::Reading;
+		LoaderMutex.unlock();
+
+		const uint32_t start = SDL_GetTicks();
+		std::optional<AssetData> data = ReadAsset(entry->path, clones);
+		LogVerbose("Prefetched {} in {}ms", entry->path, SDL_GetTicks() - start);
+
+		LoaderMutex.lock();
+		if (data) {
+			entry->data = std::move(*data);
+			entry->state = PrefetchState::Ready;
+			PrefetchedBytes += entry->data.size;
+			DropOldestReadyEntries();
+		} else {
+			// Dropped so that OpenAsset reads it directly and a later request can try again.
+			EraseEntry(entry);
+		}
+		SDL_CondBroadcast(ReadFinished);
+	}
+	LoaderMutex.unlock();
+	return 0;
+}
+
+/** @brief Must be called with LoaderMutex locked. */
+void StartLoaderThread()
+{
+	if (LoaderThread != nullptr)
+		return;
+	WorkAvailable = SDL_CreateCond();
+	ReadFinished = SDL_CreateCond();
+	if (WorkAvailable == nullptr || ReadFinished == nullptr)
+		ErrSdl();
+	StopRequested = false;
+#ifdef USE_SDL1
+	LoaderThread = SDL_CreateThread(LoaderMain, nullptr);
+#else
+	LoaderThread = SDL_CreateThread(LoaderMain, "asset loader", nullptr);
+#endif
+	if (LoaderThread == nullptr)
+		ErrSdl();
+	LoaderRunning = true;
+}
+
+struct MemoryRwopsData {
+	AssetData asset;
+	size_t position;
+};
+
+MemoryRwopsData *GetData(struct SDL_RWops *context)
+{
+	return reinterpret_cast<MemoryRwopsData *>(context->hidden.unknown.data1);
+}
+
+#ifndef USE_SDL1
+using OffsetType = Sint64;
+using SizeType = size_t;
+#else
+using OffsetType = int;
+using SizeType = int;
+#endif
+
+extern "C" {
+
+#ifndef USE_SDL1
+static Sint64 MemoryRwSize(struct SDL_RWops *context)
+{
+	return static_cast<Sint64>(GetData(context)->asset.size);
+}
+#endif
+
+static OffsetType MemoryRwSeek(struct SDL_RWops *context, OffsetType offset, int whence)
+{
+	MemoryRwopsData &data = *GetData(context);
+	OffsetType newPosition;
+	switch (whence) {
+	case RW_SEEK_SET:
+		newPosition = offset;
+		break;
+	case RW_SEEK_CUR:
+		newPosition = static_cast<OffsetType>(data.position + offset);
+		break;
+	case RW_SEEK_END:
+		newPosition = static_cast<OffsetType>(data.asset.size + offset);
+		break;
+	default:
+		return -1;
+	}
+	if (newPosition < 0 || newPosition > static_cast<OffsetType>(data.asset.size)) {
+		SDL_SetError("MemoryRwSeek out of bounds (%d of %u)", static_cast<int>(newPosition), static_cast<unsigned>(data.asset.size));
+		return -1;
+	}
+	data.position = static_cast<size_t>(newPosition);
+	return newPosition;
+}
+
+static SizeType MemoryRwRead(struct SDL_RWops *context, void *ptr, SizeType size, SizeType maxnum)
+{
+	MemoryRwopsData &data = *GetData(context);
+	if (size == 0)
+		return 0;
+	const size_t available = (data.asset.size - data.position) / size;
+	const size_t count = std::min(static_cast<size_t>(maxnum), available);
+	std::memcpy(ptr, data.asset.data.get() + data.position, count * size);
+	data.position += count * size;
+	return static_cast<SizeType>(count);
+}
+
+static int MemoryRwClose(struct SDL_RWops *context)
+{
+	delete GetData(context);
+	delete context;
+	return 0;
+}
+
+} // extern "C"
+
+SDL_RWops *CreateMemoryRwops(AssetData &&asset)
+{
+	auto result = std::make_unique<SDL_RWops>();
+	std::memset(result.get(), 0, sizeof(*result));
+#ifndef USE_SDL1
+	result->size = &MemoryRwSize;
+	result->type = SDL_RWOPS_UNKNOWN;
+#else
+	result->type = 0;
+#endif
+	result->seek = &MemoryRwSeek;
+	result->read = &MemoryRwRead;
+	result->write = nullptr;
+	result->close = &MemoryRwClose;
+	result->hidden.unknown.data1 = new MemoryRwopsData { std::move(asset), 0 };
+	return result.release();
+}
+
+} // namespace
+
+void PrefetchAsset(std::string_view path, AssetLoadPriority priority)
+{
+	if (HeadlessMode)
+		return;
+
+	const MpqFileHash hash = CalculateMpqFileHash(path);
+	const std::lock_guard<SdlMutex> lock(LoaderMutex);
+	if (PrefetchEntry *entry = FindEntry(hash); entry != nullptr) {
+		if (priority < entry->priority)
+			entry->priority = priority;
+		return;
+	}
+	if (priority == AssetLoadPriority::Prefetch && PrefetchedBytes >= MaxPrefetchedBytes)
+		return;
+
+	StartLoaderThread();
+	Entries.emplace_back(new PrefetchEntry { hash, std::string(path), priority, PrefetchState::Queued, {} });
+	SDL_CondSignal(WorkAvailable);
+}
+
+SDL_RWops *OpenPrefetchedAsset(std::string_view filename)
+{
+	if (!LoaderRunning)
+		return nullptr;
+
+	const MpqFileHash hash = CalculateMpqFileHash(filename);
+	const std::lock_guard<SdlMutex> lock(LoaderMutex);
+	PrefetchEntry *entry = FindEntry(hash);
+	while (entry != nullptr && entry->state == PrefetchState::Reading) {
+		SDL_CondWait(ReadFinished, LoaderMutex.get());
+		entry = FindEntry(hash);
+	}
+	if (entry == nullptr)
+		return nullptr;
+
+	if (entry->state == PrefetchState::Queued) {
+		EraseEntry(entry);
+		return nullptr;
+	}
+	PrefetchedBytes -= entry->data.size;
+	SDL_RWops *result = CreateMemoryRwops(std::move(entry->data));
+	EraseEntry(entry);
+	return result;
+}
+
+void WaitForQueuedAssets()
+{
+	const std::lock_guard<SdlMutex> lock(LoaderMutex);
+	while (true) {
+		bool pending = false;
+		for (const std::unique_ptr<PrefetchEntry> &entry : Entries) {
+			if (entry->state != PrefetchState::Ready) {
+				pending = true;
+				break;
+			}
+		}
+		if (!pending)
+			return;
+		SDL_CondWait(ReadFinished, LoaderMutex.get());
+	}
+}
+
+void StopAssetLoader()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(LoaderMutex);
+		if (LoaderThread == nullptr)
+			return;
+		StopRequested = true;
+		SDL_CondSignal(WorkAvailable);
+	}
+	SDL_WaitThread(LoaderThread, nullptr);
+
+	const std::lock_guard<SdlMutex> lock(LoaderMutex);
+	LoaderRunning = false;
+	LoaderThread = nullptr;
+	Entries.clear();
+	PrefetchedBytes = 0;
+	SDL_DestroyCond(ReadFinished);
+	SDL_DestroyCond(WorkAvailable);
+	ReadFinished = nullptr;
+	WorkAvailable = nullptr;
+}
+#endif
+
+} // namespace devilution
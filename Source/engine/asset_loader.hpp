@@ -0,0 +1,60 @@
+/**
+ * @file asset_loader.hpp
+ *
+ * Reads assets ahead of time on a background thread.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <SDL.h>
+
+#ifdef USE_SDL1
+#include "utils/sdl2_to_1_2_backports.h"
+#endif
+
+namespace devilution {
+
+enum class AssetLoadPriority : uint8_t {
+	/** @brief Needed by the level that is being loaded right now. */
+	Urgent,
+	/** @brief Might be needed soon, e.g. by the level behind nearby stairs. */
+	Prefetch,
+};
+
+/**
+ * @brief Queues an asset to be read on the asset loader thread, so that a later OpenAsset gets it from memory.
+ *
+ * Urgent assets are read before any Prefetch ones. Prefetch requests are ignored while a lot of prefetched data
+ * is waiting to be used. Only files from MPQ archives are read ahead, does nothing in headless mode.
+ */
+void PrefetchAsset(std::string_view path, AssetLoadPriority priority = AssetLoadPriority::Prefetch);
+
+#ifndef UNPACKED_MPQS
+/**
+ * @brief Hands over the prefetched contents of an MPQ file.
+ *
+ * Waits if the file is being read right now. A file that is still queued is dropped from the queue instead,
+ * since reading it directly is faster than waiting for the other files ahead of it.
+ *
+ * @return An SDL_RWops over the file contents, or nullptr if it has not been prefetched.
+ */
+SDL_RWops *OpenPrefetchedAsset(std::string_view filename);
+
+/**
+ * @brief Waits until every queued file has been read (or failed to).
+ *
+ * Lets the tests tell apart a prefetched file from one that is still queued.
+ */
+void WaitForQueuedAssets();
+#endif
+
+/**
+ * @brief Stops the asset loader thread and drops all prefetched data.
+ *
+ * Must be called before the archives are closed.
+ */
+void StopAssetLoader();
+
+} // namespace devilution
@@ -0,0 +1,86 @@
+#include "engine/asset_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#if !defined(DISABLE_MEMORY_MAPPED_ASSETS) && defined(_WIN32) && !defined(NXDK) && !defined(__UWP__)
+#define DEVILUTIONX_MAP_FILES_WIN32
+// Suppress definitions of `min` and `max` macros by <windows.h>:
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "utils/file_util.h"
+#elif !defined(DISABLE_MEMORY_MAPPED_ASSETS) && (defined(__unix__) || defined(__APPLE__))
+#define DEVILUTIONX_MAP_FILES_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace devilution {
+
+#if defined(DEVILUTIONX_MAP_FILES_POSIX)
+AssetView MapFileRegion(const char *path, size_t offset, size_t size)
+{
+	if (size == 0)
+		return {};
+	const int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return {};
+
+	// The mapping offset must be a multiple of the page size.
+	const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const size_t mapOffset = offset - (offset % pageSize);
+	const size_t mapSize = size + (offset - mapOffset);
+	void *mapped = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(mapOffset));
+	close(fd);
+	if (mapped == MAP_FAILED)
+		return {};
+
+	std::shared_ptr<void> owner { mapped, [mapSize](void *ptr) { munmap(ptr, mapSize); } };
+	return AssetView { std::move(owner), static_cast<const std::byte *>(mapped) + (offset - mapOffset), size, /*mapped=*/true };
+}
+#elif defined(DEVILUTIONX_MAP_FILES_WIN32)
+AssetView MapFileRegion(const char *path, size_t offset, size_t size)
+{
+	if (size == 0)
+		return {};
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+	const std::unique_ptr<wchar_t[]> pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr)
+		return {};
+	HANDLE file = ::CreateFileW(pathUtf16.get(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return {};
+	HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	::CloseHandle(file);
+	if (mapping == nullptr)
+		return {};
+
+	// The view offset must be a multiple of the allocation granularity.
+	SYSTEM_INFO systemInfo;
+	::GetSystemInfo(&systemInfo);
+	const uint64_t mapOffset = offset - (offset % systemInfo.dwAllocationGranularity);
+	const size_t mapSize = size + static_cast<size_t>(offset - mapOffset);
+	void *mapped = ::MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(mapOffset >> 32), static_cast<DWORD>(mapOffset & 0xFFFFFFFF), mapSize);
+	::CloseHandle(mapping);
+	if (mapped == nullptr)
+		return {};
+
+	std::shared_ptr<void> owner { mapped, [](void *ptr) { ::UnmapViewOfFile(ptr); } };
+	return AssetView { std::move(owner), static_cast<const std::byte *>(mapped) + (offset - mapOffset), size, /*mapped=*/true };
+}
+#else
+AssetView MapFileRegion(const char * /*path*/, size_t /*offset*/, size_t /*size*/)
+{
+	return {};
+}
+#endif
+
+} // namespace devilution
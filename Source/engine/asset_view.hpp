@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace devilution {
+
+/**
+ * @brief The contents of an asset, valid for as long as any copy of the view exists.
+ *
+ * The bytes either belong to a buffer the asset was read into or, where supported, to a memory mapping of the file
+ * that the OS pages in on first access.
+ */
+class AssetView {
+public:
+	AssetView() = default;
+
+	AssetView(std::shared_ptr<const void> owner, const std::byte *data, size_t size, bool mapped)
+	    : owner_(std::move(owner))
+	    , data_(data)
+	    , size_(size)
+	    , mapped_(mapped)
+	{
+	}
+
+	[[nodiscard]] const std::byte *data() const { return data_; }
+	[[nodiscard]] size_t size() const { return size_; }
+	[[nodiscard]] bool empty() const { return size_ == 0; }
+
+	/** @brief Whether the data is mapped from the file rather than copied into memory. */
+	[[nodiscard]] bool mapped() const { return mapped_; }
+
+	/** @brief Keeps the data alive, can be shared with objects that point into it. */
+	[[nodiscard]] const std::shared_ptr<const void> &owner() const { return owner_; }
+
+	[[nodiscard]] std::span<const std::byte> span() const { return { data_, size_ }; }
+
+	explicit operator std::string_view() const
+	{
+		return { reinterpret_cast<const char *>(data_), size_ };
+	}
+
+private:
+	std::shared_ptr<const void> owner_;
+	const std::byte *data_ = nullptr;
+	size_t size_ = 0;
+	bool mapped_ = false;
+};
+
+/**
+ * @brief Maps a region of a file as a private copy-on-write view.
+ *
+ * @return An empty view if the file cannot be mapped or mapping is not supported on this platform,
+ * in which case the caller should read the data instead.
+ */
+AssetView MapFileRegion(const char *path, size_t offset, size_t size);
+
+/**
+ * @brief Deleter for a buffer that is either an owned array or points into an AssetView.
+ *
+ * Implicitly constructible from `std::default_delete`, so a `std::unique_ptr<uint8_t[]>` converts to an `AssetBuffer`.
+ */
+class AssetBufferDeleter {
+public:
+	AssetBufferDeleter() = default;
+
+	AssetBufferDeleter(std::default_delete<uint8_t[]> /*unused*/) // NOLINT(google-explicit-constructor)
+	{
+	}
+
+	explicit AssetBufferDeleter(std::shared_ptr<const void> owner)
+	    : owner_(std::move(owner))
+	{
+	}
+
+	void operator()(uint8_t *data)
+	{
+		if (owner_ == nullptr)
+			delete[] data;
+		else
+			owner_ = nullptr;
+	}
+
+private:
+	std::shared_ptr<const void> owner_;
+};
+
+using AssetBuffer = std::unique_ptr<uint8_t[], AssetBufferDeleter>;
+
+/**
+ * @brief Makes a buffer that points into the view and keeps it alive.
+ *
+ * Mapped views are private copy-on-write mappings, so the buffer may be modified in place
+ * (e.g. by ClxApplyTrans) without affecting the file or other views of it.
+ */
+inline AssetBuffer ToAssetBuffer(const AssetView &view)
+{
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+	return AssetBuffer { const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(view.data())), AssetBufferDeleter { view.owner() } };
+}
+
+} // namespace devilution
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string_view>
 
 #include "appfat.h"
+#include "engine/asset_loader.hpp"
 #include "game_mode.hpp"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
@@ -45,6 +47,13 @@ std::optional<MpqArchive> font_mpq;
 
 namespace {
 
+/**
+ * @brief Smaller assets are read rather than mapped.
+ *
+ * A mapping takes up at least a page and a few system calls, which costs more than copying a small file.
+ */
+constexpr size_t MinMappedAssetSize = 16 * 1024;
+
 #ifdef UNPACKED_MPQS
 char *FindUnpackedMpqFile(char *relativePath)
 {
@@ -196,8 +205,11 @@ AssetHandle OpenAsset(AssetRef &&ref, bool threadsafe)
 #if UNPACKED_MPQS
 	return AssetHandle { OpenFile(ref.path, "rb") };
 #else
-	if (ref.archive != nullptr)
+	if (ref.archive != nullptr) {
+		if (SDL_RWops *prefetched = OpenPrefetchedAsset(ref.filename); prefetched != nullptr)
+			return AssetHandle { prefetched };
 		return AssetHandle { SDL_RWops_FromMpqFile(*ref.archive, ref.fileNumber, ref.filename, threadsafe) };
+	}
 	if (ref.directHandle != nullptr) {
 		// Transfer handle ownership:
 		SDL_RWops *handle = ref.directHandle;
@@ -259,6 +271,52 @@ tl::expected<AssetData, std::string> LoadAsset(std::string_view path)
 	return AssetData { std::move(data), size };
 }
 
+tl::expected<AssetView, std::string> LoadAssetView(std::string_view path)
+{
+	AssetRef ref = FindAsset(path);
+	if (!ref.ok()) {
+		return tl::make_unexpected(StrCat("Asset not found: ", path));
+	}
+
+	const size_t size = ref.size();
+	AssetHandle handle;
+#ifdef UNPACKED_MPQS
+	if (size >= MinMappedAssetSize) {
+		AssetView view = MapFileRegion(ref.path, 0, size);
+		if (!view.empty())
+			return view;
+	}
+	handle = OpenAsset(std::move(ref));
+#else
+	if (ref.archive != nullptr) {
+		// Data that the loader thread has already read is used as is.
+		if (SDL_RWops *prefetched = OpenPrefetchedAsset(ref.filename); prefetched != nullptr) {
+			handle = AssetHandle { prefetched };
+		} else {
+			size_t offset;
+			size_t storedSize;
+			if (size >= MinMappedAssetSize && ref.archive->GetUnencodedFileRegion(ref.fileNumber, offset, storedSize)) {
+				AssetView view = MapFileRegion(ref.archive->path().c_str(), offset, storedSize);
+				if (!view.empty())
+					return view;
+			}
+		}
+	}
+	if (!handle.ok())
+		handle = OpenAsset(std::move(ref));
+#endif
+	if (!handle.ok()) {
+		return tl::make_unexpected(StrCat("Failed to open asset: ", path, "\n", handle.error()));
+	}
+
+	std::shared_ptr<std::byte[]> data { new std::byte[size] };
+	if (size > 0 && !handle.read(data.get(), size)) {
+		return tl::make_unexpected(StrCat("Read failed: ", path, "\n", handle.error()));
+	}
+	const std::byte *bytes = data.get();
+	return AssetView { std::move(data), bytes, size, /*mapped=*/false };
+}
+
 std::string FailedToOpenFileErrorMessage(std::string_view path, std::string_view error)
 {
 	return fmt::format(fmt::runtime(_("Failed to open file:\n{:s}\n\n{:s}\n\nThe MPQ file(s) might be damaged. Please check the file integrity.")), path, error);
@@ -379,6 +437,8 @@ void LoadCoreArchives()
 
 void LoadLanguageArchive()
 {
+	// Prefetched files may come from the old language archive.
+	StopAssetLoader();
 #ifdef UNPACKED_MPQS
 	lang_data_path = std::nullopt;
 #else
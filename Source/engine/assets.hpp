@@ -13,6 +13,7 @@
 #include <fmt/format.h>
 
 #include "appfat.h"
+#include "engine/asset_view.hpp"
 #include "game_mode.hpp"
 #include "headless_mode.hpp"
 #include "utils/file_util.h"
@@ -277,6 +278,14 @@ struct AssetData {
 
 tl::expected<AssetData, std::string> LoadAsset(std::string_view path);
 
+/**
+ * @brief Loads an asset without copying it where possible.
+ *
+ * Unpacked files and MPQ files that are stored without compression or encryption are memory-mapped,
+ * everything else is read into memory.
+ */
+tl::expected<AssetView, std::string> LoadAssetView(std::string_view path);
+
 #ifdef UNPACKED_MPQS
 extern DVL_API_FOR_TEST std::optional<std::string> spawn_data_path;
 extern DVL_API_FOR_TEST std::optional<std::string> diabdat_data_path;
@@ -30,6 +30,7 @@
 #include <memory>
 
 #include "appfat.h"
+#include "engine/asset_view.hpp"
 #include "utils/endian_read.hpp"
 #include "utils/intrusive_optional.hpp"
 
@@ -334,7 +335,7 @@ class OwnedClxSpriteListOrSheet;
  */
 class OwnedClxSpriteList {
 public:
-	explicit OwnedClxSpriteList(std::unique_ptr<uint8_t[]> &&data)
+	explicit OwnedClxSpriteList(AssetBuffer &&data)
 	    : data_(std::move(data))
 	{
 		assert(data_ != nullptr);
@@ -367,7 +368,7 @@ private:
 	// For OptionalOwnedClxSpriteList.
 	OwnedClxSpriteList() = default;
 
-	std::unique_ptr<uint8_t[]> data_;
+	AssetBuffer data_;
 
 	friend class ClxSpriteList; // for implicit conversion
 	friend class OptionalOwnedClxSpriteList;
@@ -392,7 +393,7 @@ inline OwnedClxSpriteList ClxSpriteList::clone() const
  */
 class OwnedClxSpriteSheet {
 public:
-	OwnedClxSpriteSheet(std::unique_ptr<uint8_t[]> &&data, uint16_t numLists)
+	OwnedClxSpriteSheet(AssetBuffer &&data, uint16_t numLists)
 	    : data_(std::move(data))
 	    , num_lists_(numLists)
 	{
@@ -427,7 +428,7 @@ private:
 	// For OptionalOwnedClxSpriteList.
 	OwnedClxSpriteSheet() = default;
 
-	std::unique_ptr<uint8_t[]> data_;
+	AssetBuffer data_;
 	uint16_t num_lists_ = 0;
 
 	friend class ClxSpriteSheet; // for implicit conversion.
@@ -508,13 +509,13 @@ class OptionalOwnedClxSpriteListOrSheet;
  */
 class OwnedClxSpriteListOrSheet {
 public:
-	static OwnedClxSpriteListOrSheet FromBuffer(std::unique_ptr<uint8_t[]> &&data, size_t size)
+	static OwnedClxSpriteListOrSheet FromBuffer(AssetBuffer &&data, size_t size)
 	{
 		const uint16_t numLists = GetNumListsFromClxListOrSheetBuffer(data.get(), size);
 		return OwnedClxSpriteListOrSheet { std::move(data), numLists };
 	}
 
-	explicit OwnedClxSpriteListOrSheet(std::unique_ptr<uint8_t[]> &&data, uint16_t numLists)
+	explicit OwnedClxSpriteListOrSheet(AssetBuffer &&data, uint16_t numLists)
 	    : data_(std::move(data))
 	    , num_lists_(numLists)
 	{
@@ -572,7 +573,7 @@ private:
 	// For OptionalOwnedClxSpriteListOrSheet.
 	OwnedClxSpriteListOrSheet() = default;
 
-	std::unique_ptr<uint8_t[]> data_;
+	AssetBuffer data_;
 	uint16_t num_lists_ = 0;
 
 	friend class ClxSpriteListOrSheet;
@@ -143,6 +143,7 @@ uint32_t DemoModeLastTick = 0;
 
 int LogicTick = 0;
 uint32_t StartTime = 0;
+demo::PlaybackStats LastPlaybackStats {};
 
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
@@ -688,8 +689,9 @@ bool FetchMessage(SDL_Event *event, uint16_t *modState)
 	if (CurrentEventHandler == DisableInputEventHandler)
 		return false;
 
+	// In headless mode there is no window to pump events from, all input comes from the demo file.
 	SDL_Event e;
-	if (SDL_PollEvent(&e) != 0) {
+	if (!HeadlessMode && SDL_PollEvent(&e) != 0) {
 		if (e.type == SDL_QUIT) {
 			*event = e;
 			return true;
@@ -842,8 +844,11 @@ void NotifyGameLoopEnd()
 		CreateDemoReference = false;
 	}
 
+	if (IsRunning())
+		LastPlaybackStats = { LogicTick, SDL_GetTicks() - StartTime };
+
 	if (IsRunning() && !HeadlessMode) {
-		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
+		const float seconds = LastPlaybackStats.milliseconds / 1000.0F;
 		SDL_Log("%d frames, %.2f seconds: %.1f fps", LogicTick, seconds, LogicTick / seconds);
 		gbRunGameResult = false;
 		gbRunGame = false;
@@ -863,6 +868,11 @@ void NotifyGameLoopEnd()
 	}
 }
 
+PlaybackStats GetLastPlaybackStats()
+{
+	return LastPlaybackStats;
+}
+
 uint32_t SimulateMillisecondsSinceStartup()
 {
 	return LogicTick * 50;
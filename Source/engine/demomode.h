@@ -14,6 +14,21 @@ namespace devilution {
 namespace demo {
 
 #ifndef DISABLE_DEMOMODE
+/**
+ * @brief Throughput of the last finished demo playback.
+ */
+struct PlaybackStats {
+	/** Number of game logic ticks that were replayed */
+	int logicTicks;
+	/** Wall-clock duration of the playback in milliseconds */
+	uint32_t milliseconds;
+
+	[[nodiscard]] float ticksPerSecond() const
+	{
+		return milliseconds == 0 ? 0.0F : logicTicks * 1000.0F / milliseconds;
+	}
+};
+
 void InitPlayBack(int demoNumber, bool timedemo);
 void InitRecording(int recordNumber, bool createDemoReference);
 void OverrideOptions();
@@ -29,6 +44,11 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
 
+/**
+ * @brief Statistics of the last demo playback, valid after NotifyGameLoopEnd.
+ */
+PlaybackStats GetLastPlaybackStats();
+
 uint32_t SimulateMillisecondsSinceStartup();
 #else
 inline void OverrideOptions()
@@ -7,9 +7,11 @@
 
 #include <SDL.h>
 #include <cstdint>
+#include <vector>
 
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
+#include "engine/render/palette_blit.hpp"
 #include "engine/render/primitive_render.hpp"
 #include "headless_mode.hpp"
 #include "init.h"
@@ -85,6 +87,47 @@ void LimitFrameRate()
 	frameDeadline = tc + v + refreshDelay;
 }
 
+#ifndef USE_SDL1
+/** More changed areas than this are uploaded as a whole. */
+constexpr size_t MaxOutputDirtyRects = 16;
+
+/** Areas of the output surface written by Blit since the last texture upload. */
+std::vector<SDL_Rect> OutputDirtyRects;
+
+/** Whether the whole output surface has to be uploaded, e.g. because it was written to without going through Blit. */
+bool OutputFullyDirty = true;
+
+void MarkOutputDirty(const SDL_Rect &rect)
+{
+	if (OutputFullyDirty || rect.w <= 0 || rect.h <= 0)
+		return;
+	if (OutputDirtyRects.size() == MaxOutputDirtyRects) {
+		InvalidateOutputSurface();
+		return;
+	}
+	OutputDirtyRects.push_back(rect);
+}
+
+/** @brief Copies the changed parts of the output surface to the streaming texture. */
+void UploadOutputSurface(const SDL_Surface &surface)
+{
+	if (OutputFullyDirty) {
+		if (SDL_UpdateTexture(texture.get(), nullptr, surface.pixels, surface.pitch) <= -1) { // pitch is 2560
+			ErrSdl();
+		}
+	} else {
+		for (const SDL_Rect &rect : OutputDirtyRects) {
+			const auto *pixels = static_cast<const uint8_t *>(surface.pixels) + static_cast<ptrdiff_t>(rect.y) * surface.pitch + rect.x * surface.format->BytesPerPixel;
+			if (SDL_UpdateTexture(texture.get(), &rect, pixels, surface.pitch) <= -1) {
+				ErrSdl();
+			}
+		}
+	}
+	OutputDirtyRects.clear();
+	OutputFullyDirty = false;
+}
+#endif
+
 } // namespace
 
 void dx_init()
@@ -170,8 +213,12 @@ void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect)
 
 	SDL_Surface *dst = GetOutputSurface();
 #ifndef USE_SDL1
-	if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
+	SDL_Rect written = dstRect != nullptr ? *dstRect : SDL_Rect { 0, 0, 0, 0 };
+	if (!BlitPalettedSurface(src, srcRect, dst, &written) && SDL_BlitSurface(src, srcRect, dst, &written) < 0)
 		ErrSdl();
+	if (dstRect != nullptr)
+		*dstRect = written;
+	MarkOutputDirty(written);
 #else
 	if (!OutputRequiresScaling()) {
 		if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
@@ -230,9 +277,7 @@ void RenderPresent()
 
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
-		if (SDL_UpdateTexture(texture.get(), nullptr, surface->pixels, surface->pitch) <= -1) { // pitch is 2560
-			ErrSdl();
-		}
+		UploadOutputSurface(*surface);
 
 		// Clear buffer to avoid artifacts in case the window was resized
 		if (SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255) <= -1) { // TODO only do this if window was resized
@@ -272,6 +317,14 @@ void RenderPresent()
 #endif
 }
 
+void InvalidateOutputSurface()
+{
+#ifndef USE_SDL1
+	OutputDirtyRects.clear();
+	OutputFullyDirty = true;
+#endif
+}
+
 void PaletteGetEntries(int dwNumEntries, SDL_Color *lpEntries)
 {
 	for (int i = 0; i < dwNumEntries; i++) {
@@ -25,6 +25,14 @@ void InitPalette();
 void BltFast(SDL_Rect *srcRect, SDL_Rect *dstRect);
 void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect);
 void RenderPresent();
+
+/**
+ * @brief Makes the next RenderPresent upload the whole output surface.
+ *
+ * Only the areas written by Blit are uploaded otherwise, so this has to be called after writing to the
+ * output surface directly or after the texture has been recreated.
+ */
+void InvalidateOutputSurface();
 void PaletteGetEntries(int dwNumEntries, SDL_Color *lpEntries);
 
 } // namespace devilution
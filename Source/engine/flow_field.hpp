@@ -0,0 +1,180 @@
+/**
+ * @file flow_field.hpp
+ *
+ * Distance maps towards a single target, shared by everything that is walking towards it.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "engine/displacement.hpp"
+#include "engine/path.h"
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/**
+ * @brief The cost of walking to a target from each tile around it, up to MaxPathLengthMonsters steps away.
+ *
+ * The field is built once with Dijkstra's algorithm going outwards from the target. After that, any number
+ * of searchers heading for the same target can look up their next step in constant time instead of each
+ * running their own search.
+ */
+class FlowField {
+public:
+	/** @brief How far the field reaches from the target, in steps. */
+	static constexpr int Radius = static_cast<int>(MaxPathLengthMonsters);
+
+	static constexpr uint16_t Unreachable = std::numeric_limits<uint16_t>::max();
+
+	/**
+	 * @brief Computes the cost of walking to `target` for every tile within Radius steps of it.
+	 *
+	 * @param canStep `bool(Point, Point)`, whether a step between two adjacent points is allowed.
+	 * @param posOk `bool(Point)`, whether a position can be walked through.
+	 * Tiles that fail this check still get a cost, since searchers may be standing on them, but no path leads through them.
+	 * The target itself is never checked.
+	 */
+	template <typename CanStep, typename PosOk>
+	void build(CanStep &&canStep, PosOk &&posOk, Point target);
+
+	[[nodiscard]] Point target() const
+	{
+		return target_;
+	}
+
+	/** @brief Cost of walking from `position` to the target, Unreachable if it is out of range or walled off. */
+	[[nodiscard]] uint16_t distance(Point position) const
+	{
+		if (!contains(position))
+			return Unreachable;
+		return distances_[index(position)];
+	}
+
+	/**
+	 * @brief Picks the step from `position` that leads to the target the fastest.
+	 *
+	 * Only steps onto tiles closer to the target are considered, so following the field never goes in circles.
+	 *
+	 * @param canStep `bool(Point, Point)`, whether a step between two adjacent points is allowed.
+	 * @param posOk `bool(Point)`, whether the searcher can step onto a position right now, e.g. because nobody is standing on it.
+	 * The target itself is never checked, like with FindPath.
+	 * @return The direction of the step, like the steps of FindPath, or 0 if no step gets closer to the target.
+	 */
+	template <typename CanStep, typename PosOk>
+	[[nodiscard]] int8_t nextStep(CanStep &&canStep, PosOk &&posOk, Point position) const;
+
+private:
+	static constexpr int Size = 2 * Radius + 1;
+
+	struct FrontierNode {
+		Point position;
+		uint16_t distance;
+	};
+
+	[[nodiscard]] static bool IsInGrid(Point position)
+	{
+		return position.x >= 0 && position.y >= 0 && position.x < PathSearchGridSize && position.y < PathSearchGridSize;
+	}
+
+	[[nodiscard]] static uint16_t StepCost(Point from, Point to)
+	{
+		return static_cast<uint16_t>(from.x != to.x && from.y != to.y ? PathDiagonalStepCost : PathAxisAlignedStepCost);
+	}
+
+	[[nodiscard]] bool contains(Point position) const
+	{
+		return std::abs(position.x - target_.x) <= Radius && std::abs(position.y - target_.y) <= Radius;
+	}
+
+	[[nodiscard]] size_t index(Point position) const
+	{
+		return static_cast<size_t>(position.x - target_.x + Radius) * Size + static_cast<size_t>(position.y - target_.y + Radius);
+	}
+
+	std::array<uint16_t, Size * Size> distances_;
+	/** @brief Binary min-heap of the tiles to expand, kept around so rebuilding does not allocate. */
+	std::vector<FrontierNode> frontier_;
+	Point target_;
+};
+
+template <typename CanStep, typename PosOk>
+void FlowField::build(CanStep &&canStep, PosOk &&posOk, Point target)
+{
+	target_ = target;
+	distances_.fill(Unreachable);
+	frontier_.clear();
+	if (!IsInGrid(target))
+		return;
+
+	const auto isFurther = [](const FrontierNode &a, const FrontierNode &b) { return a.distance > b.distance; };
+	// Same limit as FindPath, anything more expensive takes more than MaxPathLengthMonsters steps.
+	const int maxDistance = PathDiagonalStepCost * Radius;
+
+	distances_[index(target)] = 0;
+	frontier_.push_back(FrontierNode { target, 0 });
+	while (!frontier_.empty()) {
+		std::pop_heap(frontier_.begin(), frontier_.end(), isFurther);
+		const FrontierNode cur = frontier_.back();
+		frontier_.pop_back();
+
+		// A cheaper way to this tile was found after it was pushed.
+		if (cur.distance != distances_[index(cur.position)])
+			continue;
+		if (cur.distance >= maxDistance)
+			continue;
+		if (cur.position != target && !posOk(cur.position))
+			continue;
+
+		for (const Displacement d : PathDirs) {
+			const Point neighbor = cur.position + d;
+			if (!contains(neighbor) || !IsInGrid(neighbor))
+				continue;
+			const uint16_t distance = cur.distance + StepCost(cur.position, neighbor);
+			uint16_t &best = distances_[index(neighbor)];
+			if (distance >= best)
+				continue;
+			// The field is walked from the neighbor towards the target.
+			if (!canStep(neighbor, cur.position))
+				continue;
+			best = distance;
+			frontier_.push_back(FrontierNode { neighbor, distance });
+			std::push_heap(frontier_.begin(), frontier_.end(), isFurther);
+		}
+	}
+}
+
+template <typename CanStep, typename PosOk>
+int8_t FlowField::nextStep(CanStep &&canStep, PosOk &&posOk, Point position) const
+{
+	const uint16_t current = distance(position);
+	if (current == Unreachable)
+		return 0;
+
+	int8_t bestStep = 0;
+	int bestCost = std::numeric_limits<int>::max();
+	for (const Displacement d : PathDirs) {
+		const Point neighbor = position + d;
+		const uint16_t remaining = distance(neighbor);
+		if (remaining >= current)
+			continue;
+		const int cost = remaining + StepCost(position, neighbor);
+		if (cost >= bestCost)
+			continue;
+		if (neighbor != target_ && !posOk(neighbor))
+			continue;
+		if (!canStep(position, neighbor))
+			continue;
+		bestStep = GetPathDirection(position, neighbor);
+		bestCost = cost;
+	}
+	return bestStep;
+}
+
+} // namespace devilution
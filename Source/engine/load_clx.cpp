@@ -9,32 +9,24 @@
 #endif
 
 #include "appfat.h"
+#include "engine/asset_view.hpp"
 #include "engine/assets.hpp"
-#include "engine/load_file.hpp"
+#include "utils/status_macros.hpp"
 
 namespace devilution {
 
 OptionalOwnedClxSpriteListOrSheet LoadOptionalClxListOrSheet(const char *path)
 {
-	AssetRef ref = FindAsset(path);
-	if (!ref.ok())
+	tl::expected<AssetView, std::string> view = LoadAssetView(path);
+	if (!view.has_value())
 		return std::nullopt;
-	const size_t size = ref.size();
-	std::unique_ptr<uint8_t[]> data { new uint8_t[size] };
-	{
-		AssetHandle handle = OpenAsset(std::move(ref));
-		if (!handle.ok() || !handle.read(data.get(), size))
-			return std::nullopt;
-	}
-	return OwnedClxSpriteListOrSheet::FromBuffer(std::move(data), size);
+	return OwnedClxSpriteListOrSheet::FromBuffer(ToAssetBuffer(*view), view->size());
 }
 
 tl::expected<OwnedClxSpriteListOrSheet, std::string> LoadClxListOrSheetWithStatus(const char *path)
 {
-	size_t size;
-	tl::expected<std::unique_ptr<uint8_t[]>, std::string> data = LoadFileInMemWithStatus<uint8_t>(path, &size);
-	if (!data.has_value()) return tl::make_unexpected(std::move(data).error());
-	return OwnedClxSpriteListOrSheet::FromBuffer(std::move(data).value(), size);
+	ASSIGN_OR_RETURN(const AssetView view, LoadAssetView(path));
+	return OwnedClxSpriteListOrSheet::FromBuffer(ToAssetBuffer(view), view.size());
 }
 
 OwnedClxSpriteListOrSheet LoadClxListOrSheet(const char *path)
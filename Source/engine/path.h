@@ -5,6 +5,9 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -13,6 +16,8 @@
 
 #include "engine/displacement.hpp"
 #include "engine/point.hpp"
+#include "utils/attributes.h"
+#include "utils/static_vector.hpp"
 
 namespace devilution {
 
@@ -52,6 +57,233 @@ const Displacement PathDirs[8] = {
 	// clang-format on
 };
 
+/** @brief Width and height of the area searched by PathSearchContext, the size of the dungeon. */
+constexpr int PathSearchGridSize = 112;
+
+/**
+ * @brief Storage for path searches that is kept between calls, so searching does not allocate or clear anything.
+ *
+ * Explored nodes live in a dense grid over the dungeon. Every search stamps the nodes it explores
+ * with a new generation, so nodes left over from previous searches are simply ignored.
+ */
+class PathSearchContext {
+public:
+	/**
+	 * @brief Same as FindPath, with the predicates inlined into the search loop.
+	 *
+	 * @param canStep `bool(Point, Point)`, whether a step between two adjacent points is allowed.
+	 * @param posOk `bool(Point)`, whether a position can be stepped on.
+	 */
+	template <typename CanStep, typename PosOk>
+	int findPath(CanStep &&canStep, PosOk &&posOk, Point startPosition, Point destinationPosition, int8_t *path, size_t maxPathLength);
+
+private:
+	using CoordType = uint8_t;
+	using CostType = uint16_t;
+	using PointT = PointOf<CoordType>;
+
+	static constexpr size_t MaxFrontierNodes = 1024;
+	static constexpr size_t MaxExploredNodes = 3 * MaxFrontierNodes;
+
+	struct FrontierNode {
+		PointT position;
+
+		// Current best guess of the cost of the path to destination
+		// if it goes through this node.
+		CostType f;
+	};
+
+	struct ExploredNode {
+		// Preceding node (needed to reconstruct the path at the end).
+		PointT prev;
+
+		// The current lowest cost from start to this node (0 for the start node).
+		CostType g;
+	};
+
+	[[nodiscard]] static bool IsInGrid(PointT position)
+	{
+		return position.x < PathSearchGridSize && position.y < PathSearchGridSize;
+	}
+
+	[[nodiscard]] static size_t GridIndex(PointT position)
+	{
+		return static_cast<size_t>(position.x) * PathSearchGridSize + position.y;
+	}
+
+	[[nodiscard]] static bool IsDiagonalStep(PointT a, PointT b)
+	{
+		return a.x != b.x && a.y != b.y;
+	}
+
+	/**
+	 * @brief Returns the distance between 2 adjacent nodes.
+	 */
+	[[nodiscard]] static CostType GetDistance(PointT startPosition, PointT destinationPosition)
+	{
+		return IsDiagonalStep(startPosition, destinationPosition)
+		    ? PathDiagonalStepCost
+		    : PathAxisAlignedStepCost;
+	}
+
+	/**
+	 * @brief heuristic, estimated cost from startPosition to destinationPosition.
+	 */
+	[[nodiscard]] static CostType GetHeuristicCost(PointT startPosition, PointT destinationPosition)
+	{
+		// This function needs to be admissible, i.e. it should never over-estimate
+		// the distance.
+		//
+		// This calculation assumes we can take diagonal steps until we reach
+		// the same row or column and then take the remaining axis-aligned steps.
+		const int dx = std::abs(static_cast<int>(startPosition.x) - static_cast<int>(destinationPosition.x));
+		const int dy = std::abs(static_cast<int>(startPosition.y) - static_cast<int>(destinationPosition.y));
+		const int diagSteps = std::min(dx, dy);
+
+		// After we've taken `diagSteps`, the remaining steps in one coordinate
+		// will be zero, and in the other coordinate it will be reduced by `diagSteps`.
+		// We then still need to take the remaining steps:
+		//   max(dx, dy) - diagSteps = max(dx, dy) - min(dx, dy) = abs(dx - dy)
+		const int axisAlignedSteps = std::abs(dx - dy);
+		return diagSteps * PathDiagonalStepCost + axisAlignedSteps * PathAxisAlignedStepCost;
+	}
+
+	[[nodiscard]] bool isExplored(PointT position) const
+	{
+		return exploredGeneration_[GridIndex(position)] == generation_;
+	}
+
+	[[nodiscard]] const ExploredNode &explored(PointT position) const
+	{
+		return explored_[GridIndex(position)];
+	}
+
+	/** @brief Records a new lowest cost for reaching `position`, returns false if it is not an improvement. */
+	bool improve(PointT position, PointT prev, CostType g)
+	{
+		const size_t index = GridIndex(position);
+		if (exploredGeneration_[index] != generation_) {
+			if (exploredCount_ == MaxExploredNodes)
+				return false;
+			exploredGeneration_[index] = generation_;
+			exploredCount_++;
+		} else if (explored_[index].g <= g) {
+			return false;
+		}
+		explored_[index] = ExploredNode { .prev = prev, .g = g };
+		return true;
+	}
+
+	/** @brief Whether `a` should be expanded after `b`, which turns the <algorithm> max-heap functions into a min-heap. */
+	[[nodiscard]] bool isWorse(const FrontierNode &a, const FrontierNode &b) const
+	{
+		if (a.f != b.f) return a.f > b.f;
+
+		// For nodes with the same f-score, prefer the ones with lower
+		// heuristic cost (likely to be closer to the goal).
+		const CostType hA = GetHeuristicCost(a.position, destination_);
+		const CostType hB = GetHeuristicCost(b.position, destination_);
+		if (hA != hB) return hA > hB;
+
+		// Prefer diagonal steps first.
+		const bool isDiagonalA = IsDiagonalStep(explored(a.position).prev, a.position);
+		const bool isDiagonalB = IsDiagonalStep(explored(b.position).prev, b.position);
+		if (isDiagonalA != isDiagonalB) return isDiagonalB;
+
+		// Finally, disambiguate by coordinate:
+		if (a.position.x != b.position.x) return a.position.x > b.position.x;
+		return a.position.y > b.position.y;
+	}
+
+	void pushFrontier(FrontierNode node)
+	{
+		// We always push the node to the heap, even if the same position already exists in it.
+		// When popping from the heap, we discard invalid nodes by checking that `g + h <= f`.
+		if (frontier_.size() == MaxFrontierNodes)
+			return;
+		frontier_.emplace_back(node);
+		std::push_heap(frontier_.begin(), frontier_.end(), [this](const FrontierNode &a, const FrontierNode &b) { return isWorse(a, b); });
+	}
+
+	void popFrontier()
+	{
+		std::pop_heap(frontier_.begin(), frontier_.end(), [this](const FrontierNode &a, const FrontierNode &b) { return isWorse(a, b); });
+		frontier_.pop_back();
+	}
+
+	/** @brief Resets the context for a new search, returns false if the destination is out of reach. */
+	bool startSearch(PointT start, PointT destination, size_t maxPathLength);
+
+	int reconstructPath(PointT destination, int8_t *path, size_t maxPathLength) const;
+
+	StaticVector<FrontierNode, MaxFrontierNodes> frontier_;
+	std::array<ExploredNode, PathSearchGridSize * PathSearchGridSize> explored_;
+	/** @brief The generation in which each node of `explored_` was written, nodes of older generations are unexplored. */
+	std::array<uint32_t, PathSearchGridSize * PathSearchGridSize> exploredGeneration_ {};
+	uint32_t generation_ = 0;
+	size_t exploredCount_ = 0;
+	PointT destination_;
+
+	friend int TestPathGetHeuristicCost(Point startPosition, Point destinationPosition);
+};
+
+/**
+ * @brief The context used by FindPath, for game logic that searches many paths per tick.
+ *
+ * Not thread-safe, path searches have to be done on the game logic thread.
+ */
+PathSearchContext &GetPathSearchContext();
+
+template <typename CanStep, typename PosOk>
+int PathSearchContext::findPath(CanStep &&canStep, PosOk &&posOk, Point startPosition, Point destinationPosition, int8_t *path, size_t maxPathLength)
+{
+	const PointT start { startPosition };
+	const PointT dest { destinationPosition };
+	if (!startSearch(start, dest, maxPathLength))
+		return 0;
+
+	const size_t maxCost = PathDiagonalStepCost * maxPathLength;
+	while (!frontier_.empty()) {
+		const FrontierNode cur = frontier_.front(); // argmin(node.f) for node in openSet
+
+		if (cur.position == dest) {
+			return reconstructPath(cur.position, path, maxPathLength);
+		}
+
+		popFrontier();
+		const CostType curG = explored(cur.position).g;
+
+		// Discard invalid nodes.
+
+		// If this node is already at the maximum number of steps, we can skip processing it.
+		// We don't keep track of the maximum number of steps, so we approximate it.
+		if (curG >= maxCost) continue;
+
+		// When we discover a better path to a node, we push the node to the heap
+		// with the new `f` value even if the node is already in the heap.
+		if (curG + GetHeuristicCost(cur.position, dest) > cur.f) continue;
+
+		for (const DisplacementOf<int8_t> d : PathDirs) {
+			// We're using `uint8_t` for coordinates. Avoid underflow:
+			if ((cur.position.x == 0 && d.deltaX < 0) || (cur.position.y == 0 && d.deltaY < 0)) continue;
+			const PointT neighborPos = cur.position + d;
+			if (!IsInGrid(neighborPos)) continue;
+			if (posOk(Point { neighborPos })) {
+				if (!canStep(Point { cur.position }, Point { neighborPos })) continue;
+			} else {
+				// We allow targeting a non-walkable node if it is the destination.
+				if (neighborPos != dest) continue;
+			}
+			const CostType g = curG + GetDistance(cur.position, neighborPos);
+			if (improve(neighborPos, cur.position, g)) {
+				pushFrontier(FrontierNode { .position = neighborPos, .f = static_cast<CostType>(g + GetHeuristicCost(neighborPos, dest)) });
+			}
+		}
+	}
+
+	return 0; // no path
+}
+
 /**
  * Returns a number representing the direction from a starting tile to a neighbouring tile.
  *
@@ -19,6 +19,10 @@ private:
 	/** Borland C/C++ psuedo-random number generator needed for vanilla compatibility */
 	std::linear_congruential_engine<uint32_t, 0x015A4E35, 1, 0> lcg;
 
+	/** Multiplicative inverse of the engine multiplier modulo 2^32, used to step the engine backwards */
+	static constexpr uint32_t InverseMultiplier = 0x2925141D;
+	static_assert(static_cast<uint32_t>(0x015A4E35U * InverseMultiplier) == 1);
+
 public:
 	/**
 	 * @brief Set the state of the RandomNumberEngine used by the base game to the specific seed
@@ -40,6 +44,16 @@ public:
 		lcg.discard(count);
 	}
 
+	/**
+	 * @brief Returns the current engine state, the value GetLCGEngineState() returns for the global engine
+	 */
+	[[nodiscard]] uint32_t engineState() const
+	{
+		// The standard engine doesn't expose its state, so advance a copy and step the result back.
+		auto next = lcg;
+		return (next() - 1) * InverseMultiplier;
+	}
+
 	/**
 	 * @brief Generates a random non-negative integer (most of the time) using the vanilla RNG
 	 *
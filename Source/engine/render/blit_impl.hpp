@@ -6,6 +6,7 @@
 #include <version>
 
 #include "engine/palette.h"
+#include "engine/render/blit_simd.hpp"
 #include "engine/render/light_render.hpp"
 #include "utils/attributes.h"
 
@@ -78,6 +79,12 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithLightmap(uint8_t *DVL_RES
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
+#ifdef DEVILUTIONX_BLIT_AVX2
+	if (UseAvx2Blit && length >= MinVectorBlitLength) {
+		BlitPixelsWithLightmapAvx2(dst, src, light, length, lightmap);
+		return;
+	}
+#endif
 	std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, dst, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
 		return lightmap.adjustColor(srcColor, lightLevel);
 	});
@@ -158,6 +165,12 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithLightmap(uint8_t *
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
+#ifdef DEVILUTIONX_BLIT_AVX2
+	if (UseAvx2Blit && length >= MinVectorBlitLength) {
+		BlitPixelsBlendedWithLightmapAvx2(dst, src, light, length, lightmap);
+		return;
+	}
+#endif
 
 	if (length < 1024) {
 		uint8_t litSrc[1024];
@@ -0,0 +1,147 @@
+#include "engine/render/blit_simd.hpp"
+
+#include <cstddef>
+
+#include <SDL.h>
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+#include <immintrin.h>
+#endif
+
+#include "engine/palette.h"
+#include "lighting.h"
+
+namespace devilution {
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+bool UseAvx2Blit = IsBlitIsaSupported(BlitIsa::Avx2);
+#endif
+
+namespace {
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+/**
+ * @brief Loads the bytes at the given indices.
+ *
+ * A gather always reads 4 bytes, so indices above `lastSafeIndex` would read past the end of the table.
+ * Returns false in that case and the caller has to fall back to scalar lookups.
+ */
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE bool GatherBytes(const uint8_t *table, __m256i indices, __m256i lastSafeIndex, __m128i &result)
+{
+	const __m256i unsafe = _mm256_cmpgt_epi32(indices, lastSafeIndex);
+	if (!_mm256_testz_si256(unsafe, unsafe))
+		return false;
+	const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), indices, 1);
+	const __m256i bytes = _mm256_and_si256(words, _mm256_set1_epi32(0xFF));
+	const __m128i shorts = _mm_packus_epi32(_mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1));
+	result = _mm_packus_epi16(shorts, shorts);
+	return true;
+}
+
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE __m256i LoadIndices(const uint8_t *bytes)
+{
+	return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(bytes)));
+}
+
+/** @brief Last index of the light tables that can be gathered from, the light levels go up to LightsMax. */
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE __m256i LastSafeLightIndex(const Lightmap &lightmap)
+{
+	return _mm256_set1_epi32(static_cast<int>((LightsMax + 1) * lightmap.getLightTableSize() - 4));
+}
+#endif
+
+BlitIsa CurrentBlitIsa = IsBlitIsaSupported(BlitIsa::Avx2) ? BlitIsa::Avx2 : BlitIsa::Scalar;
+
+} // namespace
+
+std::string_view BlitIsaName(BlitIsa isa)
+{
+	switch (isa) {
+	case BlitIsa::Scalar:
+		return "Scalar";
+	case BlitIsa::Avx2:
+		return "AVX2";
+	}
+	return "Unknown";
+}
+
+bool IsBlitIsaSupported(BlitIsa isa)
+{
+	switch (isa) {
+	case BlitIsa::Scalar:
+		return true;
+	case BlitIsa::Avx2:
+#if defined(DEVILUTIONX_BLIT_AVX2) && SDL_VERSION_ATLEAST(2, 0, 4)
+		return SDL_HasAVX2() == SDL_TRUE;
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+BlitIsa GetBlitIsa()
+{
+	return CurrentBlitIsa;
+}
+
+void SetBlitIsa(BlitIsa isa)
+{
+	CurrentBlitIsa = isa;
+#ifdef DEVILUTIONX_BLIT_AVX2
+	UseAvx2Blit = isa == BlitIsa::Avx2;
+#endif
+}
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+DVL_TARGET_AVX2 void BlitPixelsWithLightmapAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const Lightmap &lightmap)
+{
+	const uint8_t *lightTables = lightmap.getLightTables();
+	const __m256i tableSize = _mm256_set1_epi32(static_cast<int>(lightmap.getLightTableSize()));
+	const __m256i lastSafeIndex = LastSafeLightIndex(lightmap);
+
+	unsigned i = 0;
+	for (; i + 8 <= length; i += 8) {
+		const __m256i indices = _mm256_add_epi32(_mm256_mullo_epi32(LoadIndices(light + i), tableSize), LoadIndices(src + i));
+		__m128i litColors;
+		if (GatherBytes(lightTables, indices, lastSafeIndex, litColors)) {
+			_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), litColors);
+			continue;
+		}
+		for (unsigned j = i; j < i + 8; j++)
+			dst[j] = lightmap.adjustColor(src[j], light[j]);
+	}
+	for (; i < length; i++)
+		dst[i] = lightmap.adjustColor(src[i], light[i]);
+}
+
+DVL_TARGET_AVX2 void BlitPixelsBlendedWithLightmapAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const Lightmap &lightmap)
+{
+	const uint8_t *lightTables = lightmap.getLightTables();
+	const uint8_t *blendTable = &paletteTransparencyLookup[0][0];
+	const __m256i tableSize = _mm256_set1_epi32(static_cast<int>(lightmap.getLightTableSize()));
+	const __m256i lastSafeIndex = LastSafeLightIndex(lightmap);
+	const __m256i lastSafeBlendIndex = _mm256_set1_epi32(static_cast<int>(sizeof(paletteTransparencyLookup) - 4));
+
+	unsigned i = 0;
+	for (; i + 8 <= length; i += 8) {
+		const __m256i indices = _mm256_add_epi32(_mm256_mullo_epi32(LoadIndices(light + i), tableSize), LoadIndices(src + i));
+		__m128i litColors;
+		if (GatherBytes(lightTables, indices, lastSafeIndex, litColors)) {
+			// paletteTransparencyLookup[dstColor][litColor]
+			const __m256i blendIndices = _mm256_add_epi32(_mm256_slli_epi32(LoadIndices(dst + i), 8), _mm256_cvtepu8_epi32(litColors));
+			__m128i blended;
+			if (GatherBytes(blendTable, blendIndices, lastSafeBlendIndex, blended)) {
+				_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), blended);
+				continue;
+			}
+		}
+		for (unsigned j = i; j < i + 8; j++)
+			dst[j] = paletteTransparencyLookup[dst[j]][lightmap.adjustColor(src[j], light[j])];
+	}
+	for (; i < length; i++)
+		dst[i] = paletteTransparencyLookup[dst[i]][lightmap.adjustColor(src[i], light[i])];
+}
+#endif
+
+} // namespace devilution
@@ -0,0 +1,66 @@
+/**
+ * @file blit_simd.hpp
+ *
+ * Vectorized versions of the per-pixel lighting blitters, selected at runtime.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "engine/render/light_render.hpp"
+#include "utils/attributes.h"
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && !defined(_M_ARM64EC)
+#define DEVILUTIONX_BLIT_AVX2
+#endif
+
+/** @brief Marks a function that uses AVX2 intrinsics, it must only be called when BlitIsa::Avx2 is supported. */
+#if defined(DEVILUTIONX_BLIT_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define DVL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DVL_TARGET_AVX2
+#endif
+
+namespace devilution {
+
+/** @brief Instruction sets that the per-pixel lighting blitters can be run with. */
+enum class BlitIsa : uint8_t {
+	Scalar,
+	Avx2,
+};
+
+[[nodiscard]] std::string_view BlitIsaName(BlitIsa isa);
+
+[[nodiscard]] bool IsBlitIsaSupported(BlitIsa isa);
+
+/** @brief The instruction set in use, the best one supported by the CPU unless overridden. */
+[[nodiscard]] BlitIsa GetBlitIsa();
+
+/** @brief Overrides the instruction set, used by benchmarks to compare them. Must be supported by the CPU. */
+void SetBlitIsa(BlitIsa isa);
+
+/** @brief Lines shorter than this are not worth leaving the scalar path for. */
+constexpr unsigned MinVectorBlitLength = 8;
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+/** @brief Whether GetBlitIsa() is BlitIsa::Avx2, checked once per line. */
+extern bool UseAvx2Blit;
+
+/**
+ * @brief AVX2 version of BlitPixelsWithLightmap.
+ *
+ * Builds the `lightLevel * lightTableSize + color` indices eight pixels at a time
+ * and looks them up with a single gather.
+ */
+void BlitPixelsWithLightmapAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const Lightmap &lightmap);
+
+/**
+ * @brief AVX2 version of BlitPixelsBlendedWithLightmap.
+ *
+ * Both the lighting and the `paletteTransparencyLookup` blend are done with gathers.
+ */
+void BlitPixelsBlendedWithLightmapAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const Lightmap &lightmap);
+#endif
+
+} // namespace devilution
@@ -0,0 +1,67 @@
+#include "engine/render/dirty_tiles.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+#include "levels/gendung.h"
+
+namespace devilution {
+
+namespace {
+
+std::bitset<MAXDUNX * MAXDUNY> DirtyTiles;
+bool AllTilesDirty = true;
+
+size_t TileIndex(Point position)
+{
+	return static_cast<size_t>(position.x) * MAXDUNY + static_cast<size_t>(position.y);
+}
+
+} // namespace
+
+void MarkTileDirty(Point position)
+{
+	if (InDungeonBounds(position))
+		DirtyTiles.set(TileIndex(position));
+}
+
+void MarkTilesDirty(Point center, int radius)
+{
+	const int minX = std::max(center.x - radius, 0);
+	const int maxX = std::min(center.x + radius, MAXDUNX - 1);
+	const int minY = std::max(center.y - radius, 0);
+	const int maxY = std::min(center.y + radius, MAXDUNY - 1);
+	for (int x = minX; x <= maxX; x++) {
+		for (int y = minY; y <= maxY; y++) {
+			DirtyTiles.set(TileIndex({ x, y }));
+		}
+	}
+}
+
+void MarkAllTilesDirty()
+{
+	AllTilesDirty = true;
+}
+
+bool IsTileDirty(Point position)
+{
+	return AllTilesDirty || (InDungeonBounds(position) && DirtyTiles.test(TileIndex(position)));
+}
+
+bool AreAllTilesDirty()
+{
+	return AllTilesDirty;
+}
+
+bool HasDirtyTiles()
+{
+	return AllTilesDirty || DirtyTiles.any();
+}
+
+void ClearDirtyTiles()
+{
+	DirtyTiles.reset();
+	AllTilesDirty = false;
+}
+
+} // namespace devilution
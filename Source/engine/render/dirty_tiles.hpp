@@ -0,0 +1,31 @@
+/**
+ * @file dirty_tiles.hpp
+ *
+ * Tracks the dungeon tiles that may look different than when the game view was last drawn,
+ * so that the view only has to be redrawn where something changed.
+ */
+#pragma once
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/** @brief Marks a tile as needing to be redrawn. Positions outside of the dungeon are ignored. */
+void MarkTileDirty(Point position);
+
+/** @brief Marks every tile within `radius` tiles of `center` as needing to be redrawn. */
+void MarkTilesDirty(Point center, int radius);
+
+/** @brief Marks the whole dungeon as needing to be redrawn, e.g. when the camera moved. */
+void MarkAllTilesDirty();
+
+[[nodiscard]] bool IsTileDirty(Point position);
+
+[[nodiscard]] bool AreAllTilesDirty();
+
+[[nodiscard]] bool HasDirtyTiles();
+
+/** @brief Called once the dirty tiles have been redrawn. */
+void ClearDirtyTiles();
+
+} // namespace devilution
@@ -23,6 +23,16 @@ public:
 		return lightTables[offset];
 	}
 
+	const uint8_t *getLightTables() const
+	{
+		return lightTables;
+	}
+
+	size_t getLightTableSize() const
+	{
+		return lightTableSize;
+	}
+
 	const uint8_t *getLightingAt(const uint8_t *outLoc) const
 	{
 		const ptrdiff_t outDist = outLoc - outBuffer;
@@ -46,6 +56,19 @@ public:
 
 	static Lightmap bleedUp(const Lightmap &source, Point targetBufferPosition, std::span<uint8_t> lightmapBuffer);
 
+	/**
+	 * @brief Returns the lightmap of the output buffer starting at row `y`, to be used with `Surface::subregionY`.
+	 *
+	 * The rows below are kept so that tiles straddling the bottom edge are lit the same way.
+	 */
+	Lightmap subregionY(int y) const
+	{
+		const size_t offset = static_cast<size_t>(y) * lightmapPitch;
+		return Lightmap(outBuffer + y * outPitch, outPitch,
+		    offset < lightmapBuffer.size() ? lightmapBuffer.subspan(offset) : std::span<const uint8_t> {}, lightmapPitch,
+		    lightTables, lightTableSize);
+	}
+
 private:
 	const uint8_t *outBuffer;
 	const uint16_t outPitch;
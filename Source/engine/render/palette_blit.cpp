@@ -0,0 +1,148 @@
+#include "engine/render/palette_blit.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "engine/render/blit_simd.hpp"
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+#include <immintrin.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+#ifndef USE_SDL1
+struct PaletteLut {
+	const SDL_Palette *palette = nullptr;
+	Uint32 paletteVersion = 0;
+	Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+	std::array<uint32_t, 256> colors;
+};
+
+PaletteLut CachedLut;
+
+const uint32_t *GetPaletteLut(const SDL_Palette &palette, const SDL_PixelFormat &format)
+{
+	if (CachedLut.palette == &palette && CachedLut.paletteVersion == palette.version && CachedLut.format == format.format)
+		return CachedLut.colors.data();
+
+	CachedLut.palette = &palette;
+	CachedLut.paletteVersion = palette.version;
+	CachedLut.format = format.format;
+	const int numColors = std::min(palette.ncolors, static_cast<int>(CachedLut.colors.size()));
+	for (int i = 0; i < numColors; i++) {
+		const SDL_Color &color = palette.colors[i];
+		CachedLut.colors[i] = SDL_MapRGBA(&format, color.r, color.g, color.b, color.a);
+	}
+	std::fill(CachedLut.colors.begin() + numColors, CachedLut.colors.end(), 0);
+	return CachedLut.colors.data();
+}
+#endif
+
+void ExpandPalettedPixelsScalar(uint32_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint32_t *DVL_RESTRICT lut)
+{
+	unsigned i = 0;
+	for (; i + 4 <= length; i += 4) {
+		dst[i] = lut[src[i]];
+		dst[i + 1] = lut[src[i + 1]];
+		dst[i + 2] = lut[src[i + 2]];
+		dst[i + 3] = lut[src[i + 3]];
+	}
+	for (; i < length; i++)
+		dst[i] = lut[src[i]];
+}
+
+#ifdef DEVILUTIONX_BLIT_AVX2
+/** @brief Sixteen pixels per iteration, two gathers of eight. The indices never exceed the table. */
+DVL_TARGET_AVX2 void ExpandPalettedPixelsAvx2(uint32_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint32_t *DVL_RESTRICT lut)
+{
+	const auto *table = reinterpret_cast<const int *>(lut);
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16) {
+		const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		const __m256i lo = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices), 4);
+		const __m256i hi = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 8), hi);
+	}
+	ExpandPalettedPixelsScalar(dst + i, src + i, length - i, lut);
+}
+#endif
+
+} // namespace
+
+void ExpandPalettedPixels(uint32_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint32_t *DVL_RESTRICT lut)
+{
+#ifdef DEVILUTIONX_BLIT_AVX2
+	if (UseAvx2Blit && length >= MinVectorBlitLength) {
+		ExpandPalettedPixelsAvx2(dst, src, length, lut);
+		return;
+	}
+#endif
+	ExpandPalettedPixelsScalar(dst, src, length, lut);
+}
+
+#ifndef USE_SDL1
+bool BlitPalettedSurface(SDL_Surface *src, const SDL_Rect *srcRect, SDL_Surface *dst, SDL_Rect *dstRect)
+{
+	const SDL_PixelFormat &srcFormat = *src->format;
+	const SDL_PixelFormat &dstFormat = *dst->format;
+	Uint32 colorKey;
+	if (srcFormat.BytesPerPixel != 1 || srcFormat.palette == nullptr || dstFormat.BytesPerPixel != 4
+	    || SDL_GetColorKey(src, &colorKey) == 0 || SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst)) {
+		return false;
+	}
+
+	SDL_Rect area = srcRect != nullptr ? *srcRect : SDL_Rect { 0, 0, src->w, src->h };
+	int dstX = dstRect != nullptr ? dstRect->x : 0;
+	int dstY = dstRect != nullptr ? dstRect->y : 0;
+
+	// Clip to the source surface.
+	if (area.x < 0) {
+		dstX -= area.x;
+		area.w += area.x;
+		area.x = 0;
+	}
+	if (area.y < 0) {
+		dstY -= area.y;
+		area.h += area.y;
+		area.y = 0;
+	}
+	area.w = std::min(area.w, src->w - area.x);
+	area.h = std::min(area.h, src->h - area.y);
+
+	// Clip to the destination clip rectangle.
+	const SDL_Rect &clip = dst->clip_rect;
+	if (dstX < clip.x) {
+		area.x += clip.x - dstX;
+		area.w -= clip.x - dstX;
+		dstX = clip.x;
+	}
+	if (dstY < clip.y) {
+		area.y += clip.y - dstY;
+		area.h -= clip.y - dstY;
+		dstY = clip.y;
+	}
+	area.w = std::min(area.w, clip.x + clip.w - dstX);
+	area.h = std::min(area.h, clip.y + clip.h - dstY);
+
+	if (dstRect != nullptr)
+		*dstRect = SDL_Rect { dstX, dstY, std::max(area.w, 0), std::max(area.h, 0) };
+	if (area.w <= 0 || area.h <= 0)
+		return true;
+
+	const uint32_t *lut = GetPaletteLut(*srcFormat.palette, dstFormat);
+	const auto *srcRow = static_cast<const uint8_t *>(src->pixels) + static_cast<ptrdiff_t>(area.y) * src->pitch + area.x;
+	auto *dstRow = static_cast<uint8_t *>(dst->pixels) + static_cast<ptrdiff_t>(dstY) * dst->pitch + static_cast<ptrdiff_t>(dstX) * 4;
+	for (int y = 0; y < area.h; y++) {
+		ExpandPalettedPixels(reinterpret_cast<uint32_t *>(dstRow), srcRow, static_cast<unsigned>(area.w), lut);
+		srcRow += src->pitch;
+		dstRow += dst->pitch;
+	}
+	return true;
+}
+#endif
+
+} // namespace devilution
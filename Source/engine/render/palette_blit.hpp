@@ -0,0 +1,36 @@
+/**
+ * @file palette_blit.hpp
+ *
+ * Conversion of the 8-bit back buffer to the 32-bit output surface.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <SDL.h>
+
+#include "utils/attributes.h"
+
+namespace devilution {
+
+/**
+ * @brief Expands palette indices to 32-bit pixels with a 256-entry lookup table.
+ *
+ * Uses AVX2 gathers when GetBlitIsa() is BlitIsa::Avx2.
+ */
+void ExpandPalettedPixels(uint32_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint32_t *DVL_RESTRICT lut);
+
+#ifndef USE_SDL1
+/**
+ * @brief Drop-in replacement for `SDL_BlitSurface` from an 8-bit paletted surface to a 32-bit surface.
+ *
+ * Clips the same way `SDL_BlitSurface` does and, if `dstRect` is not null, sets it to the area that was written.
+ * The lookup table is rebuilt only when the palette or the destination format change.
+ *
+ * @return false if the surfaces are not supported, in which case nothing is written and the caller
+ *         should fall back to `SDL_BlitSurface`.
+ */
+bool BlitPalettedSurface(SDL_Surface *src, const SDL_Rect *srcRect, SDL_Surface *dst, SDL_Rect *dstRect);
+#endif
+
+} // namespace devilution
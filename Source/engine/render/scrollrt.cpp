@@ -5,11 +5,14 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <array>
+#include <bitset>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-
-#include <ankerl/unordered_dense.h>
+#include <cstring>
+#include <optional>
+#include <vector>
 
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
@@ -24,9 +27,11 @@
 #include "engine/dx.h"
 #include "engine/point.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/dirty_tiles.hpp"
 #include "engine/render/dun_render.hpp"
 #include "engine/render/light_render.hpp"
 #include "engine/render/text_render.hpp"
+#include "engine/tick_profiler.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "gmenu.h"
@@ -56,11 +61,13 @@
 #include "qol/xpbar.h"
 #include "stores.h"
 #include "towners.h"
+#include "utils/algorithm/container.hpp"
 #include "utils/attributes.h"
 #include "utils/display.h"
 #include "utils/is_of.hpp"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/worker_pool.hpp"
 
 #ifndef USE_SDL1
 #include "controls/touch/renderers.h"
@@ -97,10 +104,22 @@ constexpr auto RightFrameDisplacement = Displacement { DunFrameWidth, 0 };
 	return !IsFloor(tilePosition) || dSpecial[tilePosition.x][tilePosition.y] != 0;
 }
 
+struct MissileAtRenderingTile {
+	Missile *missile;
+	WorldTilePosition tile;
+	/** @brief 1 + index of the next missile on the same tile, 0 if this is the last one. */
+	uint32_t next;
+};
+
+/**
+ * @brief Contains all Missile in the dungeon at rendering position, in the order they are drawn.
+ */
+std::vector<MissileAtRenderingTile> MissilesAtRenderingTile;
+
 /**
- * @brief Contains all Missile at rendering position
+ * @brief 1 + index into MissilesAtRenderingTile of the first missile drawn on each tile, 0 if there are none.
  */
-ankerl::unordered_dense::map<WorldTilePosition, std::vector<Missile *>> MissilesAtRenderingTile;
+uint32_t FirstMissileAtRenderingTile[MAXDUNX][MAXDUNY];
 
 /**
  * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
@@ -176,11 +195,24 @@ void UpdateMissileRendererData(Missile &m)
 
 void UpdateMissilesRendererData()
 {
+	// Only the tiles that had missiles need to be reset.
+	for (const MissileAtRenderingTile &entry : MissilesAtRenderingTile)
+		FirstMissileAtRenderingTile[entry.tile.x][entry.tile.y] = 0;
 	MissilesAtRenderingTile.clear();
 
 	for (auto &m : Missiles) {
 		UpdateMissileRendererData(m);
-		MissilesAtRenderingTile[m.position.tileForRendering].push_back(&m);
+		// Only tiles in the dungeon are drawn
+		if (InDungeonBounds(Point { m.position.tileForRendering.x, m.position.tileForRendering.y }))
+			MissilesAtRenderingTile.push_back({ &m, m.position.tileForRendering, 0 });
+	}
+
+	// Linked back to front so each tile lists its missiles in the order they were added.
+	for (size_t i = MissilesAtRenderingTile.size(); i-- > 0;) {
+		MissileAtRenderingTile &entry = MissilesAtRenderingTile[i];
+		uint32_t &first = FirstMissileAtRenderingTile[entry.tile.x][entry.tile.y];
+		entry.next = first;
+		first = static_cast<uint32_t>(i + 1);
 	}
 }
 
@@ -307,10 +339,10 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
  */
 void DrawMissile(const Surface &out, WorldTilePosition tilePosition, Point targetBufferPosition, bool pre, int lightTableIndex)
 {
-	const auto it = MissilesAtRenderingTile.find(tilePosition);
-	if (it == MissilesAtRenderingTile.end()) return;
-	for (Missile *missile : it->second) {
-		DrawMissilePrivate(out, *missile, targetBufferPosition, pre, lightTableIndex);
+	for (uint32_t i = FirstMissileAtRenderingTile[tilePosition.x][tilePosition.y]; i != 0;) {
+		const MissileAtRenderingTile &entry = MissilesAtRenderingTile[i - 1];
+		DrawMissilePrivate(out, *entry.missile, targetBufferPosition, pre, lightTableIndex);
+		i = entry.next;
 	}
 }
 
@@ -425,6 +457,30 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 	DrawPlayerIcons(out, player, targetBufferPosition, /*infraVision=*/false, lightTableIndex);
 }
 
+bool IsDeadPlayerOnTile(const Player &player, Point tilePosition)
+{
+	return player.plractive && player._pHitPoints == 0 && player.isOnActiveLevel() && player.position.tile == tilePosition;
+}
+
+/**
+ * @brief Clears DungeonFlag::DeadPlayer from tiles whose dead player has since left or been revived.
+ *
+ * This is done once before rendering rather than while drawing each tile,
+ * so that the bands of the viewport can be rendered concurrently.
+ */
+void UpdateDeadPlayerFlags()
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			if (!HasAnyOf(dFlags[x][y], DungeonFlag::DeadPlayer))
+				continue;
+			const Point tilePosition { x, y };
+			if (c_none_of(Players, [&](const Player &player) { return IsDeadPlayerOnTile(player, tilePosition); }))
+				dFlags[x][y] &= ~DungeonFlag::DeadPlayer;
+		}
+	}
+}
+
 /**
  * @brief Render a player sprite
  * @param out Output buffer
@@ -433,11 +489,8 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
  */
 void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
-
 	for (Player &player : Players) {
-		if (player.plractive && player._pHitPoints == 0 && player.isOnActiveLevel() && player.position.tile == tilePosition) {
-			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
+		if (IsDeadPlayerOnTile(player, tilePosition)) {
 			const Point playerRenderPosition { targetBufferPosition };
 			DrawPlayer(out, player, tilePosition, playerRenderPosition, lightTableIndex);
 		}
@@ -468,7 +521,7 @@ void DrawObject(const Surface &out, const Object &objectToDraw, Point tilePositi
 	}
 }
 
-static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
+static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/, Point /*tilePosition*/, Point /*targetBufferPosition*/, bool /*primaryBand*/);
 
 /**
  * @brief Render a cell
@@ -637,8 +690,9 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
+ * @param addLabel Queue the item label, only done by the first band when rendering concurrently
  */
-void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex)
+void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex, bool addLabel)
 {
 	const Item &item = Items[itemIndex];
 	const ClxSprite sprite = item.AnimInfo.currentSprite();
@@ -647,7 +701,7 @@ void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition,
 		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
 	}
 	ClxDrawLight(out, position, sprite, lightTableIndex);
-	if (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK)
+	if (addLabel && (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK))
 		AddItemToLabelQueue(itemIndex, position);
 }
 
@@ -704,8 +758,9 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
  * @param lightmap Per-pixel light buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
+ * @param primaryBand Whether this is the topmost band, which also records the on-screen item labels
  */
-void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
+void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, bool primaryBand)
 {
 	assert(InDungeonBounds(tilePosition));
 	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
@@ -745,7 +800,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
 	}
 	if (bItem > 0 && !Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
+		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex, primaryBand);
 	}
 
 	if (TileContainsDeadPlayer(tilePosition)) {
@@ -831,7 +886,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
 	}
 	if (bItem > 0 && Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
+		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex, primaryBand);
 	}
 
 	if (leveltype != DTYPE_TOWN) {
@@ -882,18 +937,21 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
 {
 	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
-			if (!InDungeonBounds(tilePosition)) {
-				world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
-				continue;
-			}
-			if (IsFloor(tilePosition)) {
-				DrawFloorTile(out, lightmap, tilePosition, targetBufferPosition);
+		// Floor tiles never extend past their base diamond, so rows outside of the buffer can be skipped
+		if (targetBufferPosition.y >= 0 && targetBufferPosition.y - TILE_HEIGHT < out.h()) {
+			for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
+				if (!InDungeonBounds(tilePosition)) {
+					world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
+					continue;
+				}
+				if (IsFloor(tilePosition)) {
+					DrawFloorTile(out, lightmap, tilePosition, targetBufferPosition);
+				}
 			}
+			// Return to start of row
+			tilePosition += Displacement(Direction::West) * columns;
+			targetBufferPosition.x -= columns * TILE_WIDTH;
 		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
 
 		// Jump to next row
 		targetBufferPosition.y += TILE_HEIGHT / 2;
@@ -917,14 +975,16 @@ void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition,
  * @param targetBufferPosition Buffer coordinates
  * @param rows Number of rows
  * @param columns Tile in a row
+ * @param primaryBand Whether this is the topmost band, which also records the on-screen positions of tiles and item labels
  */
-void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns, bool primaryBand)
 {
 	// Keep evaluating until MicroTiles can't affect screen
 	rows += MicroTileLen;
 
 #ifdef _DEBUG
-	DebugCoordsMap.reserve(rows * columns);
+	if (primaryBand)
+		DebugCoordsMap.reserve(rows * columns);
 #endif
 
 	for (int i = 0; i < rows; i++) {
@@ -933,7 +993,8 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 			if (InDungeonBounds(tilePosition)) {
 				bool skipNext = false;
 #ifdef _DEBUG
-				DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
+				if (primaryBand)
+					DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
 #endif
 				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
 					// Render objects behind walls first to prevent sprites, that are moving
@@ -942,13 +1003,13 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 					// sprite screen position rather than tile position.
 					if (IsWall(tilePosition) && (IsWall(tilePosition + Displacement { 1, 0 }) || (tilePosition.x > 0 && IsWall(tilePosition + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
 						if (IsTileNotSolid(tilePosition + Displacement { 1, -1 }) && IsTileNotSolid(tilePosition + Displacement { 0, -1 })) {                              // Has walkable area behind it
-							DrawDungeon(out, lightmap, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+							DrawDungeon(out, lightmap, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y }, primaryBand);
 							skipNext = true;
 						}
 					}
 				}
 				if (!skip) {
-					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition);
+					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition, primaryBand);
 				}
 				skip = skipNext;
 			}
@@ -1033,6 +1094,337 @@ Displacement tileShift;
 int tileColumns;
 int tileRows;
 
+std::optional<WorkerPool> RenderWorkers;
+
+/**
+ * @brief Whether the view should be split into bands that are rendered on RenderWorkers.
+ */
+bool UseRenderWorkers()
+{
+	if (!*GetOptions().Graphics.multithreadedRendering) {
+		RenderWorkers = std::nullopt;
+		return false;
+	}
+#ifdef DUN_RENDER_STATS
+	// The statistics are collected in a map that is shared by all the bands.
+	return false;
+#endif
+#ifdef _DEBUG
+	// Path indices are drawn as text, which is not safe to do from several threads.
+	if (DebugPath)
+		return false;
+#endif
+	if (!RenderWorkers)
+		RenderWorkers.emplace(WorkerPool::DefaultThreadCount());
+	return RenderWorkers->concurrency() > 1;
+}
+
+/**
+ * @brief Renders the floor and tile content of horizontal bands of the view concurrently.
+ *
+ * Each band walks the whole tile grid but clips to its own rows, so the tiles and sprites
+ * are still drawn in the same order as when rendering on a single thread.
+ */
+void DrawBands(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+{
+	const int bandCount = static_cast<int>(RenderWorkers->concurrency());
+	const int bandHeight = (out.h() + bandCount - 1) / bandCount;
+	RenderWorkers->parallelFor(bandCount, [&](unsigned band) {
+		const int top = static_cast<int>(band) * bandHeight;
+		if (top >= out.h())
+			return;
+		const Surface bandOut = out.subregionY(top, std::min(bandHeight, out.h() - top));
+		const Lightmap bandLightmap = lightmap.subregionY(top);
+		const Point bandPosition = targetBufferPosition - Displacement { 0, top };
+		DrawFloor(bandOut, bandLightmap, tilePosition, bandPosition, rows, columns);
+		DrawTileContent(bandOut, bandLightmap, tilePosition, bandPosition, rows, columns, /*primaryBand=*/band == 0);
+	});
+}
+
+/** @brief The game view as drawn in the previous frame, kept apart from the back buffer that the UI is drawn on. */
+std::optional<OwnedSurface> ViewCache;
+
+/**
+ * @brief Everything besides the tiles themselves that affects how the view is drawn.
+ *
+ * The whole view is redrawn when any of it changes.
+ */
+struct ViewState {
+	Point position;
+	Displacement offset;
+	int rows;
+	int columns;
+	dungeon_type levelType;
+	uint8_t level;
+	bool isSetLevel;
+	bool infravision;
+	bool inStore;
+	bool showItems;
+	bool perPixelLighting;
+
+	bool operator==(const ViewState &other) const = default;
+};
+
+/** @brief State of the view when ViewCache was drawn, empty if it has to be drawn from scratch. */
+std::optional<ViewState> CachedViewState;
+
+/** @brief Digest of everything drawn on each tile in the previous frame, indexed by `x * MAXDUNY + y`. */
+std::array<uint32_t, MAXDUNX * MAXDUNY> TileDigests;
+
+/** @brief How far the sprites of a frame reach above and below the tile they are drawn on. */
+struct SpriteExtent {
+	int above;
+	int below;
+};
+
+SpriteExtent CurrentSpriteExtent;
+SpriteExtent PreviousSpriteExtent;
+
+/** @brief Rows `[top, bottom)` of the view. */
+struct ViewRows {
+	int top;
+	int bottom;
+};
+
+uint32_t MixDigest(uint32_t digest, uint32_t value)
+{
+	return (digest ^ value) * 16777619U;
+}
+
+uint32_t MixSprite(uint32_t digest, ClxSprite sprite, Displacement offset, bool outlined)
+{
+	CurrentSpriteExtent.above = std::max(CurrentSpriteExtent.above, sprite.height() - offset.deltaY);
+	CurrentSpriteExtent.below = std::max(CurrentSpriteExtent.below, offset.deltaY);
+	digest = MixDigest(digest, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(sprite.pixelData())));
+	digest = MixDigest(digest, static_cast<uint32_t>(offset.deltaX));
+	digest = MixDigest(digest, static_cast<uint32_t>(offset.deltaY));
+	return MixDigest(digest, outlined ? 1 : 0);
+}
+
+uint32_t MixPlayer(uint32_t digest, const Player &player)
+{
+	if (!player.AnimInfo.sprites && !player.previewCelSprite)
+		return digest;
+	const ClxSprite sprite = player.currentSprite();
+	digest = MixSprite(digest, sprite, player.getRenderingOffset(sprite), &player == PlayerUnderCursor);
+	digest = MixDigest(digest, static_cast<uint32_t>(player._pmode));
+	digest = MixDigest(digest, static_cast<uint32_t>(player._pdir));
+	return MixDigest(digest, (player.pManaShield ? 1 : 0) | (player.wReflections > 0 ? 2 : 0));
+}
+
+/**
+ * @brief Computes a digest of the dungeon data and the sprites that DrawDungeon draws for a tile.
+ */
+uint32_t DigestTile(Point tilePosition)
+{
+	const int x = tilePosition.x;
+	const int y = tilePosition.y;
+	uint32_t digest = 2166136261U;
+	digest = MixDigest(digest, dPiece[x][y]);
+	digest = MixDigest(digest, static_cast<uint8_t>(dFlags[x][y]));
+	digest = MixDigest(digest, TransList[dTransVal[x][y]] ? 1 : 0);
+	digest = MixDigest(digest, static_cast<uint8_t>(dCorpse[x][y]));
+
+	if (const int8_t bArch = dSpecial[x][y] - 1; bArch >= 0 && pSpecialCels) {
+		digest = MixSprite(digest, (*pSpecialCels)[bArch], {}, false);
+	}
+	if (leveltype == DTYPE_TOWN && x > 0 && y > 0) {
+		// Tree leaves are drawn along with the tile below them
+		if (const int8_t bArch = dSpecial[x - 1][y - 1] - 1; bArch >= 0 && pSpecialCels)
+			digest = MixSprite(digest, (*pSpecialCels)[bArch], { 0, -TILE_HEIGHT }, false);
+	}
+
+	if (const int monsterId = dMonster[x][y]; monsterId != 0) {
+		const int mi = std::abs(monsterId) - 1;
+		digest = MixDigest(digest, static_cast<uint32_t>(monsterId));
+		if (leveltype == DTYPE_TOWN) {
+			const Towner &towner = Towners[mi];
+			digest = MixSprite(digest, towner.currentSprite(), towner.getRenderingOffset(), mi == pcursmonst);
+		} else if (static_cast<size_t>(mi) < MaxMonsters && Monsters[mi].animInfo.sprites) {
+			const Monster &monster = Monsters[mi];
+			const ClxSprite sprite = monster.animInfo.currentSprite();
+			digest = MixSprite(digest, sprite, monster.getRenderingOffset(sprite), mi == pcursmonst);
+			digest = MixDigest(digest, static_cast<uint32_t>(monster.mode));
+			digest = MixDigest(digest, static_cast<uint32_t>(monster.flags));
+		}
+	}
+
+	if (const int playerId = dPlayer[x][y]; playerId != 0) {
+		digest = MixDigest(digest, static_cast<uint32_t>(playerId));
+		digest = MixPlayer(digest, Players[std::abs(playerId) - 1]);
+	}
+	if (HasAnyOf(dFlags[x][y], DungeonFlag::DeadPlayer)) {
+		for (const Player &player : Players) {
+			if (IsDeadPlayerOnTile(player, tilePosition))
+				digest = MixPlayer(digest, player);
+		}
+	}
+
+	if (const int8_t bItem = dItem[x][y]; bItem > 0) {
+		const Item &item = Items[bItem - 1];
+		if (item.AnimInfo.sprites) {
+			const ClxSprite sprite = item.AnimInfo.currentSprite();
+			digest = MixSprite(digest, sprite, item.getRenderingOffset(sprite), bItem - 1 == pcursitem);
+		}
+	}
+
+	if (const Object *object = FindObjectAtPosition(tilePosition); object != nullptr && object->_oAnimData) {
+		const ClxSprite sprite = object->currentSprite();
+		digest = MixSprite(digest, sprite, object->getRenderingOffset(sprite, tilePosition), object == ObjectUnderCursor);
+		digest = MixDigest(digest, (object->_oPreFlag ? 1 : 0) | (object->applyLighting ? 2 : 0));
+	}
+
+	return digest;
+}
+
+/**
+ * @brief Marks the tiles whose digest changed since the previous frame as dirty.
+ */
+void MarkChangedTilesDirty()
+{
+	PreviousSpriteExtent = CurrentSpriteExtent;
+	CurrentSpriteExtent = {};
+
+	static std::array<uint32_t, MAXDUNX * MAXDUNY> digests;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			digests[x * MAXDUNY + y] = DigestTile({ x, y });
+		}
+	}
+	for (const MissileAtRenderingTile &entry : MissilesAtRenderingTile) {
+		const Missile *missile = entry.missile;
+		if (!missile->_miDrawFlag || !missile->_miAnimData)
+			continue;
+		uint32_t &digest = digests[entry.tile.x * MAXDUNY + entry.tile.y];
+		const ClxSprite sprite = (*missile->_miAnimData)[missile->_miAnimFrame - 1];
+		digest = MixSprite(digest, sprite, missile->position.offsetForRendering - Displacement { missile->_miAnimWidth2, 0 }, false);
+		digest = MixDigest(digest, missile->_miPreFlag ? 1 : 0);
+	}
+
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			const size_t index = x * MAXDUNY + y;
+			if (digests[index] != TileDigests[index]) {
+				TileDigests[index] = digests[index];
+				MarkTileDirty({ x, y });
+			}
+		}
+	}
+}
+
+/**
+ * @brief Finds the rows of the view that have to be redrawn because tiles drawn on them are dirty.
+ * @param position First tile of view in dPiece coordinate
+ * @param offset Amount to offset the rendering in screen space
+ * @param viewHeight Height of the view
+ * @param dirtyRows Sorted, non-overlapping ranges of rows that have to be redrawn
+ * @return false if the whole view has to be redrawn
+ */
+bool CollectDirtyRows(Point position, Displacement offset, int rows, int columns, int viewHeight, std::vector<ViewRows> &dirtyRows)
+{
+	const ViewState state {
+		.position = position,
+		.offset = offset,
+		.rows = rows,
+		.columns = columns,
+		.levelType = leveltype,
+		.level = currlevel,
+		.isSetLevel = setlevel,
+		.infravision = MyPlayer->_pInfraFlag,
+		.inStore = IsPlayerInStore(),
+		.showItems = AutoMapShowItems,
+		.perPixelLighting = *GetOptions().Graphics.perPixelLighting,
+	};
+	if (CachedViewState != state || IsRedrawEverything())
+		MarkAllTilesDirty();
+	CachedViewState = state;
+
+	MarkChangedTilesDirty();
+	if (AreAllTilesDirty())
+		return false;
+
+	// Walls are drawn up from the base of their tile, sprites may also reach below it when moving
+	const int above = std::max({ MicroTileLen / 2 * TILE_HEIGHT, CurrentSpriteExtent.above, PreviousSpriteExtent.above }) + TILE_HEIGHT;
+	const int below = std::max({ 0, CurrentSpriteExtent.below, PreviousSpriteExtent.below }) + TILE_HEIGHT;
+
+	// All the tiles with the same `x + y` are drawn on the same rows
+	std::bitset<MAXDUNX + MAXDUNY> dirtyDiagonals;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			if (IsTileDirty({ x, y }))
+				dirtyDiagonals.set(x + y);
+		}
+	}
+
+	const int firstDiagonal = position.x + position.y;
+	for (size_t diagonal = 0; diagonal < dirtyDiagonals.size(); diagonal++) {
+		if (!dirtyDiagonals.test(diagonal))
+			continue;
+		const int base = offset.deltaY + (static_cast<int>(diagonal) - firstDiagonal) * TILE_HEIGHT / 2;
+		const int top = std::max(base - above, 0);
+		const int bottom = std::min(base + below, viewHeight);
+		if (top >= bottom)
+			continue;
+		if (!dirtyRows.empty() && top <= dirtyRows.back().bottom) {
+			dirtyRows.back().bottom = std::max(dirtyRows.back().bottom, bottom);
+		} else {
+			dirtyRows.push_back({ top, bottom });
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Redraws the given rows of the view, leaving the rest of it as drawn in the previous frame.
+ *
+ * Like DrawBands, every range of rows walks the whole tile grid and clips to its own rows.
+ */
+void DrawRows(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns, const std::vector<ViewRows> &dirtyRows)
+{
+	const auto drawRows = [&](unsigned i) {
+		const ViewRows &range = dirtyRows[i];
+		const Surface rangeOut = out.subregionY(range.top, range.bottom - range.top);
+		const Lightmap rangeLightmap = lightmap.subregionY(range.top);
+		const Point rangePosition = targetBufferPosition - Displacement { 0, range.top };
+		DrawFloor(rangeOut, rangeLightmap, tilePosition, rangePosition, rows, columns);
+		DrawTileContent(rangeOut, rangeLightmap, tilePosition, rangePosition, rows, columns, /*primaryBand=*/false);
+	};
+	if (UseRenderWorkers()) {
+		RenderWorkers->parallelFor(static_cast<unsigned>(dirtyRows.size()), drawRows);
+	} else {
+		for (unsigned i = 0; i < dirtyRows.size(); i++)
+			drawRows(i);
+	}
+}
+
+/**
+ * @brief Whether the game view is drawn to ViewCache and only redrawn where it changed.
+ */
+bool UsePartialRedraw()
+{
+	bool usable = *GetOptions().Graphics.partialRedraw
+	    && !*GetOptions().Graphics.zoom
+	    // Item labels are queued while drawing the items, so all of them have to be drawn every frame
+	    && !IsHighlightingLabelsEnabled();
+#ifdef DUN_RENDER_STATS
+	usable = false;
+#endif
+#ifdef _DEBUG
+	// The debug overlays rely on every tile being drawn every frame
+	usable = usable && !DebugPath && !DebugVision && !DebugGrid && !IsDebugGridTextNeeded();
+#endif
+	if (!usable) {
+		ViewCache = std::nullopt;
+		CachedViewState = std::nullopt;
+		return false;
+	}
+	if (!ViewCache || ViewCache->w() != gnScreenWidth || ViewCache->h() != gnViewportHeight) {
+		ViewCache.emplace(gnScreenWidth, gnViewportHeight);
+		CachedViewState = std::nullopt;
+	}
+	return true;
+}
+
 void CalcFirstTilePosition(Point &position, Displacement &offset)
 {
 	// Adjust by player offset and tile grid alignment
@@ -1083,8 +1475,9 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
  * @param fullOut Buffer to render to
  * @param position First tile of view in dPiece coordinate
  * @param offset Amount to offset the rendering in screen space
+ * @param partialRedraw Only redraw the rows with dirty tiles, `fullOut` holds the view of the previous frame
  */
-void DrawGame(const Surface &fullOut, Point position, Displacement offset)
+void DrawGame(const Surface &fullOut, Point position, Displacement offset, bool partialRedraw)
 {
 	// Limit rendering to the view area
 	const Surface &out = !*GetOptions().Graphics.zoom
@@ -1131,12 +1524,27 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	DunRenderStats.clear();
 #endif
 
+	UpdateDeadPlayerFlags();
+
+	std::vector<ViewRows> dirtyRows;
+	const bool drawDirtyRowsOnly = partialRedraw && CollectDirtyRows(position, offset, rows, columns, out.h(), dirtyRows);
+	if (partialRedraw)
+		ClearDirtyTiles();
+	if (drawDirtyRowsOnly && dirtyRows.empty())
+		return;
+
 	Lightmap lightmap = Lightmap::build(position, Point {} + offset,
 	    gnScreenWidth, gnViewportHeight, rows, columns,
 	    out.at(0, 0), out.pitch(), LightTables[0].data(), LightTables[0].size());
 
-	DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
+	if (drawDirtyRowsOnly) {
+		DrawRows(out, lightmap, position, Point {} + offset, rows, columns, dirtyRows);
+	} else if (UseRenderWorkers()) {
+		DrawBands(out, lightmap, position, Point {} + offset, rows, columns);
+	} else {
+		DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
+		DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns, /*primaryBand=*/true);
+	}
 
 	if (*GetOptions().Graphics.zoom) {
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
@@ -1173,7 +1581,12 @@ void DrawView(const Surface &out, Point startPosition)
 #endif
 	Displacement offset = {};
 	CalcFirstTilePosition(startPosition, offset);
-	DrawGame(out, startPosition, offset);
+	if (UsePartialRedraw()) {
+		DrawGame(*ViewCache, startPosition, offset, /*partialRedraw=*/true);
+		out.BlitFrom(*ViewCache, MakeSdlRect(0, 0, ViewCache->w(), ViewCache->h()), { 0, 0 });
+	} else {
+		DrawGame(out, startPosition, offset, /*partialRedraw=*/false);
+	}
 	if (AutomapActive) {
 		DrawAutomap(out.subregionY(0, gnViewportHeight));
 	}
@@ -1336,6 +1749,30 @@ void DrawFPS(const Surface &out)
 	DrawString(out, formatted, Point { 8, 68 }, { .flags = UiFlags::ColorRed });
 }
 
+/**
+ * @brief Display the per-phase tick timings below the FPS, refreshed every second
+ */
+void DrawTickProfile(const Surface &out)
+{
+	static uint32_t lastUpdateInMs = 0;
+	static std::vector<std::string> lines;
+
+	if (!TickProfilerEnabled || !gbActive) {
+		return;
+	}
+
+	const uint32_t runtimeInMs = SDL_GetTicks();
+	if (runtimeInMs - lastUpdateInMs >= 1000) {
+		lastUpdateInMs = runtimeInMs;
+		lines = FormatTickProfileSummary();
+	}
+	Point position { 8, 84 };
+	for (const std::string &line : lines) {
+		DrawString(out, line, position, { .flags = UiFlags::ColorRed | UiFlags::FontSize12 });
+		position.y += 14;
+	}
+}
+
 /**
  * @brief Update part of the screen from the back buffer
  */
@@ -1413,6 +1850,52 @@ void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSba
 	}
 }
 
+/** @brief The back buffer as of the previous blit, only kept while partial redraw is enabled. */
+std::vector<uint8_t> BlittedFrame;
+unsigned BlittedPaletteVersion;
+
+/**
+ * @brief Update the rows of the screen that changed since the previous frame from the back buffer
+ *
+ * Comparing against the previous frame also picks up everything drawn over the game view,
+ * such as panels, labels and the cursor, without having to track each of them.
+ * @param out The back buffer
+ * @param blitAll Update the whole screen
+ */
+void BlitChangedRows(const Surface &out, bool blitAll)
+{
+	if (!gbActive || RenderDirectlyToOutputSurface) {
+		return;
+	}
+
+	constexpr int RowsPerCheck = 8;
+	const size_t pitch = out.pitch();
+	const size_t frameSize = pitch * out.h();
+	if (BlittedFrame.size() != frameSize || BlittedPaletteVersion != pal_surface_palette_version) {
+		BlittedFrame.resize(frameSize);
+		BlittedPaletteVersion = pal_surface_palette_version;
+		blitAll = true;
+	}
+
+	int changedTop = -1;
+	for (int top = 0; top < out.h(); top += RowsPerCheck) {
+		const size_t size = pitch * std::min(RowsPerCheck, out.h() - top);
+		uint8_t *blitted = &BlittedFrame[pitch * top];
+		const uint8_t *current = out.at(0, top);
+		if (blitAll || memcmp(blitted, current, size) != 0) {
+			memcpy(blitted, current, size);
+			if (changedTop == -1)
+				changedTop = top;
+		} else if (changedTop != -1) {
+			DoBlitScreen({ { 0, changedTop }, { gnScreenWidth, top - changedTop } });
+			changedTop = -1;
+		}
+	}
+	if (changedTop != -1) {
+		DoBlitScreen({ { 0, changedTop }, { gnScreenWidth, out.h() - changedTop } });
+	}
+}
+
 void OptionShowFPSChanged()
 {
 	if (*GetOptions().Graphics.showFPS)
@@ -1751,10 +2234,16 @@ void DrawAndBlit()
 	DrawCursor(out);
 
 	DrawFPS(out);
+	DrawTickProfile(out);
 
 	LuaEvent("GameDrawComplete");
 
-	DrawMain(hgt, drawInfoBox, drawHealth, drawMana, drawBelt, drawControlButtons);
+	if (*GetOptions().Graphics.partialRedraw) {
+		BlitChangedRows(out, IsRedrawEverything());
+	} else {
+		BlittedFrame = {};
+		DrawMain(hgt, drawInfoBox, drawHealth, drawMana, drawBelt, drawControlButtons);
+	}
 
 #ifdef _DEBUG
 	DrawConsole(out);
@@ -10,8 +10,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <fmt/core.h>
@@ -151,12 +153,17 @@ uint32_t GetFontId(GameFontTables size, uint16_t row)
 	return (size << 16) | row;
 }
 
-OptionalClxSpriteList LoadFont(GameFontTables size, text_color color, uint16_t row)
+void LoadColorTranslation(text_color color)
 {
 	if (ColorTranslations[color] != nullptr && !ColorTranslationsData[color]) {
 		ColorTranslationsData[color].emplace();
 		LoadFileInMem(ColorTranslations[color], *ColorTranslationsData[color]);
 	}
+}
+
+OptionalClxSpriteList LoadFont(GameFontTables size, text_color color, uint16_t row)
+{
+	LoadColorTranslation(color);
 
 	const uint32_t fontId = GetFontId(size, row);
 	auto hotFont = Fonts.find(fontId);
@@ -228,6 +235,114 @@ private:
 	uint32_t currentUnicodeRow_ = 0;
 };
 
+struct ShapedGlyph {
+	ClxSprite sprite;
+	/** @brief The code point that is drawn, which is `?` if the font for the original one is missing. */
+	char32_t codepoint;
+	uint32_t byteOffset;
+	uint8_t byteLength;
+};
+
+/**
+ * @brief The glyphs of a string in one font size.
+ *
+ * Measuring or drawing the same string again uses these instead of decoding the UTF-8 and looking up the fonts.
+ * Zero-width spaces have no glyph. The sprites point into `Fonts`, so these are dropped whenever the fonts are.
+ */
+struct ShapedText {
+	std::string text;
+	std::vector<ShapedGlyph> glyphs;
+	/** @brief The length of `text` up to the first invalid UTF-8 sequence. */
+	uint32_t decodedBytes;
+};
+
+struct WrappedText {
+	std::string text;
+	std::string wrapped;
+};
+
+/**
+ * @brief The caches are cleared when they grow beyond this, e.g. from a lot of strings with changing numbers.
+ *
+ * Item labels, store lists and the chat log only need a few hundred entries.
+ */
+constexpr size_t MaxCachedTexts = 2048;
+
+ankerl::unordered_dense::map<uint64_t, ShapedText> ShapedTexts;
+ankerl::unordered_dense::map<uint64_t, WrappedText> WrappedTexts;
+
+uint64_t TextCacheKey(std::string_view text, uint64_t params)
+{
+	return ankerl::unordered_dense::hash<std::string_view> {}(text) ^ (params * 0x9E3779B97F4A7C15ULL);
+}
+
+template <typename Entry>
+Entry &FindOrAddCacheEntry(ankerl::unordered_dense::map<uint64_t, Entry> &cache, uint64_t key, std::string_view text, bool &found)
+{
+	const auto it = cache.find(key);
+	if (it != cache.end()) {
+		found = it->second.text == text;
+		return it->second;
+	}
+	found = false;
+	if (cache.size() >= MaxCachedTexts)
+		cache.clear();
+	return cache[key];
+}
+
+const ShapedText &ShapeText(std::string_view text, GameFontTables size)
+{
+	bool found;
+	ShapedText &shaped = FindOrAddCacheEntry(ShapedTexts, TextCacheKey(text, size), text, found);
+	if (found)
+		return shaped;
+
+	shaped.text.assign(text);
+	shaped.glyphs.clear();
+	CurrentFont currentFont;
+	std::string_view remaining = text;
+	char32_t next;
+	size_t cpLen;
+	for (; !remaining.empty() && (next = DecodeFirstUtf8CodePoint(remaining, &cpLen)) != Utf8DecodeError;
+	     remaining.remove_prefix(cpLen)) {
+		if (next == ZWSP)
+			continue;
+
+		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+			next = U'?';
+			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+				app_fatal("Missing fonts");
+			}
+		}
+
+		shaped.glyphs.push_back(ShapedGlyph {
+		    (*currentFont.sprite)[next & 0xFF],
+		    next,
+		    static_cast<uint32_t>(text.size() - remaining.size()),
+		    static_cast<uint8_t>(cpLen),
+		});
+	}
+	shaped.decodedBytes = static_cast<uint32_t>(text.size() - remaining.size());
+	return shaped;
+}
+
+/**
+ * @brief Measures the line that starts at the given glyph, see GetLineWidth.
+ */
+int GetShapedLineWidth(const std::vector<ShapedGlyph> &glyphs, size_t begin, int spacing, int *charactersInLine = nullptr)
+{
+	int lineWidth = 0;
+	uint32_t codepoints = 0;
+	for (size_t i = begin; i < glyphs.size() && glyphs[i].codepoint != U'\n'; ++i) {
+		lineWidth += glyphs[i].sprite.width() + spacing;
+		++codepoints;
+	}
+	if (charactersInLine != nullptr)
+		*charactersInLine = codepoints;
+
+	return lineWidth != 0 ? (lineWidth - spacing) : 0;
+}
+
 void DrawFont(const Surface &out, Point position, ClxSprite glyph, text_color color, bool outline)
 {
 	if (outline) {
@@ -403,22 +518,24 @@ uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect,
     int lineWidth, int charactersInLine, int rightMargin, int bottomMargin, GameFontTables size, text_color color, bool outline,
     TextRenderOptions &opts)
 {
-	CurrentFont currentFont;
+	LoadColorTranslation(color);
+	const ShapedText &shaped = ShapeText(text, size);
+	const std::vector<ShapedGlyph> &glyphs = shaped.glyphs;
+
 	int curSpacing = opts.spacing;
 	if (HasAnyOf(opts.flags, UiFlags::KerningFitSpacing)) {
 		curSpacing = AdjustSpacingToFitHorizontally(lineWidth, opts.spacing, charactersInLine, rect.size.width);
 		if (curSpacing != opts.spacing && HasAnyOf(opts.flags, UiFlags::AlignCenter | UiFlags::AlignRight)) {
-			const int adjustedLineWidth = GetLineWidth(text, size, curSpacing, &charactersInLine);
+			const int adjustedLineWidth = GetShapedLineWidth(glyphs, 0, curSpacing, &charactersInLine);
 			characterPosition.x = GetLineStartX(opts.flags, rect, adjustedLineWidth);
 		}
 	}
 
-	char32_t next;
-	std::string_view remaining = text;
-	size_t cpLen;
+	// The number of bytes of `text` before the current glyph.
+	size_t byteIndex = 0;
 
 	const auto maybeDrawCursor = [&]() {
-		if (opts.cursorPosition == static_cast<int>(text.size() - remaining.size())) {
+		if (opts.cursorPosition == static_cast<int>(byteIndex)) {
 			Point position = characterPosition;
 			MaybeWrap(position, 2, rightMargin, position.x, opts.lineHeight);
 			if (GetAnimationFrame(2, 500) != 0) {
@@ -432,23 +549,16 @@ uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect,
 		}
 	};
 
-	for (; !remaining.empty() && remaining[0] != '\0'
-	     && (next = DecodeFirstUtf8CodePoint(remaining, &cpLen)) != Utf8DecodeError;
-	     remaining.remove_prefix(cpLen)) {
-		if (next == ZWSP)
-			continue;
-
-		if (!currentFont.load(size, color, next)) {
-			next = U'?';
-			if (!currentFont.load(size, color, next)) {
-				app_fatal("Missing fonts");
-			}
-		}
+	size_t i = 0;
+	for (; i < glyphs.size(); ++i) {
+		const ShapedGlyph &glyph = glyphs[i];
+		byteIndex = glyph.byteOffset;
+		if (glyph.codepoint == U'\0')
+			break;
 
-		const uint8_t frame = next & 0xFF;
-		const uint16_t width = (*currentFont.sprite)[frame].width();
-		if (next == U'\n' || characterPosition.x + width > rightMargin) {
-			if (next == '\n')
+		const uint16_t width = glyph.sprite.width();
+		if (glyph.codepoint == U'\n' || characterPosition.x + width > rightMargin) {
+			if (glyph.codepoint == U'\n')
 				maybeDrawCursor();
 			const int nextLineY = characterPosition.y + opts.lineHeight;
 			if (nextLineY >= bottomMargin)
@@ -456,38 +566,37 @@ uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect,
 			characterPosition.y = nextLineY;
 
 			if (HasAnyOf(opts.flags, UiFlags::KerningFitSpacing)) {
-				int nextLineWidth = GetLineWidth(remaining.substr(cpLen), size, opts.spacing, &charactersInLine);
+				int nextLineWidth = GetShapedLineWidth(glyphs, i + 1, opts.spacing, &charactersInLine);
 				curSpacing = AdjustSpacingToFitHorizontally(nextLineWidth, opts.spacing, charactersInLine, rect.size.width);
 			}
 
 			if (HasAnyOf(opts.flags, UiFlags::AlignCenter | UiFlags::AlignRight)) {
 				lineWidth = width;
-				if (remaining.size() > cpLen)
-					lineWidth += curSpacing + GetLineWidth(remaining.substr(cpLen), size, curSpacing);
+				if (text.size() > byteIndex + glyph.byteLength)
+					lineWidth += curSpacing + GetShapedLineWidth(glyphs, i + 1, curSpacing);
 			}
 			characterPosition.x = GetLineStartX(opts.flags, rect, lineWidth);
 
-			if (next == U'\n')
+			if (glyph.codepoint == U'\n')
 				continue;
 		}
 
-		const ClxSprite glyph = (*currentFont.sprite)[frame];
-		const auto byteIndex = static_cast<int>(text.size() - remaining.size());
-
 		// Draw highlight
-		if (byteIndex >= opts.highlightRange.begin && byteIndex < opts.highlightRange.end) {
-			const bool lastInRange = static_cast<int>(byteIndex + cpLen) == opts.highlightRange.end;
+		if (static_cast<int>(byteIndex) >= opts.highlightRange.begin && static_cast<int>(byteIndex) < opts.highlightRange.end) {
+			const bool lastInRange = static_cast<int>(byteIndex + glyph.byteLength) == opts.highlightRange.end;
 			FillRect(out, characterPosition.x, characterPosition.y,
-			    glyph.width() + (lastInRange ? 0 : curSpacing), glyph.height(),
+			    glyph.sprite.width() + (lastInRange ? 0 : curSpacing), glyph.sprite.height(),
 			    opts.highlightColor);
 		}
 
-		DrawFont(out, characterPosition, glyph, color, outline);
+		DrawFont(out, characterPosition, glyph.sprite, color, outline);
 		maybeDrawCursor();
 		characterPosition.x += width + curSpacing;
 	}
+	if (i == glyphs.size())
+		byteIndex = shaped.decodedBytes;
 	maybeDrawCursor();
-	return static_cast<uint32_t>(remaining.data() - text.data());
+	return static_cast<uint32_t>(byteIndex);
 }
 
 void OptionLanguageCodeChanged()
@@ -508,40 +617,14 @@ void LoadSmallSelectionSpinner()
 
 void UnloadFonts()
 {
+	ShapedTexts.clear();
+	WrappedTexts.clear();
 	Fonts.clear();
 }
 
 int GetLineWidth(std::string_view text, GameFontTables size, int spacing, int *charactersInLine)
 {
-	int lineWidth = 0;
-	CurrentFont currentFont;
-	uint32_t codepoints = 0;
-	char32_t next;
-	while (!text.empty()) {
-		next = ConsumeFirstUtf8CodePoint(&text);
-		if (next == Utf8DecodeError)
-			break;
-		if (next == ZWSP)
-			continue;
-
-		if (next == U'\n')
-			break;
-
-		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-			next = U'?';
-			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-				app_fatal("Missing fonts");
-			}
-		}
-
-		const uint8_t frame = next & 0xFF;
-		lineWidth += (*currentFont.sprite)[frame].width() + spacing;
-		++codepoints;
-	}
-	if (charactersInLine != nullptr)
-		*charactersInLine = codepoints;
-
-	return lineWidth != 0 ? (lineWidth - spacing) : 0;
+	return GetShapedLineWidth(ShapeText(text, size).glyphs, 0, spacing, charactersInLine);
 }
 
 bool IsConsumed(std::string_view s) { return s.empty() || s[0] == '\0'; };
@@ -623,7 +706,9 @@ int GetLineHeight(std::string_view text, GameFontTables fontIndex)
 	return LineHeights[fontIndex];
 }
 
-std::string WordWrapString(std::string_view text, unsigned width, GameFontTables size, int spacing)
+namespace {
+
+std::string DoWordWrapString(std::string_view text, unsigned width, GameFontTables size, int spacing)
 {
 	std::string output;
 	if (text.empty() || text[0] == '\0')
@@ -706,6 +791,20 @@ std::string WordWrapString(std::string_view text, unsigned width, GameFontTables
 	return output;
 }
 
+} // namespace
+
+std::string WordWrapString(std::string_view text, unsigned width, GameFontTables size, int spacing)
+{
+	const uint64_t params = (static_cast<uint64_t>(width) << 32) | (static_cast<uint64_t>(static_cast<uint16_t>(spacing)) << 16) | size;
+	bool found;
+	WrappedText &entry = FindOrAddCacheEntry(WrappedTexts, TextCacheKey(text, params), text, found);
+	if (!found) {
+		entry.text.assign(text);
+		entry.wrapped = DoWordWrapString(text, width, size, spacing);
+	}
+	return entry.wrapped;
+}
+
 /**
  * @todo replace Rectangle with cropped Surface
  */
@@ -0,0 +1,210 @@
+#include "engine/tick_profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+
+#include <fmt/format.h>
+
+#include "utils/enum_traits.h"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+bool TickProfilerEnabled;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::array<TickHistogram, enum_size<GameLogicStep>::value> PhaseHistograms;
+TickHistogram NetworkLatencyHistogram;
+GameLogicStep CurrentStep = GameLogicStep::None;
+Clock::time_point StepStart;
+Clock::time_point TickStart;
+
+uint64_t NanosecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::string FormatDuration(uint64_t nanoseconds)
+{
+	if (nanoseconds >= 1000000)
+		return fmt::format("{:.1f}ms", nanoseconds / 1000000.0);
+	return fmt::format("{}us", nanoseconds / 1000);
+}
+
+std::string FormatSummaryLine(std::string_view name, const TickHistogram &histogram)
+{
+	return StrCat(name,
+	    " p50 ", FormatDuration(histogram.percentile(50)),
+	    " p95 ", FormatDuration(histogram.percentile(95)),
+	    " p99 ", FormatDuration(histogram.percentile(99)),
+	    " max ", FormatDuration(histogram.max()));
+}
+
+void WriteCsvLine(FILE *file, std::string_view name, const TickHistogram &histogram)
+{
+	const std::string line = fmt::format("{},{},{},{},{},{}\n", name, histogram.count(),
+	    histogram.percentile(50), histogram.percentile(95), histogram.percentile(99), histogram.max());
+	std::fputs(line.c_str(), file);
+}
+
+} // namespace
+
+size_t TickHistogram::bucketIndex(uint64_t nanoseconds)
+{
+	if (nanoseconds < SubBucketCount)
+		return static_cast<size_t>(nanoseconds);
+	const unsigned msb = static_cast<unsigned>(std::bit_width(nanoseconds)) - 1;
+	const unsigned shift = msb - SubBucketBits;
+	const size_t subBucket = static_cast<size_t>((nanoseconds >> shift) & (SubBucketCount - 1));
+	return ((shift + 1) << SubBucketBits) | subBucket;
+}
+
+uint64_t TickHistogram::bucketUpperBound(size_t index)
+{
+	if (index < SubBucketCount)
+		return index;
+	const unsigned shift = static_cast<unsigned>(index >> SubBucketBits) - 1;
+	const uint64_t lowerBound = (SubBucketCount + (index & (SubBucketCount - 1))) << shift;
+	return lowerBound + (uint64_t { 1 } << shift) - 1;
+}
+
+void TickHistogram::add(uint64_t nanoseconds)
+{
+	buckets_[bucketIndex(nanoseconds)]++;
+	count_++;
+	max_ = std::max(max_, nanoseconds);
+}
+
+void TickHistogram::clear()
+{
+	buckets_.fill(0);
+	count_ = 0;
+	max_ = 0;
+}
+
+uint64_t TickHistogram::percentile(float percentile) const
+{
+	if (count_ == 0)
+		return 0;
+	const auto target = static_cast<uint64_t>(count_ * static_cast<double>(percentile) / 100.0 + 0.5);
+	uint64_t seen = 0;
+	for (size_t i = 0; i < buckets_.size(); i++) {
+		seen += buckets_[i];
+		if (seen >= std::max<uint64_t>(target, 1))
+			return std::min(bucketUpperBound(i), max_);
+	}
+	return max_;
+}
+
+void TickProfilerEnterStep(GameLogicStep step)
+{
+	if (step == CurrentStep)
+		return;
+	const Clock::time_point now = Clock::now();
+	if (CurrentStep == GameLogicStep::None) {
+		TickStart = now;
+	} else {
+		PhaseHistograms[static_cast<size_t>(CurrentStep)].add(NanosecondsBetween(StepStart, now));
+		if (step == GameLogicStep::None)
+			PhaseHistograms[static_cast<size_t>(GameLogicStep::None)].add(NanosecondsBetween(TickStart, now));
+	}
+	CurrentStep = step;
+	StepStart = now;
+}
+
+void TickProfilerRecordNetworkLatency(uint64_t nanoseconds)
+{
+	NetworkLatencyHistogram.add(nanoseconds);
+}
+
+void TickProfilerReset()
+{
+	for (TickHistogram &histogram : PhaseHistograms)
+		histogram.clear();
+	NetworkLatencyHistogram.clear();
+	CurrentStep = GameLogicStep::None;
+}
+
+const TickHistogram &GetTickProfile(GameLogicStep step)
+{
+	return PhaseHistograms[static_cast<size_t>(step)];
+}
+
+const TickHistogram &GetNetworkLatencyProfile()
+{
+	return NetworkLatencyHistogram;
+}
+
+std::string_view TickProfilePhaseName(GameLogicStep step)
+{
+	switch (step) {
+	case GameLogicStep::None:
+		return "Tick";
+	case GameLogicStep::ProcessPlayers:
+		return "Players";
+	case GameLogicStep::ProcessMonsters:
+		return "Monsters";
+	case GameLogicStep::ProcessObjects:
+		return "Objects";
+	case GameLogicStep::ProcessMissiles:
+		return "Missiles";
+	case GameLogicStep::ProcessItems:
+		return "Items";
+	case GameLogicStep::ProcessLightList:
+		return "Lights";
+	case GameLogicStep::ProcessVisionList:
+		return "Vision";
+	case GameLogicStep::ProcessTowners:
+		return "Towners";
+	case GameLogicStep::ProcessItemsTown:
+		return "ItemsTown";
+	case GameLogicStep::ProcessMissilesTown:
+		return "MissilesTown";
+	}
+	return "Unknown";
+}
+
+std::vector<std::string> FormatTickProfileSummary()
+{
+	std::vector<std::string> lines;
+	for (const GameLogicStep step : enum_values<GameLogicStep>()) {
+		const TickHistogram &histogram = GetTickProfile(step);
+		if (histogram.count() == 0)
+			continue;
+		lines.push_back(FormatSummaryLine(TickProfilePhaseName(step), histogram));
+	}
+	if (NetworkLatencyHistogram.count() != 0)
+		lines.push_back(FormatSummaryLine("NetQueue", NetworkLatencyHistogram));
+	return lines;
+}
+
+void WriteTickProfileCsv()
+{
+	const std::string path = StrCat(paths::PrefPath(), "tick_profile.csv");
+	FILE *file = OpenFile(path.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to open {} for writing", path);
+		return;
+	}
+	std::fputs("phase,count,p50_ns,p95_ns,p99_ns,max_ns\n", file);
+	for (const GameLogicStep step : enum_values<GameLogicStep>()) {
+		const TickHistogram &histogram = GetTickProfile(step);
+		if (histogram.count() == 0)
+			continue;
+		WriteCsvLine(file, TickProfilePhaseName(step), histogram);
+	}
+	if (NetworkLatencyHistogram.count() != 0)
+		WriteCsvLine(file, "NetQueue", NetworkLatencyHistogram);
+	std::fclose(file);
+	Log("Tick profile written to {}", path);
+}
+
+} // namespace devilution
@@ -0,0 +1,88 @@
+/**
+ * @file tick_profiler.hpp
+ *
+ * Built-in per-phase timing of GameLogic() ticks.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "diablo.h"
+
+namespace devilution {
+
+/**
+ * @brief Log-linear histogram of durations in nanoseconds.
+ *
+ * Each power of two is split into 8 linear sub-buckets, so percentiles are accurate to within 12.5%.
+ */
+class TickHistogram {
+public:
+	void add(uint64_t nanoseconds);
+	void clear();
+
+	[[nodiscard]] uint32_t count() const
+	{
+		return count_;
+	}
+
+	[[nodiscard]] uint64_t max() const
+	{
+		return max_;
+	}
+
+	/**
+	 * @brief Returns the upper bound of the bucket containing the given percentile.
+	 * @param percentile Value in the range [0, 100].
+	 */
+	[[nodiscard]] uint64_t percentile(float percentile) const;
+
+private:
+	static constexpr unsigned SubBucketBits = 3;
+	static constexpr unsigned SubBucketCount = 1U << SubBucketBits;
+
+	static size_t bucketIndex(uint64_t nanoseconds);
+	static uint64_t bucketUpperBound(size_t index);
+
+	std::array<uint32_t, 64 * SubBucketCount> buckets_ {};
+	uint32_t count_ = 0;
+	uint64_t max_ = 0;
+};
+
+/** @brief Whether GameLogic() phases are being timed, enabled with `--tick-profile`. */
+extern bool TickProfilerEnabled;
+
+/**
+ * @brief Closes the timing of the current phase and starts timing the given one.
+ *
+ * Switching to GameLogicStep::None ends the tick.
+ */
+void TickProfilerEnterStep(GameLogicStep step);
+
+/** @brief Records how long a network message waited between being read from the network and being dispatched. */
+void TickProfilerRecordNetworkLatency(uint64_t nanoseconds);
+
+/** @brief Discards all recorded timings. */
+void TickProfilerReset();
+
+/** @brief Histogram of the given phase, GameLogicStep::None holds whole ticks. */
+const TickHistogram &GetTickProfile(GameLogicStep step);
+
+/** @brief Histogram of network message queueing delays. */
+const TickHistogram &GetNetworkLatencyProfile();
+
+/** @brief Human readable name of the given phase, GameLogicStep::None is the whole tick. */
+std::string_view TickProfilePhaseName(GameLogicStep step);
+
+/** @brief One line per recorded phase for the on-screen overlay. */
+std::vector<std::string> FormatTickProfileSummary();
+
+/** @brief Writes p50/p95/p99/max of every phase to `tick_profile.csv` in the save folder. */
+void WriteTickProfileCsv();
+
+} // namespace devilution
@@ -33,7 +33,7 @@ ItemScoreBreakdown GearScorer::CalculateDetailedItemScore(const Item &item)
     const GearScoringConfig &config = GearConfigLoader::GetConfig();
     
     // Calculate level factor
-    breakdown.levelFactor = std::min(config.levelFactorBase + (item._iILvl * config.levelFactorMultiplier), config.levelFactorMax);
+    breakdown.levelFactor = std::min(config.levelFactorBase + ((item._iCreateInfo & CF_LEVEL) * config.levelFactorMultiplier), config.levelFactorMax);
     
     // Calculate total score using base formula
     // Formula: (base_score + affix_score) * level_factor
@@ -69,17 +69,32 @@ float GearScorer::CalculateItemScore(const Item &item)
 
 float GearScorer::CalculateGearLevel(const Player &player)
 {
-    float totalWeightedScore = 0.0f;
-    float totalWeight = 0.0f;
-    
     // Calculate score for each equipped item
+    std::array<std::optional<float>, NUM_INVLOC> itemScores;
     for (int i = 0; i < NUM_INVLOC; i++) {
         const Item &item = player.InvBody[i];
         if (!item.isEmpty()) {
-            float itemScore = CalculateItemScore(item);
+            itemScores[i] = CalculateItemScore(item);
+        }
+    }
+    
+    float gearLevel = CalculateGearLevel(itemScores, player.getCharacterLevel());
+    
+    LogVerbose("Player '{}' gear level: {:.2f}", player._pName, gearLevel);
+    
+    return gearLevel;
+}
+
+float GearScorer::CalculateGearLevel(const std::array<std::optional<float>, NUM_INVLOC> &itemScores, int characterLevel)
+{
+    float totalWeightedScore = 0.0f;
+    float totalWeight = 0.0f;
+    
+    for (int i = 0; i < NUM_INVLOC; i++) {
+        if (itemScores[i]) {
             float slotWeight = SlotImportance[i];
             
-            totalWeightedScore += itemScore * slotWeight;
+            totalWeightedScore += *itemScores[i] * slotWeight;
             totalWeight += slotWeight;
         }
     }
@@ -91,18 +106,13 @@ float GearScorer::CalculateGearLevel(const Player &player)
     const GearScoringConfig &config = GearConfigLoader::GetConfig();
     
     // Factor in character level with diminishing returns
-    float levelFactor = std::sqrt(static_cast<float>(player._pLevel)) * config.characterLevelWeight;
+    float levelFactor = std::sqrt(static_cast<float>(characterLevel)) * config.characterLevelWeight;
     
     // Calculate final gear level
     float gearLevel = (gearScore * config.gearScoreWeight) + levelFactor;
     
     // Normalize to the configured range
-    gearLevel = NormalizeScore(gearLevel, config.minGearLevel, config.maxGearLevel);
-    
-    LogVerbose("Player '{}' gear level: {:.2f} (gear score: {:.2f}, level factor: {:.2f})",
-        player._pName, gearLevel, gearScore, levelFactor);
-    
-    return gearLevel;
+    return NormalizeScore(gearLevel, config.minGearLevel, config.maxGearLevel);
 }
 
 std::string GearScorer::GetScoreExplanation(const Item &item)
@@ -118,7 +128,7 @@ std::string GearScorer::GetScoreExplanation(const Item &item)
     explanation << "- Base score: " << breakdown.baseScore << " (Quality: " << GetGearQualityName(GetGearQuality(item._iMagical)) 
                 << ", Category: " << GetGearCategoryName(GetGearCategory(item)) << ")\n";
     explanation << "- Affix score: " << breakdown.affixScore << "\n";
-    explanation << "- Level factor: " << breakdown.levelFactor << " (Item level: " << item._iILvl << ")\n";
+    explanation << "- Level factor: " << breakdown.levelFactor << " (Item level: " << (item._iCreateInfo & CF_LEVEL) << ")\n";
     
     // Get configuration
     const GearScoringConfig &config = GearConfigLoader::GetConfig();
@@ -5,7 +5,9 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -58,6 +60,14 @@ public:
      */
     static float CalculateGearLevel(const Player &player);
     
+    /**
+     * @brief Calculates the gear level from item scores that were already calculated
+     * @param itemScores The score of the item in each body slot, empty for empty slots
+     * @param characterLevel The character level of the player
+     * @return The calculated gear level
+     */
+    static float CalculateGearLevel(const std::array<std::optional<float>, NUM_INVLOC> &itemScores, int characterLevel);
+    
     /**
      * @brief Gets a text explanation of an item's score
      * @param item The item to explain
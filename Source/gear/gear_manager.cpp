@@ -31,7 +31,9 @@ void GearLevelManager::Initialize()
     GearConfigLoader::LoadFromFile("gear_config.json");
     
     // Clear any existing cache
-    gearLevelCache.clear();
+    playerCaches = {};
+    candidateScores = {};
+    nextCandidateScore = 0;
     
     initialized = true;
     LogVerbose("Gear Level Manager initialized");
@@ -39,37 +41,34 @@ void GearLevelManager::Initialize()
 
 float GearLevelManager::GetCurrentGearLevel(const Player &player)
 {
-    // Check cache first
-    uint8_t playerId = player.getId();
-    auto it = gearLevelCache.find(playerId);
-    if (it != gearLevelCache.end()) {
-        return it->second;
+    // Check cache first, it is only outdated after a change notification for the player
+    PlayerGearCache &cache = playerCaches[player.getId()];
+    if (cache.hasGearLevel && cache.gearLevelGeneration == cache.generation) {
+        return cache.gearLevel;
     }
     
-    // Calculate gear level
-    float gearLevel = CalculateGearLevel(player);
+    // Only the items that changed since the last calculation are scored again
+    GetUpdatedCache(player);
+    cache.gearLevel = GearScorer::CalculateGearLevel(cache.slotScores, player.getCharacterLevel());
+    cache.gearLevelGeneration = cache.generation;
+    cache.hasGearLevel = true;
     
-    // Cache the result
-    gearLevelCache[playerId] = gearLevel;
+    LogVerbose("Player '{}' gear level: {:.2f}", player._pName, cache.gearLevel);
     
-    return gearLevel;
+    return cache.gearLevel;
 }
 
 float GearLevelManager::GetPotentialGearLevel(const Player &player, const Item &newItem, inv_body_loc slot)
 {
-    // Create a copy of the player to simulate the equipment change
-    Player simulatedPlayer = player;
-    
-    // Store the old item
-    Item oldItem = simulatedPlayer.InvBody[slot];
-    
-    // Equip the new item
-    simulatedPlayer.InvBody[slot] = newItem;
-    
-    // Calculate the new gear level
-    float potentialGearLevel = CalculateGearLevel(simulatedPlayer);
+    // Reuse the scores of the other equipped items, only the simulated slot changes
+    std::array<std::optional<float>, NUM_INVLOC> itemScores = GetUpdatedCache(player).slotScores;
+    if (newItem.isEmpty()) {
+        itemScores[slot] = std::nullopt;
+    } else {
+        itemScores[slot] = GetCandidateScore(newItem);
+    }
     
-    return potentialGearLevel;
+    return GearScorer::CalculateGearLevel(itemScores, player.getCharacterLevel());
 }
 
 float GearLevelManager::CompareItems(const Player &player, const Item &item1, const Item &item2, inv_body_loc slot)
@@ -152,10 +151,10 @@ std::string GearLevelManager::GetGearLevelExplanation(const Player &player)
     const GearScoringConfig &config = GearConfigLoader::GetConfig();
     
     // Factor in character level
-    float levelFactor = std::sqrt(static_cast<float>(player._pLevel)) * config.characterLevelWeight;
+    float levelFactor = std::sqrt(static_cast<float>(player.getCharacterLevel())) * config.characterLevelWeight;
     
     explanation << "\nGear Score: " << gearScore << " (Weighted average of item scores)\n";
-    explanation << "Character Level Factor: " << levelFactor << " (Based on level " << player._pLevel << ")\n";
+    explanation << "Character Level Factor: " << levelFactor << " (Based on level " << player.getCharacterLevel() << ")\n";
     explanation << "Gear Level: " << gearLevel << " (Gear Score + Level Factor, normalized)\n";
     
     // Add difficulty interpretation
@@ -183,7 +182,9 @@ std::string GearLevelManager::GetGearLevelExplanation(const Player &player)
 void GearLevelManager::InvalidateCache(const Player &player)
 {
     uint8_t playerId = player.getId();
-    gearLevelCache.erase(playerId);
+    PlayerGearCache &cache = playerCaches[playerId];
+    cache.generation++;
+    cache.hasSlotScore = {};
     LogVerbose("Invalidated gear level cache for player {}", playerId);
 }
 
@@ -209,8 +210,8 @@ void GearLevelManager::OnItemEquipped(Player &player, const Item &item, inv_body
     // Get old gear level
     float oldGearLevel = GetCurrentGearLevel(player);
     
-    // Invalidate cache
-    InvalidateCache(player);
+    // Invalidate the gear level and the score of the slot
+    BumpGeneration(player, slot);
     
     // Get new gear level
     float newGearLevel = GetCurrentGearLevel(player);
@@ -232,8 +233,8 @@ void GearLevelManager::OnItemUnequipped(Player &player, inv_body_loc slot)
     // Get old gear level
     float oldGearLevel = GetCurrentGearLevel(player);
     
-    // Invalidate cache
-    InvalidateCache(player);
+    // Invalidate the gear level and the score of the slot
+    BumpGeneration(player, slot);
     
     // Get new gear level
     float newGearLevel = GetCurrentGearLevel(player);
@@ -255,8 +256,8 @@ void GearLevelManager::OnPlayerLevelUp(Player &player)
     // Get old gear level
     float oldGearLevel = GetCurrentGearLevel(player);
     
-    // Invalidate cache
-    InvalidateCache(player);
+    // Invalidate the gear level, item scores don't depend on the character level
+    BumpGeneration(player, std::nullopt);
     
     // Get new gear level
     float newGearLevel = GetCurrentGearLevel(player);
@@ -273,10 +274,62 @@ void GearLevelManager::OnPlayerLevelUp(Player &player)
     FireChangeEvent(event);
 }
 
-float GearLevelManager::CalculateGearLevel(const Player &player)
+GearLevelManager::ItemScoreKey GearLevelManager::ItemScoreKey::FromItem(const Item &item)
+{
+    ItemScoreKey key;
+    key.seed = item._iSeed;
+    key.createInfo = item._iCreateInfo;
+    key.idx = item.IDidx;
+    key.durability = item._iDurability;
+    key.maxDurability = item._iMaxDur;
+    key.minDamage = item._iMinDam;
+    key.maxDamage = item._iMaxDam;
+    key.armorClass = item._iAC;
+    return key;
+}
+
+GearLevelManager::PlayerGearCache &GearLevelManager::GetUpdatedCache(const Player &player)
+{
+    PlayerGearCache &cache = playerCaches[player.getId()];
+    for (int i = 0; i < NUM_INVLOC; i++) {
+        const Item &item = player.InvBody[i];
+        ItemScoreKey key = ItemScoreKey::FromItem(item);
+        if (cache.hasSlotScore[i] && cache.slotKeys[i] == key) {
+            continue;
+        }
+        
+        // Use the composite scoring system
+        cache.slotKeys[i] = key;
+        cache.slotScores[i] = item.isEmpty() ? std::nullopt : std::optional<float>(GearScorer::CalculateItemScore(item));
+        cache.hasSlotScore[i] = true;
+    }
+    return cache;
+}
+
+float GearLevelManager::GetCandidateScore(const Item &item)
+{
+    ItemScoreKey key = ItemScoreKey::FromItem(item);
+    for (const CandidateScore &candidate : candidateScores) {
+        if (candidate.valid && candidate.key == key) {
+            return candidate.score;
+        }
+    }
+    
+    CandidateScore &candidate = candidateScores[nextCandidateScore];
+    nextCandidateScore = (nextCandidateScore + 1) % CandidateScoreCount;
+    candidate.key = key;
+    candidate.score = GearScorer::CalculateItemScore(item);
+    candidate.valid = true;
+    return candidate.score;
+}
+
+void GearLevelManager::BumpGeneration(const Player &player, std::optional<inv_body_loc> slot)
 {
-    // Use the composite scoring system
-    return GearScorer::CalculateGearLevel(player);
+    PlayerGearCache &cache = playerCaches[player.getId()];
+    cache.generation++;
+    if (slot) {
+        cache.hasSlotScore[*slot] = false;
+    }
 }
 
 void GearLevelManager::FireChangeEvent(const GearLevelChangeEvent &event)
@@ -5,6 +5,8 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
 #include <functional>
@@ -12,6 +14,7 @@
 
 #include "player.h"
 #include "items.h"
+#include "multi.h"
 #include "gear/composite_score.h"
 
 namespace devilution {
@@ -94,7 +97,7 @@ public:
     std::string GetGearLevelExplanation(const Player &player);
     
     /**
-     * @brief Invalidates the cached gear level for a player
+     * @brief Invalidates the cached gear level and item scores for a player
      * @param player The player to invalidate
      */
     void InvalidateCache(const Player &player);
@@ -142,11 +145,69 @@ private:
     GearLevelManager& operator=(const GearLevelManager&) = delete;
     
     /**
-     * @brief Calculates the gear level for a player
-     * @param player The player to calculate for
-     * @return The calculated gear level
+     * @brief The properties of an item that its score depends on
+     *
+     * The seed, index and creation info identify the item, the other fields can change while it is equipped.
+     */
+    struct ItemScoreKey {
+        uint32_t seed = 0;
+        uint16_t createInfo = 0;
+        _item_indexes idx = IDI_NONE;
+        int durability = 0;
+        int maxDurability = 0;
+        uint8_t minDamage = 0;
+        uint8_t maxDamage = 0;
+        int16_t armorClass = 0;
+        
+        static ItemScoreKey FromItem(const Item &item);
+        
+        bool operator==(const ItemScoreKey &other) const = default;
+    };
+    
+    /**
+     * @brief Cached gear level of a player and the scores of their equipped items
      */
-    float CalculateGearLevel(const Player &player);
+    struct PlayerGearCache {
+        uint32_t generation = 0;             // Bumped whenever the equipment or level of the player changes
+        uint32_t gearLevelGeneration = 0;    // The generation gearLevel was calculated for
+        bool hasGearLevel = false;
+        float gearLevel = 0.0f;
+        std::array<bool, NUM_INVLOC> hasSlotScore {};
+        std::array<ItemScoreKey, NUM_INVLOC> slotKeys {};
+        std::array<std::optional<float>, NUM_INVLOC> slotScores {}; // Empty for empty slots
+    };
+    
+    /**
+     * @brief Recently scored items that are not equipped, e.g. the ones hovered in the stash or a store
+     */
+    struct CandidateScore {
+        ItemScoreKey key;
+        float score = 0.0f;
+        bool valid = false;
+    };
+    
+    static constexpr size_t CandidateScoreCount = 8;
+    
+    /**
+     * @brief Gets the cache of a player, whose slot scores are up to date with the items they have equipped
+     * @param player The player to get the cache for
+     * @return The cache of the player
+     */
+    PlayerGearCache &GetUpdatedCache(const Player &player);
+    
+    /**
+     * @brief Gets the score of an item that is not equipped, reusing the score of recently scored items
+     * @param item The item to score
+     * @return The score of the item
+     */
+    float GetCandidateScore(const Item &item);
+    
+    /**
+     * @brief Marks the cached gear level of a player as outdated, and the score of a slot if it changed
+     * @param player The player whose gear changed
+     * @param slot The slot that changed, if any
+     */
+    void BumpGeneration(const Player &player, std::optional<inv_body_loc> slot);
     
     /**
      * @brief Fires a gear level change event
@@ -154,8 +215,12 @@ private:
      */
     void FireChangeEvent(const GearLevelChangeEvent &event);
     
-    // Cache of gear levels by player ID
-    std::unordered_map<uint8_t, float> gearLevelCache;
+    // Cache of gear levels and item scores by player ID
+    std::array<PlayerGearCache, MAX_PLRS> playerCaches;
+    
+    // Round-robin cache of the scores of items that are not equipped
+    std::array<CandidateScore, CandidateScoreCount> candidateScores;
+    size_t nextCandidateScore = 0;
     
     // Callbacks for gear level changes
     std::unordered_map<uint32_t, GearLevelChangeCallback> changeCallbacks;
@@ -115,18 +115,12 @@ float CalculateItemBaseScore(const Item &item)
     }
     
     // Factor in item level
-    float levelFactor = std::min(config.levelFactorBase + (item._iILvl * config.levelFactorMultiplier), config.levelFactorMax);
+    float levelFactor = std::min(config.levelFactorBase + ((item._iCreateInfo & CF_LEVEL) * config.levelFactorMultiplier), config.levelFactorMax);
     baseScore *= levelFactor;
     
     return baseScore;
 }
 
-float CalculateItemAffixScore(const Item &item)
-{
-    // Use the specialized affix scoring system from affix_score.cpp
-    return devilution::CalculateItemAffixScore(item);
-}
-
 float CalculateItemScore(const Item &item)
 {
     // Use the composite scoring system
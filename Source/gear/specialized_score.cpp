@@ -89,17 +89,17 @@ float WeaponScorer::CalculateElementalDamageValue(const Item &item) const
     float elementalScore = 0.0f;
     
     // Check for fire damage
-    if (item._iFlags & ISPL_FIREDAM) {
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::FireDamage)) {
         elementalScore += 5.0f;
     }
     
     // Check for lightning damage
-    if (item._iFlags & ISPL_LIGHTDAM) {
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::LightningDamage)) {
         elementalScore += 5.0f;
     }
     
-    // Check for magic damage (approximated)
-    if (item._iFlags & ISPL_ALLRUNES) {
+    // Check for elemental arrows
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::FireArrows | ItemSpecialEffect::LightningArrows)) {
         elementalScore += 5.0f;
     }
     
@@ -367,13 +367,13 @@ float JewelryScorer::CalculateProcChancesValue(const Item &item) const
     }
     
     // Check for special flags that might indicate procs
-    if (item._iFlags & ISPL_FIREDAM) {
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::FireDamage)) {
         procScore += 3.0f; // Fire damage proc
     }
-    if (item._iFlags & ISPL_LIGHTDAM) {
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::LightningDamage)) {
         procScore += 3.0f; // Lightning damage proc
     }
-    if (item._iFlags & ISPL_THORNS) {
+    if (HasAnyOf(item._iFlags, ItemSpecialEffect::Thorns)) {
         procScore += 4.0f; // Thorns effect
     }
     
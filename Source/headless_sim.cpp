@@ -0,0 +1,188 @@
+/**
+ * @file headless_sim.cpp
+ *
+ * Entry point of devilutionx-sim, which replays a demo recording through GameLogic()
+ * without a window, renderer or audio, as fast as the CPU allows.
+ */
+#include <cstdint>
+#include <string_view>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "appfat.h"
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "engine/demomode.h"
+#include "engine/sound.h"
+#include "engine/tick_profiler.hpp"
+#include "game_mode.hpp"
+#include "headless_mode.hpp"
+#include "init.h"
+#include "itemdat.h"
+#include "loadsave.h"
+#include "lua/lua.hpp"
+#include "misdat.h"
+#include "monstdat.h"
+#include "objdat.h"
+#include "options.h"
+#include "pack.h"
+#include "pfile.h"
+#include "playerdat.hpp"
+#include "spelldat.h"
+#include "utils/console.h"
+#include "utils/display.h"
+#include "utils/parse_int.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+bool DummyGetHeroInfo(_uiheroinfo * /*pInfo*/)
+{
+	return true;
+}
+
+[[noreturn]] void PrintUsageAndExit(int exitStatus)
+{
+	printInConsole("Usage: devilutionx-sim [--data-dir <dir>] [--save-dir <dir>] [--demo <#>] [--tick-profile] [--spawn|--diablo|--hellfire]\n");
+	printInConsole("Replays demo_<#>.dmo from the save folder without rendering and reports the logic throughput.\n");
+	diablo_quit(exitStatus);
+}
+
+/**
+ * @brief FNV-1a hash of the packed hero, stable across runs and platforms.
+ */
+uint64_t HashHero(const Player &player)
+{
+	PlayerPack pack;
+	PackPlayer(pack, player);
+	uint64_t hash = 14695981039346656037ULL;
+	for (const auto byte : reinterpret_cast<const uint8_t(&)[sizeof(pack)]>(pack)) {
+		hash ^= byte;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+int RunSimulation(int argc, char **argv)
+{
+	int demoNumber = 0;
+	bool forceSpawn = false;
+	bool forceDiablo = false;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "-h" || arg == "--help") {
+			PrintUsageAndExit(0);
+		} else if (arg == "--data-dir" && hasValue) {
+			paths::SetBasePath(argv[++i]);
+		} else if (arg == "--save-dir" && hasValue) {
+			paths::SetPrefPath(argv[++i]);
+			paths::SetConfigPath(argv[i]);
+		} else if (arg == "--demo" && hasValue) {
+			const ParseIntResult<int> parsedParam = ParseInt<int>(argv[++i]);
+			if (!parsedParam.has_value())
+				PrintUsageAndExit(64);
+			demoNumber = parsedParam.value();
+		} else if (arg == "--tick-profile") {
+			TickProfilerEnabled = true;
+		} else if (arg == "--spawn") {
+			forceSpawn = true;
+		} else if (arg == "--diablo") {
+			forceDiablo = true;
+		} else if (arg == "--hellfire") {
+			forceHellfire = true;
+		} else {
+			PrintUsageAndExit(64);
+		}
+	}
+
+	// Only the event subsystem is initialized: no window, renderer or audio device is ever created.
+	if (SDL_Init(
+#ifdef USE_SDL1
+	        0
+#else
+	        SDL_INIT_EVENTS
+#endif
+	        )
+	    <= -1) {
+		ErrSdl();
+	}
+
+	HeadlessMode = true;
+	LoadCoreArchives();
+	LoadGameArchives();
+	if (!HaveSpawn() && !HaveDiabdat()) {
+		printInConsole("devilutionx-sim requires spawn.mpq or diabdat.mpq\n");
+		return 1;
+	}
+
+	InitKeymapActions();
+	LoadOptions();
+	demo::InitPlayBack(demoNumber, /*timedemo=*/true);
+	demo::OverrideOptions();
+	LuaInitialize();
+
+	Players.resize(1);
+	MyPlayerId = 0;
+	MyPlayer = &Players[MyPlayerId];
+	*MyPlayer = {};
+
+	gbIsSpawn = forceSpawn || !HaveDiabdat();
+	gbIsHellfire = forceHellfire || (!forceDiablo && HaveHellfire());
+	gbIsHellfireSaveGame = gbIsHellfire;
+	gbMusicOn = false;
+	gbSoundOn = false;
+
+	LoadSpellData();
+	LoadPlayerDataFiles();
+	LoadMissileData();
+	LoadMonsterData();
+	LoadItemData();
+	LoadObjectData();
+	pfile_ui_set_hero_infos(DummyGetHeroInfo);
+	gbLoadGame = true;
+
+	AdjustToScreenGeometry(forceResolution);
+
+	StartGame(false, true);
+
+	const demo::PlaybackStats stats = demo::GetLastPlaybackStats();
+	const HeroCompareResult result = pfile_compare_hero_demo(demoNumber, false);
+	printInConsole(fmt::format("{} ticks in {} ms: {:.1f} ticks/s\n", stats.logicTicks, stats.milliseconds, stats.ticksPerSecond()));
+	printInConsole(fmt::format("hero hash: {:016x}\n", HashHero(*MyPlayer)));
+	if (TickProfilerEnabled) {
+		for (const std::string &line : FormatTickProfileSummary())
+			printInConsole(StrCat(line, "\n"));
+	}
+
+	int exitStatus = 0;
+	switch (result.status) {
+	case HeroCompareResult::ReferenceNotFound:
+		printInConsole("reference: not found\n");
+		break;
+	case HeroCompareResult::Same:
+		printInConsole("reference: same\n");
+		break;
+	case HeroCompareResult::Difference:
+		printInConsole(fmt::format("reference: different\n{}\n", result.message));
+		exitStatus = 1;
+		break;
+	}
+
+	init_cleanup();
+	SDL_Quit();
+	return exitStatus;
+}
+
+} // namespace
+
+} // namespace devilution
+
+extern "C" int main(int argc, char **argv)
+{
+	return devilution::RunSimulation(argc, argv);
+}
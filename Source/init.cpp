@@ -13,6 +13,7 @@
 #include <config.h>
 
 #include "DiabloUI/diabloui.h"
+#include "engine/asset_loader.hpp"
 #include "engine/assets.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/dx.h"
@@ -120,6 +121,8 @@ void init_cleanup()
 		sfile_write_stash();
 	}
 
+	StopAssetLoader();
+
 #ifdef UNPACKED_MPQS
 	lang_data_path = std::nullopt;
 	font_data_path = std::nullopt;
@@ -157,6 +160,11 @@ void init_create_window()
 void MainWndProc(const SDL_Event &event)
 {
 #ifndef USE_SDL1
+	if (event.type == SDL_RENDER_DEVICE_RESET) {
+		// The texture contents are lost along with the device.
+		InvalidateOutputSurface();
+		return;
+	}
 	if (event.type != SDL_WINDOWEVENT)
 		return;
 	switch (event.window.event) {
@@ -519,36 +519,40 @@ void LoadItemDat()
 	const std::string_view filename = "txtdata\\items\\itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	AllItemsList.clear();
-	AllItemsList.reserve(dataFile.numRecords());
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		ItemData &item = AllItemsList.emplace_back();
-		reader.advance(); // Skip the first column (item ID).
-		reader.readInt("dropRate", item.dropRate);
-		reader.read("class", item.iClass, ParseItemClass);
-		reader.read("equipType", item.iLoc, ParseItemEquipType);
-		reader.read("cursorGraphic", item.iCurs, ParseItemCursorGraphic);
-		reader.read("itemType", item.itype, ParseItemType);
-		reader.read("uniqueBaseItem", item.iItemId, ParseUniqueBaseItem);
-		reader.readString("name", item.iName);
-		reader.readString("shortName", item.iSName);
-		reader.readInt("minMonsterLevel", item.iMinMLvl);
-		reader.readInt("durability", item.iDurability);
-		reader.readInt("minDamage", item.iMinDam);
-		reader.readInt("maxDamage", item.iMaxDam);
-		reader.readInt("minArmor", item.iMinAC);
-		reader.readInt("maxArmor", item.iMaxAC);
-		reader.readInt("minStrength", item.iMinStr);
-		reader.readInt("minMagic", item.iMinMag);
-		reader.readInt("minDexterity", item.iMinDex);
-		reader.readEnumList("specialEffects", item.iFlags, ParseItemSpecialEffect);
-		reader.read("miscId", item.iMiscId, ParseItemMiscId);
-		reader.read("spell", item.iSpell, ParseSpellId);
-		reader.readBool("usable", item.iUsable);
-		reader.readInt("value", item.iValue);
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		AllItemsList.clear();
+		AllItemsList.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			ItemData &item = AllItemsList.emplace_back();
+			reader.advance(); // Skip the first column (item ID).
+			reader.readInt("dropRate", item.dropRate);
+			reader.read("class", item.iClass, ParseItemClass);
+			reader.read("equipType", item.iLoc, ParseItemEquipType);
+			reader.read("cursorGraphic", item.iCurs, ParseItemCursorGraphic);
+			reader.read("itemType", item.itype, ParseItemType);
+			reader.read("uniqueBaseItem", item.iItemId, ParseUniqueBaseItem);
+			reader.readString("name", item.iName);
+			reader.readString("shortName", item.iSName);
+			reader.readInt("minMonsterLevel", item.iMinMLvl);
+			reader.readInt("durability", item.iDurability);
+			reader.readInt("minDamage", item.iMinDam);
+			reader.readInt("maxDamage", item.iMaxDam);
+			reader.readInt("minArmor", item.iMinAC);
+			reader.readInt("maxArmor", item.iMaxAC);
+			reader.readInt("minStrength", item.iMinStr);
+			reader.readInt("minMagic", item.iMinMag);
+			reader.readInt("minDexterity", item.iMinDex);
+			reader.readEnumList("specialEffects", item.iFlags, ParseItemSpecialEffect);
+			reader.read("miscId", item.iMiscId, ParseItemMiscId);
+			reader.read("spell", item.iSpell, ParseSpellId);
+			reader.readBool("usable", item.iUsable);
+			reader.readInt("value", item.iValue);
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 	AllItemsList.shrink_to_fit();
 }
 
@@ -564,26 +568,30 @@ void LoadUniqueItemDat()
 	const std::string_view filename = "txtdata\\items\\unique_itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	UniqueItems.clear();
-	UniqueItems.reserve(dataFile.numRecords());
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		UniqueItem &item = UniqueItems.emplace_back();
-		reader.readString("name", item.UIName);
-		reader.read("cursorGraphic", item.UICurs, ParseItemCursorGraphic);
-		reader.read("uniqueBaseItem", item.UIItemId, ParseUniqueBaseItem);
-		reader.readInt("minLevel", item.UIMinLvl);
-		reader.readInt("value", item.UIValue);
-
-		// powers (up to 6)
-		item.UINumPL = 0;
-		for (size_t i = 0; i < 6; ++i) {
-			if (reader.value().empty())
-				break;
-			ReadItemPower(reader, StrCat("power", i), item.powers[item.UINumPL++]);
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		UniqueItems.clear();
+		UniqueItems.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			UniqueItem &item = UniqueItems.emplace_back();
+			reader.readString("name", item.UIName);
+			reader.read("cursorGraphic", item.UICurs, ParseItemCursorGraphic);
+			reader.read("uniqueBaseItem", item.UIItemId, ParseUniqueBaseItem);
+			reader.readInt("minLevel", item.UIMinLvl);
+			reader.readInt("value", item.UIValue);
+
+			// powers (up to 6)
+			item.UINumPL = 0;
+			for (size_t i = 0; i < 6; ++i) {
+				if (reader.value().empty())
+					break;
+				ReadItemPower(reader, StrCat("power", i), item.powers[item.UINumPL++]);
+			}
 		}
-	}
+	} while (!cache.finishReplay());
+	cache.save();
 	UniqueItems.shrink_to_fit();
 }
 
@@ -591,23 +599,27 @@ void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 {
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	out.clear();
-	out.reserve(dataFile.numRecords());
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		PLStruct &item = out.emplace_back();
-		reader.readString("name", item.PLName);
-		ReadItemPower(reader, "power", item.power);
-		reader.readInt("minLevel", item.PLMinLvl);
-		reader.readEnumList("itemTypes", item.PLIType, ParseAffixItemType);
-		reader.read("alignment", item.PLGOE, ParseAffixAlignment);
-		reader.readBool("doubleChance", item.PLDouble);
-		reader.readBool("useful", item.PLOk);
-		reader.readInt("minVal", item.minVal);
-		reader.readInt("maxVal", item.maxVal);
-		reader.readInt("multVal", item.multVal);
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		out.clear();
+		out.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			PLStruct &item = out.emplace_back();
+			reader.readString("name", item.PLName);
+			ReadItemPower(reader, "power", item.power);
+			reader.readInt("minLevel", item.PLMinLvl);
+			reader.readEnumList("itemTypes", item.PLIType, ParseAffixItemType);
+			reader.read("alignment", item.PLGOE, ParseAffixAlignment);
+			reader.readBool("doubleChance", item.PLDouble);
+			reader.readBool("useful", item.PLOk);
+			reader.readInt("minVal", item.minVal);
+			reader.readInt("maxVal", item.maxVal);
+			reader.readInt("multVal", item.multVal);
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 	out.shrink_to_fit();
 }
 
@@ -11,6 +11,7 @@
 #endif
 #include <climits>
 #include <cstdint>
+#include <optional>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -1412,38 +1413,149 @@ void GetItemBonus(const Player &player, Item &item, int minlvl, int maxlvl, bool
 	}
 }
 
-struct WeightedItemIndex {
-	_item_indexes index;
-	unsigned cumulativeWeight;
+/** @brief Which filter a cached drop table was built with, see DropTableFilter. */
+enum class DropTableFilterKind : uint8_t {
+	/** Items dropped by monsters, see RndUItem */
+	MonsterDrop,
+	/** Any item up to the max level, see RndAllItems */
+	AnyItem,
+	/** Items of one type and optionally one misc id, see RndTypeItems */
+	TypeItem,
 };
 
-_item_indexes GetItemIndexForDroppableItem(bool considerDropRate, tl::function_ref<bool(const ItemData &item)> isItemOkay, DropRateContext context = DropRateContext::Always, int monsterLevel = 0)
+/**
+ * @brief Describes an item filter passed to GetItemIndexForDroppableItem whose result only depends on these values.
+ *
+ * Drops using the same filter share a precomputed table instead of going over all items every time.
+ */
+struct DropTableFilter {
+	DropTableFilterKind kind;
+	int maxLevel;
+	ItemType itemType = ItemType::None;
+	int imid = -1;
+
+	bool operator==(const DropTableFilter &other) const = default;
+};
+
+struct DropTableKey {
+	DropTableFilter filter;
+	bool considerDropRate;
+	DropRateContext context;
+	uint32_t dropRateSettingsVersion;
+	bool isMultiplayer;
+
+	bool operator==(const DropTableKey &other) const = default;
+};
+
+/** @brief The droppable items for one DropTableKey. */
+struct DropTable : WeightedItemTable {
+	DropTableKey key;
+};
+
+/** @brief There's a table for each filter and level in use, so this is only reached after visiting lots of levels. */
+constexpr size_t MaxDropTables = 64;
+
+/** @brief Cleared by InitItems, since the item data and game mode can change between levels. */
+std::vector<DropTable> DropTables;
+
+unsigned GetDroppableItemWeight(const ItemData &item, _item_indexes index, bool considerDropRate, DropRateContext context)
 {
-	// Get the drop rate manager instance
-	static DropRateManager& dropRateManager = DropRateManager::getInstance();
+	if (!considerDropRate)
+		return 1; // Not considering drop rate, just add 1
+
+	const DropRateManager &dropRateManager = DropRateManager::getInstance();
+	const DropRateManager::ItemType itemTypePreference = dropRateManager.GetItemTypePreference();
+	const int itemQualityPercent = dropRateManager.GetItemQualityPercent();
+
+	// Check if the item is unique
+	bool isUnique = (item.iItemId != UITYPE_NONE);
 	
-	// Check if we should apply item type and quality preferences
-	auto itemTypePreference = dropRateManager.GetItemTypePreference();
-	int itemQualityPercent = dropRateManager.GetItemQualityPercent();
+	// Apply direct drop rate modifications
+	float modifiedDropRate = static_cast<float>(item.dropRate);
 	
-	// Log the item type and quality settings
-	LogVerbose("Item selection - Type preference: {}, Quality: {}%", 
-		static_cast<int>(itemTypePreference), itemQualityPercent);
+	// Special case for gold - only apply if gold drop rate is not 0
+	if (index == IDI_GOLD) {
+		int goldDropRate = dropRateManager.GetGoldDropRatePercent();
+		if (goldDropRate == 0) {
+			// If gold drop rate is 0%, set drop rate to 0
+			modifiedDropRate = 0.0f;
+		} else {
+			// Otherwise use a normal value proportional to the gold drop rate
+			modifiedDropRate = static_cast<float>(goldDropRate) * 100.0f;
+		}
+	}
 	
-	// If we're not considering drop rates, use the old logic with 80% chance for gold
-	if (!considerDropRate) {
-		// 80% chance to force gold drops
-		if (RandomIntLessThan(100) < 80) {
-			return IDI_GOLD;
+	// Apply item type preference modifier
+	switch (itemTypePreference) {
+		case DropRateManager::ItemType::Normal:
+			// Prefer normal items (non-magical, non-unique)
+			if (!isUnique) {
+				modifiedDropRate *= 3.0f;
+			}
+			break;
+		case DropRateManager::ItemType::Magic:
+			// Prefer magical items
+			// In this game, magical items are those with special properties
+			if (!HasNoneOf(item.iFlags, ~ItemSpecialEffect::None) && !isUnique) {
+				modifiedDropRate *= 3.0f;
+			}
+			break;
+		case DropRateManager::ItemType::Rare:
+			// Prefer rare items - these are items with high value
+			if (item.iValue > 5000 && !isUnique) {
+				modifiedDropRate *= 3.0f;
+			}
+			break;
+		case DropRateManager::ItemType::Unique:
+			// Prefer unique items - use a much higher multiplier to make them more common
+			if (isUnique) {
+				modifiedDropRate *= 10.0f;
+			} else {
+				// Reduce chance of non-unique items
+				modifiedDropRate *= 0.2f;
+			}
+			break;
+		default:
+			break;
+	}
+	
+	// Apply item quality modifier
+	// For special object drops, we apply a reduced quality scaling factor
+	float qualityScalingFactor = 1.0f;
+	if (context == DropRateContext::SpecialObjectDrop) {
+		// Get the configured scaling factor for special object drops from the DropRateManager
+		int scalingFactorPercent = dropRateManager.GetSpecialObjectQualityScalingFactor();
+		qualityScalingFactor = static_cast<float>(scalingFactorPercent) / 100.0f;
+		LogVerbose("Special object drop detected - applying configured quality scaling factor: {}%", scalingFactorPercent);
+	}
+	
+	if (itemQualityPercent > 50) {
+		// Higher quality means better items (unique, high value, special properties)
+		float qualityMultiplier = 1.0f + ((itemQualityPercent - 50) / 50.0f) * 4.0f * qualityScalingFactor;
+		if (isUnique) {
+			modifiedDropRate *= (qualityMultiplier * 3.0f);
+		} else if (item.iValue > 5000) {
+			// High value items
+			modifiedDropRate *= (qualityMultiplier * 0.75f);
+		} else if (!HasNoneOf(item.iFlags, ~ItemSpecialEffect::None)) {
+			// Items with special properties
+			modifiedDropRate *= (qualityMultiplier * 0.5f);
+		}
+	} else if (itemQualityPercent < 50) {
+		// Lower quality means worse items (normal)
+		float qualityMultiplier = 1.0f + ((50 - itemQualityPercent) / 50.0f) * 4.0f * qualityScalingFactor;
+		if (!isUnique && HasNoneOf(item.iFlags, ~ItemSpecialEffect::None) && item.iValue < 1000) {
+			// Basic items with no special properties and low value
+			modifiedDropRate *= qualityMultiplier;
 		}
 	}
 
-	static std::vector<WeightedItemIndex> ril;
-	ril.clear();
+	return static_cast<unsigned>(modifiedDropRate);
+}
 
-	// Get current dungeon level
-	int dungeonLevel = ItemsGetCurrlevel();
-	
+/** @brief Adds every item that can drop to items, returning the total weight. */
+unsigned AddDroppableItems(std::vector<WeightedItemIndex> &items, bool considerDropRate, tl::function_ref<bool(const ItemData &item)> isItemOkay, DropRateContext context)
+{
 	unsigned cumulativeWeight = 0;
 	for (std::underlying_type_t<_item_indexes> i = IDI_GOLD; i <= IDI_LAST; i++) {
 		if (!IsItemAvailable(i))
@@ -1455,100 +1567,61 @@ _item_indexes GetItemIndexForDroppableItem(bool considerDropRate, tl::function_r
 			continue;
 		if (!isItemOkay(item))
 			continue;
-		
-		// Apply drop rate modifiers if considering drop rate
-		if (considerDropRate) {
-			// Check if the item is unique
-			bool isUnique = (item.iItemId != UITYPE_NONE);
-			
-			// Apply direct drop rate modifications
-			float modifiedDropRate = static_cast<float>(item.dropRate);
-			
-			// Special case for gold - only apply if gold drop rate is not 0
-			if (i == IDI_GOLD) {
-				int goldDropRate = dropRateManager.GetGoldDropRatePercent();
-				if (goldDropRate == 0) {
-					// If gold drop rate is 0%, set drop rate to 0
-					modifiedDropRate = 0.0f;
-				} else {
-					// Otherwise use a normal value proportional to the gold drop rate
-					modifiedDropRate = static_cast<float>(goldDropRate) * 100.0f;
-				}
-			}
-			
-			// Apply item type preference modifier
-			switch (itemTypePreference) {
-				case DropRateManager::ItemType::Normal:
-					// Prefer normal items (non-magical, non-unique)
-					if (!isUnique) {
-						modifiedDropRate *= 3.0f;
-					}
-					break;
-				case DropRateManager::ItemType::Magic:
-					// Prefer magical items
-					// In this game, magical items are those with special properties
-					if (!HasNoneOf(item.iFlags, ~ItemSpecialEffect::None) && !isUnique) {
-						modifiedDropRate *= 3.0f;
-					}
-					break;
-				case DropRateManager::ItemType::Rare:
-					// Prefer rare items - these are items with high value
-					if (item.iValue > 5000 && !isUnique) {
-						modifiedDropRate *= 3.0f;
-					}
-					break;
-				case DropRateManager::ItemType::Unique:
-					// Prefer unique items - use a much higher multiplier to make them more common
-					if (isUnique) {
-						modifiedDropRate *= 10.0f;
-					} else {
-						// Reduce chance of non-unique items
-						modifiedDropRate *= 0.2f;
-					}
-					break;
-				default:
-					break;
-			}
-			
-			// Apply item quality modifier
-			// For special object drops, we apply a reduced quality scaling factor
-			float qualityScalingFactor = 1.0f;
-			if (context == DropRateContext::SpecialObjectDrop) {
-				// Get the configured scaling factor for special object drops from the DropRateManager
-				int scalingFactorPercent = dropRateManager.GetSpecialObjectQualityScalingFactor();
-				qualityScalingFactor = static_cast<float>(scalingFactorPercent) / 100.0f;
-				LogVerbose("Special object drop detected - applying configured quality scaling factor: {}%", scalingFactorPercent);
-			}
-			
-			if (itemQualityPercent > 50) {
-				// Higher quality means better items (unique, high value, special properties)
-				float qualityMultiplier = 1.0f + ((itemQualityPercent - 50) / 50.0f) * 4.0f * qualityScalingFactor;
-				if (isUnique) {
-					modifiedDropRate *= (qualityMultiplier * 3.0f);
-				} else if (item.iValue > 5000) {
-					// High value items
-					modifiedDropRate *= (qualityMultiplier * 0.75f);
-				} else if (!HasNoneOf(item.iFlags, ~ItemSpecialEffect::None)) {
-					// Items with special properties
-					modifiedDropRate *= (qualityMultiplier * 0.5f);
-				}
-			} else if (itemQualityPercent < 50) {
-				// Lower quality means worse items (normal)
-				float qualityMultiplier = 1.0f + ((50 - itemQualityPercent) / 50.0f) * 4.0f * qualityScalingFactor;
-				if (!isUnique && HasNoneOf(item.iFlags, ~ItemSpecialEffect::None) && item.iValue < 1000) {
-					// Basic items with no special properties and low value
-					modifiedDropRate *= qualityMultiplier;
-				}
-			}
-			
-			// Apply the modified drop rate
-			cumulativeWeight += static_cast<unsigned>(modifiedDropRate);
-		} else {
-			cumulativeWeight += 1; // Not considering drop rate, just add 1
+
+		cumulativeWeight += GetDroppableItemWeight(item, static_cast<_item_indexes>(i), considerDropRate, context);
+		items.push_back({ static_cast<_item_indexes>(i), cumulativeWeight });
+	}
+	return cumulativeWeight;
+}
+
+const DropTable &GetDropTable(const DropTableKey &key, tl::function_ref<bool(const ItemData &item)> isItemOkay)
+{
+	for (const DropTable &table : DropTables) {
+		if (table.key == key)
+			return table;
+	}
+
+	if (DropTables.size() >= MaxDropTables)
+		DropTables.clear();
+	DropTable &table = DropTables.emplace_back();
+	table.key = key;
+	AddDroppableItems(table.items, key.considerDropRate, isItemOkay, key.context);
+	if (table.totalWeight() != 0)
+		table.buildGuide();
+	return table;
+}
+
+/**
+ * @param filter Describes isItemOkay if it only depends on these values, so the table of droppable items can be reused
+ * until the drop rate settings change.
+ */
+_item_indexes GetItemIndexForDroppableItem(bool considerDropRate, tl::function_ref<bool(const ItemData &item)> isItemOkay, DropRateContext context = DropRateContext::Always, int monsterLevel = 0, std::optional<DropTableFilter> filter = std::nullopt)
+{
+	// Get the drop rate manager instance
+	static DropRateManager& dropRateManager = DropRateManager::getInstance();
+	
+	// Log the item type and quality settings
+	LogVerbose("Item selection - Type preference: {}, Quality: {}%", 
+		static_cast<int>(dropRateManager.GetItemTypePreference()), dropRateManager.GetItemQualityPercent());
+	
+	// If we're not considering drop rates, use the old logic with 80% chance for gold
+	if (!considerDropRate) {
+		// 80% chance to force gold drops
+		if (RandomIntLessThan(100) < 80) {
+			return IDI_GOLD;
 		}
-		
-		ril.push_back({ static_cast<_item_indexes>(i), cumulativeWeight });
 	}
+
+	if (filter) {
+		const DropTable &table = GetDropTable({ *filter, considerDropRate, context, dropRateManager.GetSettingsVersion(), gbIsMultiplayer }, isItemOkay);
+		if (table.totalWeight() == 0)
+			return IDI_GOLD;
+		return table.pick(static_cast<unsigned>(RandomIntLessThan(static_cast<int>(table.totalWeight()))));
+	}
+
+	static std::vector<WeightedItemIndex> ril;
+	ril.clear();
+	const unsigned cumulativeWeight = AddDroppableItems(ril, considerDropRate, isItemOkay, context);
 	
 	// If no items are available, return gold
 	if (cumulativeWeight == 0)
@@ -1574,7 +1647,7 @@ _item_indexes RndUItem(Monster *monster)
 		if (IsAnyOf(item.itype, ItemType::Gold, ItemType::Misc))
 			return false;
 		return true;
-	}, DropRateContext::MonsterDrop, monsterLevel);
+	}, DropRateContext::MonsterDrop, monsterLevel, DropTableFilter { DropTableFilterKind::MonsterDrop, itemMaxLevel });
 }
 
 _item_indexes RndAllItems()
@@ -1617,7 +1690,7 @@ _item_indexes RndAllItems()
 		if (itemMaxLevel < item.iMinMLvl)
 			return false;
 		return true;
-	}, DropRateContext::GroundDrop);
+	}, DropRateContext::GroundDrop, 0, DropTableFilter { DropTableFilterKind::AnyItem, itemMaxLevel });
 }
 
 _item_indexes RndTypeItems(ItemType itemType, int imid, int lvl, DropRateContext dropContext = DropRateContext::GroundDrop)
@@ -1631,7 +1704,7 @@ _item_indexes RndTypeItems(ItemType itemType, int imid, int lvl, DropRateContext
 		if (imid != -1 && item.iMiscId != imid)
 			return false;
 		return true;
-	}, dropContext);
+	}, dropContext, 0, DropTableFilter { DropTableFilterKind::TypeItem, itemMaxLevel, itemType, imid });
 }
 
 std::vector<uint8_t> GetValidUniques(int lvl, unique_base_item baseItemId)
@@ -2659,6 +2732,8 @@ void InitItems()
 		ActiveItems[i] = i;
 	}
 
+	DropTables.clear();
+
 	if (!setlevel) {
 		DiscardRandomValues(1);
 		if (Quests[Q_ROCK].IsAvailable())
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "DiabloUI/ui_flags.hpp"
 #include "cursor.h"
@@ -485,6 +486,52 @@ struct CornerStoneStruct {
 	bool isAvailable();
 };
 
+struct WeightedItemIndex {
+	_item_indexes index;
+	unsigned cumulativeWeight;
+};
+
+/**
+ * @brief Items with their cumulative weights, with a guide table for picking one without a search.
+ *
+ * guide[b] is the first item that can be picked by a weight in the b-th of guide.size() equal slices of the total weight,
+ * so picking an item only looks at the few items starting in the same slice. The result is the same as searching the
+ * cumulative weights for the same random value, which keeps drops in sync with other players and demo recordings.
+ */
+struct WeightedItemTable {
+	std::vector<WeightedItemIndex> items;
+	std::vector<uint16_t> guide;
+
+	[[nodiscard]] unsigned totalWeight() const
+	{
+		return items.empty() ? 0 : items.back().cumulativeWeight;
+	}
+
+	void buildGuide()
+	{
+		const uint64_t total = totalWeight();
+		const size_t buckets = items.size();
+		guide.resize(buckets);
+		size_t item = 0;
+		for (size_t bucket = 0; bucket < buckets; bucket++) {
+			// The smallest weight that falls into this slice
+			const uint64_t bucketStart = (bucket * total + buckets - 1) / buckets;
+			while (item + 1 < items.size() && items[item].cumulativeWeight <= bucketStart)
+				item++;
+			guide[bucket] = static_cast<uint16_t>(item);
+		}
+	}
+
+	/** @brief Same as searching items for the first cumulative weight above targetWeight. */
+	[[nodiscard]] _item_indexes pick(unsigned targetWeight) const
+	{
+		size_t item = guide[static_cast<uint64_t>(targetWeight) * guide.size() / totalWeight()];
+		while (items[item].cumulativeWeight <= targetWeight)
+			item++;
+		return items[item].index;
+	}
+};
+
 /** Contains the items on ground in the current game. */
 extern Item Items[MAXITEMS + 1];
 extern uint8_t ActiveItems[MAXITEMS];
@@ -1,7 +1,12 @@
 #include "levels/drlg_l1.h"
 
+#include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
 
+#include "diablo.h"
 #include "engine/load_file.hpp"
 #include "engine/point.hpp"
 #include "engine/random.hpp"
@@ -17,17 +22,6 @@ namespace devilution {
 
 namespace {
 
-/** Marks where walls may not be added to the level */
-Bitset2d<DMAXX, DMAXY> Chamber;
-/** Specifies whether to generate a horizontal or vertical layout. */
-bool VerticalLayout;
-/** Specifies whether to generate a room at position 1 in the Cathedral. */
-bool HasChamber1;
-/** Specifies whether to generate a room at position 2 in the Cathedral. */
-bool HasChamber2;
-/** Specifies whether to generate a room at position 3 in the Cathedral. */
-bool HasChamber3;
-
 /** Miniset: stairs up on a corner wall. */
 const Miniset STAIRSUP {
 	{ 4, 4 },
@@ -280,16 +274,152 @@ const uint8_t TileDecorations[207] = {
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
-void ApplyShadowsPatterns()
+/**
+ * @brief Generates one Cathedral or Crypt level.
+ *
+ * All state of a generation run lives in the generator, and it only writes the maps it was given. CreateL5Dungeon
+ * gives it the level globals and the global RNG. GenerateCathedralLevel gives it a CathedralLevel and its own RNG, so
+ * that several levels can be generated at once. The Crypt code in crypt.cpp still works on the globals, so Crypt levels
+ * are only generated through CreateL5Dungeon.
+ */
+class CathedralGenerator {
+public:
+	/**
+	 * @param maps Maps to build the level in
+	 * @param setPiece Receives the area of the quest set piece
+	 * @param params The level to generate
+	 * @param rng Engine to use, or nullptr to use the global engine
+	 */
+	CathedralGenerator(const DungeonMaps &maps, WorldTileRectangle &setPiece, const CathedralLevelParams &params, DiabloGenerator *rng)
+	    : maps(maps)
+	    , tiles(maps.tiles)
+	    , protectedTiles(maps.protectedTiles)
+	    , setPiece(setPiece)
+	    , params(params)
+	    , rng(rng)
+	{
+	}
+
+	void generateLevel(lvl_entry entry);
+	void initDungeonFlags();
+	void fillFloor();
+	WorldTilePosition selectChamber();
+
+	/** Engine state that the level was generated from, see LevelSeeds */
+	uint32_t levelSeed = 0;
+	/** Where the player starts for the given entry, if the stairs placement decided it */
+	std::optional<Point> viewPosition;
+	/** Position of the Poisoned Water Supply entrance, if placed */
+	std::optional<Point> poisonedWaterPosition;
+
+private:
+	int32_t generateRnd(int32_t v)
+	{
+		return rng != nullptr ? rng->generateRnd(v) : GenerateRnd(v);
+	}
+
+	bool flipCoin(unsigned frequency = 2)
+	{
+		return rng != nullptr ? rng->flipCoin(frequency) : FlipCoin(frequency);
+	}
+
+	int32_t randomIntLessThan(int32_t v)
+	{
+		return rng != nullptr ? rng->randomIntLessThan(v) : RandomIntLessThan(v);
+	}
+
+	template <typename T>
+	T pickRandomlyAmong(const std::initializer_list<T> &values)
+	{
+		return rng != nullptr ? rng->pickRandomlyAmong(values) : PickRandomlyAmong(values);
+	}
+
+	void discardRandomValues(unsigned count)
+	{
+		if (rng != nullptr)
+			rng->discardRandomValues(count);
+		else
+			DiscardRandomValues(count);
+	}
+
+	uint32_t engineState() const
+	{
+		return rng != nullptr ? rng->engineState() : GetLCGEngineState();
+	}
+
+	void seedEngine(uint32_t seed)
+	{
+		if (rng != nullptr)
+			*rng = DiabloGenerator(seed);
+		else
+			SetRndSeed(seed);
+	}
+
+	std::optional<Point> placeMiniSet(const Miniset &miniset, int tries, bool drlg1Quirk)
+	{
+		const int32_t x = generateRnd(DMAXX - miniset.size.width);
+		const int32_t y = generateRnd(DMAXY - miniset.size.height);
+		return PlaceMiniSet(maps, miniset, { x, y }, tries, drlg1Quirk);
+	}
+
+	void applyShadowsPatterns();
+	void initSetPiece();
+	void mapRoom(Rectangle room);
+	bool checkRoom(Rectangle room);
+	void generateRoom(Rectangle area, bool verticalLayout);
+	void firstRoom();
+	size_t findArea();
+	void makeDmt();
+	int horizontalWallOk(Point position);
+	int verticalWallOk(Point position);
+	void horizontalWall(Point position, Tile start, int maxX);
+	void verticalWall(Point position, Tile start, int maxY);
+	void addWall();
+	void generateChamber(Point position, bool connectPrevious, bool connectNext, bool verticalLayout);
+	void generateHall(Point start, int length, bool verticalLayout);
+	void fixTilesPatterns();
+	void substitution();
+	void fillChambers();
+	void fixTransparency();
+	void fixDirtTiles();
+	void fixCornerTiles();
+	bool placeCathedralStairs(lvl_entry entry);
+	bool placeStairs(lvl_entry entry);
+
+	DungeonMaps maps;
+	uint8_t (&tiles)[DMAXX][DMAXY];
+	Bitset2d<DMAXX, DMAXY> &protectedTiles;
+	WorldTileRectangle &setPiece;
+	const CathedralLevelParams &params;
+	DiabloGenerator *rng;
+
+	/** Reprecents what tiles are being utilized in the generated map. */
+	Bitset2d<DMAXX, DMAXY> dungeonMask;
+	/** Marks where walls may not be added to the level */
+	Bitset2d<DMAXX, DMAXY> chamberTiles;
+	/** Specifies whether to generate a horizontal or vertical layout. */
+	bool isVerticalLayout = false;
+	/** Specifies whether to generate a room at position 1 in the Cathedral. */
+	bool hasChamber1 = false;
+	/** Specifies whether to generate a room at position 2 in the Cathedral. */
+	bool hasChamber2 = false;
+	/** Specifies whether to generate a room at position 3 in the Cathedral. */
+	bool hasChamber3 = false;
+};
+
+/** The generator CreateL5Dungeon is running, for the Crypt code that calls back into this file */
+CathedralGenerator *ActiveGenerator;
+
+void CathedralGenerator::applyShadowsPatterns()
 {
 	uint8_t slice[2][2];
 
 	for (int y = 1; y < DMAXY; y++) {
 		for (int x = 1; x < DMAXX; x++) {
-			slice[0][0] = BaseTypes[dungeon[x][y]];
-			slice[1][0] = BaseTypes[dungeon[x - 1][y]];
-			slice[0][1] = BaseTypes[dungeon[x][y - 1]];
-			slice[1][1] = BaseTypes[dungeon[x - 1][y - 1]];
+			slice[0][0] = BaseTypes[tiles[x][y]];
+			slice[1][0] = BaseTypes[tiles[x - 1][y]];
+			slice[0][1] = BaseTypes[tiles[x][y - 1]];
+			slice[1][1] = BaseTypes[tiles[x - 1][y - 1]];
 
 			for (const auto &shadow : ShadowPatterns) {
 				if (shadow.strig != slice[0][0])
@@ -301,14 +431,14 @@ void ApplyShadowsPatterns()
 				if (shadow.s3 != 0 && shadow.s3 != slice[1][0])
 					continue;
 
-				if (shadow.nv1 != 0 && !Protected.test(x - 1, y - 1)) {
-					dungeon[x - 1][y - 1] = shadow.nv1;
+				if (shadow.nv1 != 0 && !protectedTiles.test(x - 1, y - 1)) {
+					tiles[x - 1][y - 1] = shadow.nv1;
 				}
-				if (shadow.nv2 != 0 && !Protected.test(x, y - 1)) {
-					dungeon[x][y - 1] = shadow.nv2;
+				if (shadow.nv2 != 0 && !protectedTiles.test(x, y - 1)) {
+					tiles[x][y - 1] = shadow.nv2;
 				}
-				if (shadow.nv3 != 0 && !Protected.test(x - 1, y)) {
-					dungeon[x - 1][y] = shadow.nv3;
+				if (shadow.nv3 != 0 && !protectedTiles.test(x - 1, y)) {
+					tiles[x - 1][y] = shadow.nv3;
 				}
 			}
 		}
@@ -316,29 +446,29 @@ void ApplyShadowsPatterns()
 
 	for (int y = 1; y < DMAXY; y++) {
 		for (int x = 1; x < DMAXX; x++) {
-			if (Protected.test(x - 1, y))
+			if (protectedTiles.test(x - 1, y))
 				continue;
 
-			if (dungeon[x - 1][y] == Floor12) {
+			if (tiles[x - 1][y] == Floor12) {
 				Tile tnv3 = Floor12;
-				if (IsAnyOf(dungeon[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
+				if (IsAnyOf(tiles[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
 					tnv3 = Floor14;
 				}
-				dungeon[x - 1][y] = tnv3;
+				tiles[x - 1][y] = tnv3;
 			}
-			if (dungeon[x - 1][y] == HArchShadow) {
+			if (tiles[x - 1][y] == HArchShadow) {
 				Tile tnv3 = HArchShadow;
-				if (IsAnyOf(dungeon[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
+				if (IsAnyOf(tiles[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
 					tnv3 = HArchShadow2;
 				}
-				dungeon[x - 1][y] = tnv3;
+				tiles[x - 1][y] = tnv3;
 			}
-			if (dungeon[x - 1][y] == HWallShadow) {
+			if (tiles[x - 1][y] == HWallShadow) {
 				Tile tnv3 = HWallShadow;
-				if (IsAnyOf(dungeon[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
+				if (IsAnyOf(tiles[x][y], DFence, VFenceEnd, VFence, HWallVFence, HArchVFence, HArchVDoor)) {
 					tnv3 = HWallShadow2;
 				}
-				dungeon[x - 1][y] = tnv3;
+				tiles[x - 1][y] = tnv3;
 			}
 		}
 	}
@@ -366,38 +496,59 @@ bool CanReplaceTile(uint8_t replace, Point tile)
 	return true;
 }
 
-void FillFloor()
+void CathedralGenerator::fillFloor()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] != Floor || Protected.test(i, j))
+			if (tiles[i][j] != Floor || protectedTiles.test(i, j))
 				continue;
 
-			int rv = RandomIntLessThan(3);
+			int rv = randomIntLessThan(3);
 			if (rv == 1)
-				dungeon[i][j] = Floor22;
+				tiles[i][j] = Floor22;
 			else if (rv == 2)
-				dungeon[i][j] = Floor23;
+				tiles[i][j] = Floor23;
 		}
 	}
 }
 
-void InitSetPiece()
+WorldTilePosition CathedralGenerator::selectChamber()
 {
-	std::unique_ptr<uint16_t[]> setPieceData;
-	if (Quests[Q_BUTCHER].IsAvailable()) {
-		setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\rnd6.dun");
-	} else if (Quests[Q_SKELKING].IsAvailable() && !UseMultiplayerQuests()) {
-		setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\skngdo.dun");
-	} else if (Quests[Q_LTBANNER].IsAvailable()) {
-		setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\banner2.dun");
+	int chamber;
+	if (hasChamber1 && hasChamber2 && hasChamber3) {
+		chamber = generateRnd(3) + 1;
+	} else if (hasChamber1 && hasChamber2) {
+		chamber = pickRandomlyAmong({ 2, 1 }); // Reverse order to match vanilla
+	} else if (hasChamber1 && hasChamber3) {
+		chamber = pickRandomlyAmong({ 3, 1 }); // Reverse order to match vanilla
+	} else if (hasChamber2 && hasChamber3) {
+		chamber = pickRandomlyAmong({ 2, 3 });
 	} else {
-		return; // no setpiece needed for this level
+		// The dungeon generation logic ensures that chamber 2 is available if
+		// either (or both of) 1 or 3 aren't, so if we ever end up with a single
+		// chamber layout it's always chamber 2.
+		chamber = 2;
 	}
 
-	WorldTilePosition setPiecePosition = SelectChamber();
-	PlaceDunTiles(setPieceData.get(), setPiecePosition, Floor);
-	SetPiece = { setPiecePosition, GetDunSize(setPieceData.get()) };
+	switch (chamber) {
+	case 1:
+		return isVerticalLayout ? WorldTilePosition { 16, 2 } : WorldTilePosition { 2, 16 };
+	case 3:
+		return isVerticalLayout ? WorldTilePosition { 16, 30 } : WorldTilePosition { 30, 16 };
+	default:
+		return { 16, 16 };
+	}
+}
+
+void CathedralGenerator::initSetPiece()
+{
+	const uint16_t *setPieceData = params.setPieceData.get();
+	if (setPieceData == nullptr)
+		return; // no setpiece needed for this level
+
+	WorldTilePosition setPiecePosition = selectChamber();
+	PlaceDunTiles(maps, setPieceData, setPiecePosition, Floor);
+	setPiece = { setPiecePosition, GetDunSize(setPieceData) };
 }
 
 void InitDungeonPieces()
@@ -425,30 +576,30 @@ void InitDungeonPieces()
 	}
 }
 
-void InitDungeonFlags()
+void CathedralGenerator::initDungeonFlags()
 {
-	memset(dungeon, Dirt, sizeof(dungeon));
-	Protected.reset();
-	Chamber.reset();
+	memset(tiles, Dirt, sizeof(tiles));
+	protectedTiles.reset();
+	chamberTiles.reset();
 }
 
-void MapRoom(Rectangle room)
+void CathedralGenerator::mapRoom(Rectangle room)
 {
 	for (int y = 0; y < room.size.height; y++) {
 		for (int x = 0; x < room.size.width; x++) {
-			DungeonMask.set(room.position.x + x, room.position.y + y);
+			dungeonMask.set(room.position.x + x, room.position.y + y);
 		}
 	}
 }
 
-bool CheckRoom(Rectangle room)
+bool CathedralGenerator::checkRoom(Rectangle room)
 {
 	for (int j = 0; j < room.size.height; j++) {
 		for (int i = 0; i < room.size.width; i++) {
 			if (i + room.position.x < 0 || i + room.position.x >= DMAXX || j + room.position.y < 0 || j + room.position.y >= DMAXY) {
 				return false;
 			}
-			if (DungeonMask.test(i + room.position.x, j + room.position.y)) {
+			if (dungeonMask.test(i + room.position.x, j + room.position.y)) {
 				return false;
 			}
 		}
@@ -457,142 +608,142 @@ bool CheckRoom(Rectangle room)
 	return true;
 }
 
-void GenerateRoom(Rectangle area, bool verticalLayout)
+void CathedralGenerator::generateRoom(Rectangle area, bool verticalLayout)
 {
-	bool rotate = FlipCoin(4);
+	bool rotate = flipCoin(4);
 	verticalLayout = (!verticalLayout && rotate) || (verticalLayout && !rotate);
 
 	bool placeRoom1;
 	Rectangle room1;
 
 	for (int num = 0; num < 20; num++) {
-		const int32_t randomWidth = (GenerateRnd(5) + 2) & ~1;
-		const int32_t randomHeight = (GenerateRnd(5) + 2) & ~1;
+		const int32_t randomWidth = (generateRnd(5) + 2) & ~1;
+		const int32_t randomHeight = (generateRnd(5) + 2) & ~1;
 		room1.size = { randomWidth, randomHeight };
 		room1.position = area.position;
 		if (verticalLayout) {
 			room1.position += Displacement { -room1.size.width, area.size.height / 2 - room1.size.height / 2 };
-			placeRoom1 = CheckRoom({ room1.position + Displacement { -1, -1 }, { room1.size.height + 2, room1.size.width + 1 } }); /// BUGFIX: swap height and width ({ room1.size.width + 1, room1.size.height + 2 }) (workaround applied below)
+			placeRoom1 = checkRoom({ room1.position + Displacement { -1, -1 }, { room1.size.height + 2, room1.size.width + 1 } }); /// BUGFIX: swap height and width ({ room1.size.width + 1, room1.size.height + 2 }) (workaround applied below)
 		} else {
 			room1.position += Displacement { area.size.width / 2 - room1.size.width / 2, -room1.size.height };
-			placeRoom1 = CheckRoom({ room1.position + Displacement { -1, -1 }, { room1.size.width + 2, room1.size.height + 1 } });
+			placeRoom1 = checkRoom({ room1.position + Displacement { -1, -1 }, { room1.size.width + 2, room1.size.height + 1 } });
 		}
 		if (placeRoom1)
 			break;
 	}
 
 	if (placeRoom1)
-		MapRoom({ room1.position, { std::min(DMAXX - room1.position.x, room1.size.width), std::min(DMAXX - room1.position.y, room1.size.height) } });
+		mapRoom({ room1.position, { std::min(DMAXX - room1.position.x, room1.size.width), std::min(DMAXX - room1.position.y, room1.size.height) } });
 
 	bool placeRoom2;
 	Rectangle room2 = room1;
 	if (verticalLayout) {
 		room2.position.x = area.position.x + area.size.width;
-		placeRoom2 = CheckRoom({ room2.position + Displacement { 0, -1 }, { room2.size.width + 1, room2.size.height + 2 } });
+		placeRoom2 = checkRoom({ room2.position + Displacement { 0, -1 }, { room2.size.width + 1, room2.size.height + 2 } });
 	} else {
 		room2.position.y = area.position.y + area.size.height;
-		placeRoom2 = CheckRoom({ room2.position + Displacement { -1, 0 }, { room2.size.width + 2, room2.size.height + 1 } });
+		placeRoom2 = checkRoom({ room2.position + Displacement { -1, 0 }, { room2.size.width + 2, room2.size.height + 1 } });
 	}
 
 	if (placeRoom2)
-		MapRoom(room2);
+		mapRoom(room2);
 	if (placeRoom1)
-		GenerateRoom(room1, !verticalLayout);
+		generateRoom(room1, !verticalLayout);
 	if (placeRoom2)
-		GenerateRoom(room2, !verticalLayout);
+		generateRoom(room2, !verticalLayout);
 }
 
 /**
  * @brief Generate a boolean dungoen room layout
  */
-void FirstRoom()
+void CathedralGenerator::firstRoom()
 {
-	DungeonMask.reset();
+	dungeonMask.reset();
 
-	VerticalLayout = FlipCoin();
-	HasChamber1 = !FlipCoin();
-	HasChamber2 = !FlipCoin();
-	HasChamber3 = !FlipCoin();
+	isVerticalLayout = flipCoin();
+	hasChamber1 = !flipCoin();
+	hasChamber2 = !flipCoin();
+	hasChamber3 = !flipCoin();
 
-	if (!HasChamber1 || !HasChamber3)
-		HasChamber2 = true;
+	if (!hasChamber1 || !hasChamber3)
+		hasChamber2 = true;
 
 	Rectangle chamber1 { { 1, 15 }, { 10, 10 } };
 	Rectangle chamber2 { { 15, 15 }, { 10, 10 } };
 	Rectangle chamber3 { { 29, 15 }, { 10, 10 } };
 	Rectangle hallway { { 1, 17 }, { 38, 6 } };
-	if (!HasChamber1) {
+	if (!hasChamber1) {
 		hallway.position.x += 17;
 		hallway.size.width -= 17;
 	}
-	if (!HasChamber3)
+	if (!hasChamber3)
 		hallway.size.width -= 16;
-	if (VerticalLayout) {
+	if (isVerticalLayout) {
 		std::swap(chamber1.position.x, chamber1.position.y);
 		std::swap(chamber3.position.x, chamber3.position.y);
 		std::swap(hallway.position.x, hallway.position.y);
 		std::swap(hallway.size.width, hallway.size.height);
 	}
 
-	if (HasChamber1)
-		MapRoom(chamber1);
-	if (HasChamber2)
-		MapRoom(chamber2);
-	if (HasChamber3)
-		MapRoom(chamber3);
-
-	MapRoom(hallway);
-
-	if (HasChamber1)
-		GenerateRoom(chamber1, VerticalLayout);
-	if (HasChamber2)
-		GenerateRoom(chamber2, VerticalLayout);
-	if (HasChamber3)
-		GenerateRoom(chamber3, VerticalLayout);
+	if (hasChamber1)
+		mapRoom(chamber1);
+	if (hasChamber2)
+		mapRoom(chamber2);
+	if (hasChamber3)
+		mapRoom(chamber3);
+
+	mapRoom(hallway);
+
+	if (hasChamber1)
+		generateRoom(chamber1, isVerticalLayout);
+	if (hasChamber2)
+		generateRoom(chamber2, isVerticalLayout);
+	if (hasChamber3)
+		generateRoom(chamber3, isVerticalLayout);
 }
 
 /**
  * @brief Find the number of mega tiles used by layout
  */
-inline size_t FindArea()
+size_t CathedralGenerator::findArea()
 {
-	return DungeonMask.count();
+	return dungeonMask.count();
 }
 
-void MakeDmt()
+void CathedralGenerator::makeDmt()
 {
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
-			if (DungeonMask.test(i, j))
-				dungeon[i][j] = Floor;
-			else if (!DungeonMask.test(i + 1, j + 1) && DungeonMask.test(i, j + 1) && DungeonMask.test(i + 1, j))
-				dungeon[i][j] = Floor; // Remove diagonal corners
-			else if (DungeonMask.test(i + 1, j + 1) && DungeonMask.test(i, j + 1) && DungeonMask.test(i + 1, j))
-				dungeon[i][j] = VCorner;
-			else if (DungeonMask.test(i, j + 1))
-				dungeon[i][j] = HWall;
-			else if (DungeonMask.test(i + 1, j))
-				dungeon[i][j] = VWall;
-			else if (DungeonMask.test(i + 1, j + 1))
-				dungeon[i][j] = DWall;
+			if (dungeonMask.test(i, j))
+				tiles[i][j] = Floor;
+			else if (!dungeonMask.test(i + 1, j + 1) && dungeonMask.test(i, j + 1) && dungeonMask.test(i + 1, j))
+				tiles[i][j] = Floor; // Remove diagonal corners
+			else if (dungeonMask.test(i + 1, j + 1) && dungeonMask.test(i, j + 1) && dungeonMask.test(i + 1, j))
+				tiles[i][j] = VCorner;
+			else if (dungeonMask.test(i, j + 1))
+				tiles[i][j] = HWall;
+			else if (dungeonMask.test(i + 1, j))
+				tiles[i][j] = VWall;
+			else if (dungeonMask.test(i + 1, j + 1))
+				tiles[i][j] = DWall;
 			else
-				dungeon[i][j] = Dirt;
+				tiles[i][j] = Dirt;
 		}
 	}
 }
 
-int HorizontalWallOk(Point position)
+int CathedralGenerator::horizontalWallOk(Point position)
 {
 	int length;
-	for (length = 1; dungeon[position.x + length][position.y] == Floor; length++) {
-		if (dungeon[position.x + length][position.y - 1] != Floor || dungeon[position.x + length][position.y + 1] != Floor || Protected.test(position.x + length, position.y) || Chamber.test(position.x + length, position.y))
+	for (length = 1; tiles[position.x + length][position.y] == Floor; length++) {
+		if (tiles[position.x + length][position.y - 1] != Floor || tiles[position.x + length][position.y + 1] != Floor || protectedTiles.test(position.x + length, position.y) || chamberTiles.test(position.x + length, position.y))
 			break;
 	}
 
 	if (length == 1)
 		return -1;
 
-	auto tileId = static_cast<Tile>(dungeon[position.x + length][position.y]);
+	auto tileId = static_cast<Tile>(tiles[position.x + length][position.y]);
 
 	if (!IsAnyOf(tileId, Corner, DWall, DArch, VWallEnd, HWallEnd, VCorner, HCorner, DirtHwall, DirtVwall, VDirtCorner, HDirtCorner, DirtHwallEnd, DirtVwallEnd))
 		return -1;
@@ -600,18 +751,18 @@ int HorizontalWallOk(Point position)
 	return length;
 }
 
-int VerticalWallOk(Point position)
+int CathedralGenerator::verticalWallOk(Point position)
 {
 	int length;
-	for (length = 1; dungeon[position.x][position.y + length] == Floor; length++) {
-		if (dungeon[position.x - 1][position.y + length] != Floor || dungeon[position.x + 1][position.y + length] != Floor || Protected.test(position.x, position.y + length) || Chamber.test(position.x, position.y + length))
+	for (length = 1; tiles[position.x][position.y + length] == Floor; length++) {
+		if (tiles[position.x - 1][position.y + length] != Floor || tiles[position.x + 1][position.y + length] != Floor || protectedTiles.test(position.x, position.y + length) || chamberTiles.test(position.x, position.y + length))
 			break;
 	}
 
 	if (length == 1)
 		return -1;
 
-	auto tileId = static_cast<Tile>(dungeon[position.x][position.y + length]);
+	auto tileId = static_cast<Tile>(tiles[position.x][position.y + length]);
 
 	if (!IsAnyOf(tileId, Corner, DWall, DArch, VWallEnd, HWallEnd, VCorner, HCorner, DirtHwall, DirtVwall, VDirtCorner, HDirtCorner, DirtHwallEnd, DirtVwallEnd))
 		return -1;
@@ -619,12 +770,12 @@ int VerticalWallOk(Point position)
 	return length;
 }
 
-void HorizontalWall(Point position, Tile start, int maxX)
+void CathedralGenerator::horizontalWall(Point position, Tile start, int maxX)
 {
 	Tile wallTile = HWall;
 	Tile doorTile = HDoor;
 
-	switch (GenerateRnd(4)) {
+	switch (generateRnd(4)) {
 	case 2: // Add arch
 		wallTile = HArch;
 		doorTile = HArch;
@@ -644,29 +795,29 @@ void HorizontalWall(Point position, Tile start, int maxX)
 		break;
 	}
 
-	if (GenerateRnd(6) == 5)
+	if (generateRnd(6) == 5)
 		doorTile = HArch;
 
-	dungeon[position.x][position.y] = start;
+	tiles[position.x][position.y] = start;
 
 	for (int x = 1; x < maxX; x++) {
-		dungeon[position.x + x][position.y] = wallTile;
+		tiles[position.x + x][position.y] = wallTile;
 	}
 
-	int x = GenerateRnd(maxX - 1) + 1;
+	int x = generateRnd(maxX - 1) + 1;
 
-	dungeon[position.x + x][position.y] = doorTile;
+	tiles[position.x + x][position.y] = doorTile;
 	if (doorTile == HDoor) {
-		Protected.set(position.x + x, position.y);
+		protectedTiles.set(position.x + x, position.y);
 	}
 }
 
-void VerticalWall(Point position, Tile start, int maxY)
+void CathedralGenerator::verticalWall(Point position, Tile start, int maxY)
 {
 	Tile wallTile = VWall;
 	Tile doorTile = VDoor;
 
-	switch (GenerateRnd(4)) {
+	switch (generateRnd(4)) {
 	case 2: // Add arch
 		wallTile = VArch;
 		doorTile = VArch;
@@ -686,148 +837,148 @@ void VerticalWall(Point position, Tile start, int maxY)
 		break;
 	}
 
-	if (GenerateRnd(6) == 5)
+	if (generateRnd(6) == 5)
 		doorTile = VArch;
 
-	dungeon[position.x][position.y] = start;
+	tiles[position.x][position.y] = start;
 
 	for (int y = 1; y < maxY; y++) {
-		dungeon[position.x][position.y + y] = wallTile;
+		tiles[position.x][position.y + y] = wallTile;
 	}
 
-	int y = GenerateRnd(maxY - 1) + 1;
+	int y = generateRnd(maxY - 1) + 1;
 
-	dungeon[position.x][position.y + y] = doorTile;
+	tiles[position.x][position.y + y] = doorTile;
 	if (doorTile == VDoor) {
-		Protected.set(position.x, position.y + y);
+		protectedTiles.set(position.x, position.y + y);
 	}
 }
 
-void AddWall()
+void CathedralGenerator::addWall()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (Protected.test(i, j) || Chamber.test(i, j))
+			if (protectedTiles.test(i, j) || chamberTiles.test(i, j))
 				continue;
 
-			if (dungeon[i][j] == Corner) {
-				DiscardRandomValues(1);
-				int maxX = HorizontalWallOk({ i, j });
+			if (tiles[i][j] == Corner) {
+				discardRandomValues(1);
+				int maxX = horizontalWallOk({ i, j });
 				if (maxX != -1) {
-					HorizontalWall({ i, j }, HWall, maxX);
+					horizontalWall({ i, j }, HWall, maxX);
 				}
 			}
-			if (dungeon[i][j] == Corner) {
-				DiscardRandomValues(1);
-				int maxY = VerticalWallOk({ i, j });
+			if (tiles[i][j] == Corner) {
+				discardRandomValues(1);
+				int maxY = verticalWallOk({ i, j });
 				if (maxY != -1) {
-					VerticalWall({ i, j }, VWall, maxY);
+					verticalWall({ i, j }, VWall, maxY);
 				}
 			}
-			if (dungeon[i][j] == VWallEnd) {
-				DiscardRandomValues(1);
-				int maxX = HorizontalWallOk({ i, j });
+			if (tiles[i][j] == VWallEnd) {
+				discardRandomValues(1);
+				int maxX = horizontalWallOk({ i, j });
 				if (maxX != -1) {
-					HorizontalWall({ i, j }, DWall, maxX);
+					horizontalWall({ i, j }, DWall, maxX);
 				}
 			}
-			if (dungeon[i][j] == HWallEnd) {
-				DiscardRandomValues(1);
-				int maxY = VerticalWallOk({ i, j });
+			if (tiles[i][j] == HWallEnd) {
+				discardRandomValues(1);
+				int maxY = verticalWallOk({ i, j });
 				if (maxY != -1) {
-					VerticalWall({ i, j }, DWall, maxY);
+					verticalWall({ i, j }, DWall, maxY);
 				}
 			}
-			if (dungeon[i][j] == HWall) {
-				DiscardRandomValues(1);
-				int maxX = HorizontalWallOk({ i, j });
+			if (tiles[i][j] == HWall) {
+				discardRandomValues(1);
+				int maxX = horizontalWallOk({ i, j });
 				if (maxX != -1) {
-					HorizontalWall({ i, j }, HWall, maxX);
+					horizontalWall({ i, j }, HWall, maxX);
 				}
 			}
-			if (dungeon[i][j] == VWall) {
-				DiscardRandomValues(1);
-				int maxY = VerticalWallOk({ i, j });
+			if (tiles[i][j] == VWall) {
+				discardRandomValues(1);
+				int maxY = verticalWallOk({ i, j });
 				if (maxY != -1) {
-					VerticalWall({ i, j }, VWall, maxY);
+					verticalWall({ i, j }, VWall, maxY);
 				}
 			}
 		}
 	}
 }
 
-void GenerateChamber(Point position, bool connectPrevious, bool connectNext, bool verticalLayout)
+void CathedralGenerator::generateChamber(Point position, bool connectPrevious, bool connectNext, bool verticalLayout)
 {
 	if (connectPrevious) {
 		if (verticalLayout) {
-			dungeon[position.x + 2][position.y] = HArch;
-			dungeon[position.x + 3][position.y] = HArch;
-			dungeon[position.x + 4][position.y] = Corner;
-			dungeon[position.x + 7][position.y] = VArchEnd;
-			dungeon[position.x + 8][position.y] = HArch;
-			dungeon[position.x + 9][position.y] = HWall;
+			tiles[position.x + 2][position.y] = HArch;
+			tiles[position.x + 3][position.y] = HArch;
+			tiles[position.x + 4][position.y] = Corner;
+			tiles[position.x + 7][position.y] = VArchEnd;
+			tiles[position.x + 8][position.y] = HArch;
+			tiles[position.x + 9][position.y] = HWall;
 		} else {
-			dungeon[position.x][position.y + 2] = VArch;
-			dungeon[position.x][position.y + 3] = VArch;
-			dungeon[position.x][position.y + 4] = Corner;
-			dungeon[position.x][position.y + 7] = HArchEnd;
-			dungeon[position.x][position.y + 8] = VArch;
-			dungeon[position.x][position.y + 9] = VWall;
+			tiles[position.x][position.y + 2] = VArch;
+			tiles[position.x][position.y + 3] = VArch;
+			tiles[position.x][position.y + 4] = Corner;
+			tiles[position.x][position.y + 7] = HArchEnd;
+			tiles[position.x][position.y + 8] = VArch;
+			tiles[position.x][position.y + 9] = VWall;
 		}
 	}
 	if (connectNext) {
 		if (verticalLayout) {
 			position.y += 11;
-			dungeon[position.x + 2][position.y] = HArchVWall;
-			dungeon[position.x + 3][position.y] = HArch;
-			dungeon[position.x + 4][position.y] = HArchEnd;
-			dungeon[position.x + 7][position.y] = DArch;
-			dungeon[position.x + 8][position.y] = HArch;
-			if (dungeon[position.x + 9][position.y] != DWall)
-				dungeon[position.x + 9][position.y] = HDirtCorner;
+			tiles[position.x + 2][position.y] = HArchVWall;
+			tiles[position.x + 3][position.y] = HArch;
+			tiles[position.x + 4][position.y] = HArchEnd;
+			tiles[position.x + 7][position.y] = DArch;
+			tiles[position.x + 8][position.y] = HArch;
+			if (tiles[position.x + 9][position.y] != DWall)
+				tiles[position.x + 9][position.y] = HDirtCorner;
 			position.y -= 11;
 		} else {
 			position.x += 11;
-			dungeon[position.x][position.y + 2] = HWallVArch;
-			dungeon[position.x][position.y + 3] = VArch;
-			dungeon[position.x][position.y + 4] = VArchEnd;
-			dungeon[position.x][position.y + 7] = DArch;
-			dungeon[position.x][position.y + 8] = VArch;
-			if (dungeon[position.x][position.y + 9] != DWall)
-				dungeon[position.x][position.y + 9] = HDirtCorner;
+			tiles[position.x][position.y + 2] = HWallVArch;
+			tiles[position.x][position.y + 3] = VArch;
+			tiles[position.x][position.y + 4] = VArchEnd;
+			tiles[position.x][position.y + 7] = DArch;
+			tiles[position.x][position.y + 8] = VArch;
+			if (tiles[position.x][position.y + 9] != DWall)
+				tiles[position.x][position.y + 9] = HDirtCorner;
 			position.x -= 11;
 		}
 	}
 
 	for (int y = 1; y < 11; y++) {
 		for (int x = 1; x < 11; x++) {
-			dungeon[position.x + x][position.y + y] = Floor;
-			Chamber.set(position.x + x, position.y + y);
+			tiles[position.x + x][position.y + y] = Floor;
+			chamberTiles.set(position.x + x, position.y + y);
 		}
 	}
 
-	dungeon[position.x + 4][position.y + 4] = Pillar;
-	dungeon[position.x + 7][position.y + 4] = Pillar;
-	dungeon[position.x + 4][position.y + 7] = Pillar;
-	dungeon[position.x + 7][position.y + 7] = Pillar;
+	tiles[position.x + 4][position.y + 4] = Pillar;
+	tiles[position.x + 7][position.y + 4] = Pillar;
+	tiles[position.x + 4][position.y + 7] = Pillar;
+	tiles[position.x + 7][position.y + 7] = Pillar;
 }
 
-void GenerateHall(Point start, int length, bool verticalLayout)
+void CathedralGenerator::generateHall(Point start, int length, bool verticalLayout)
 {
 	if (verticalLayout) {
 		for (int i = start.y; i < start.y + length; i++) {
-			dungeon[start.x][i] = VArch;
-			dungeon[start.x + 3][i] = VArch;
+			tiles[start.x][i] = VArch;
+			tiles[start.x + 3][i] = VArch;
 		}
 	} else {
 		for (int i = start.x; i < start.x + length; i++) {
-			dungeon[i][start.y] = HArch;
-			dungeon[i][start.y + 3] = HArch;
+			tiles[i][start.y] = HArch;
+			tiles[i][start.y + 3] = HArch;
 		}
 	}
 }
 
-void FixTilesPatterns()
+void CathedralGenerator::fixTilesPatterns()
 {
 	// BUGFIX: Bounds checks are required in all loop bodies.
 	// See https://github.com/diasurgical/devilutionX/pull/401
@@ -835,22 +986,22 @@ void FixTilesPatterns()
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
 			if (i + 1 < DMAXX) {
-				if (dungeon[i][j] == HWall && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = DirtHwallEnd;
-				if (dungeon[i][j] == Floor && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = DirtHwall;
-				if (dungeon[i][j] == Floor && dungeon[i + 1][j] == HWall)
-					dungeon[i + 1][j] = HWallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = DirtVwallEnd;
+				if (tiles[i][j] == HWall && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = DirtHwallEnd;
+				if (tiles[i][j] == Floor && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = DirtHwall;
+				if (tiles[i][j] == Floor && tiles[i + 1][j] == HWall)
+					tiles[i + 1][j] = HWallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = DirtVwallEnd;
 			}
 			if (j + 1 < DMAXY) {
-				if (dungeon[i][j] == VWall && dungeon[i][j + 1] == Dirt)
-					dungeon[i][j + 1] = DirtVwallEnd;
-				if (dungeon[i][j] == Floor && dungeon[i][j + 1] == VWall)
-					dungeon[i][j + 1] = VWallEnd;
-				if (dungeon[i][j] == Floor && dungeon[i][j + 1] == Dirt)
-					dungeon[i][j + 1] = DirtVwall;
+				if (tiles[i][j] == VWall && tiles[i][j + 1] == Dirt)
+					tiles[i][j + 1] = DirtVwallEnd;
+				if (tiles[i][j] == Floor && tiles[i][j + 1] == VWall)
+					tiles[i][j + 1] = VWallEnd;
+				if (tiles[i][j] == Floor && tiles[i][j + 1] == Dirt)
+					tiles[i][j + 1] = DirtVwall;
 			}
 		}
 	}
@@ -858,104 +1009,104 @@ void FixTilesPatterns()
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
 			if (i + 1 < DMAXX) {
-				if (dungeon[i][j] == Floor && dungeon[i + 1][j] == DirtVwall)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == Floor && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = VDirtCorner;
-				if (dungeon[i][j] == HWallEnd && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = DirtHwallEnd;
-				if (dungeon[i][j] == Floor && dungeon[i + 1][j] == DirtVwallEnd)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == DirtVwall && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = VDirtCorner;
-				if (dungeon[i][j] == HWall && dungeon[i + 1][j] == DirtVwall)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == DirtVwall && dungeon[i + 1][j] == VWall)
-					dungeon[i + 1][j] = VWallEnd;
-				if (dungeon[i][j] == HWallEnd && dungeon[i + 1][j] == DirtVwall)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == HWall && dungeon[i + 1][j] == VWall)
-					dungeon[i + 1][j] = VWallEnd;
-				if (dungeon[i][j] == Corner && dungeon[i + 1][j] == Dirt)
-					dungeon[i + 1][j] = DirtVwallEnd;
-				if (dungeon[i][j] == HDirtCorner && dungeon[i + 1][j] == VWall)
-					dungeon[i + 1][j] = VWallEnd;
-				if (dungeon[i][j] == HWallEnd && dungeon[i + 1][j] == VWall)
-					dungeon[i + 1][j] = VWallEnd;
-				if (dungeon[i][j] == HWallEnd && dungeon[i + 1][j] == DirtVwallEnd)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == DWall && dungeon[i + 1][j] == VCorner)
-					dungeon[i + 1][j] = HCorner;
-				if (dungeon[i][j] == HWallEnd && dungeon[i + 1][j] == Floor)
-					dungeon[i + 1][j] = HCorner;
-				if (dungeon[i][j] == HWall && dungeon[i + 1][j] == DirtVwallEnd)
-					dungeon[i + 1][j] = HDirtCorner;
-				if (dungeon[i][j] == HWall && dungeon[i + 1][j] == Floor)
-					dungeon[i + 1][j] = HCorner;
+				if (tiles[i][j] == Floor && tiles[i + 1][j] == DirtVwall)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == Floor && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = VDirtCorner;
+				if (tiles[i][j] == HWallEnd && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = DirtHwallEnd;
+				if (tiles[i][j] == Floor && tiles[i + 1][j] == DirtVwallEnd)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == DirtVwall && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = VDirtCorner;
+				if (tiles[i][j] == HWall && tiles[i + 1][j] == DirtVwall)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == DirtVwall && tiles[i + 1][j] == VWall)
+					tiles[i + 1][j] = VWallEnd;
+				if (tiles[i][j] == HWallEnd && tiles[i + 1][j] == DirtVwall)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == HWall && tiles[i + 1][j] == VWall)
+					tiles[i + 1][j] = VWallEnd;
+				if (tiles[i][j] == Corner && tiles[i + 1][j] == Dirt)
+					tiles[i + 1][j] = DirtVwallEnd;
+				if (tiles[i][j] == HDirtCorner && tiles[i + 1][j] == VWall)
+					tiles[i + 1][j] = VWallEnd;
+				if (tiles[i][j] == HWallEnd && tiles[i + 1][j] == VWall)
+					tiles[i + 1][j] = VWallEnd;
+				if (tiles[i][j] == HWallEnd && tiles[i + 1][j] == DirtVwallEnd)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == DWall && tiles[i + 1][j] == VCorner)
+					tiles[i + 1][j] = HCorner;
+				if (tiles[i][j] == HWallEnd && tiles[i + 1][j] == Floor)
+					tiles[i + 1][j] = HCorner;
+				if (tiles[i][j] == HWall && tiles[i + 1][j] == DirtVwallEnd)
+					tiles[i + 1][j] = HDirtCorner;
+				if (tiles[i][j] == HWall && tiles[i + 1][j] == Floor)
+					tiles[i + 1][j] = HCorner;
 			}
 			if (i > 0) {
-				if (dungeon[i][j] == DirtHwallEnd && dungeon[i - 1][j] == Dirt)
-					dungeon[i - 1][j] = DirtVwall;
-				if (dungeon[i][j] == DirtVwall && dungeon[i - 1][j] == DirtHwallEnd)
-					dungeon[i - 1][j] = HDirtCorner;
-				if (dungeon[i][j] == VWallEnd && dungeon[i - 1][j] == Dirt)
-					dungeon[i - 1][j] = DirtVwallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i - 1][j] == DirtHwallEnd)
-					dungeon[i - 1][j] = HDirtCorner;
+				if (tiles[i][j] == DirtHwallEnd && tiles[i - 1][j] == Dirt)
+					tiles[i - 1][j] = DirtVwall;
+				if (tiles[i][j] == DirtVwall && tiles[i - 1][j] == DirtHwallEnd)
+					tiles[i - 1][j] = HDirtCorner;
+				if (tiles[i][j] == VWallEnd && tiles[i - 1][j] == Dirt)
+					tiles[i - 1][j] = DirtVwallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i - 1][j] == DirtHwallEnd)
+					tiles[i - 1][j] = HDirtCorner;
 			}
 			if (j + 1 < DMAXY) {
-				if (dungeon[i][j] == VWall && dungeon[i][j + 1] == HWall)
-					dungeon[i][j + 1] = HWallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j + 1] == DirtHwall)
-					dungeon[i][j + 1] = HDirtCorner;
-				if (dungeon[i][j] == DirtHwall && dungeon[i][j + 1] == HWall)
-					dungeon[i][j + 1] = HWallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j + 1] == HWall)
-					dungeon[i][j + 1] = HWallEnd;
-				if (dungeon[i][j] == HDirtCorner && dungeon[i][j + 1] == HWall)
-					dungeon[i][j + 1] = HWallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j + 1] == Dirt)
-					dungeon[i][j + 1] = DirtVwallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j + 1] == Floor)
-					dungeon[i][j + 1] = VCorner;
-				if (dungeon[i][j] == VWall && dungeon[i][j + 1] == Floor)
-					dungeon[i][j + 1] = VCorner;
-				if (dungeon[i][j] == Floor && dungeon[i][j + 1] == VCorner)
-					dungeon[i][j + 1] = HCorner;
+				if (tiles[i][j] == VWall && tiles[i][j + 1] == HWall)
+					tiles[i][j + 1] = HWallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i][j + 1] == DirtHwall)
+					tiles[i][j + 1] = HDirtCorner;
+				if (tiles[i][j] == DirtHwall && tiles[i][j + 1] == HWall)
+					tiles[i][j + 1] = HWallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i][j + 1] == HWall)
+					tiles[i][j + 1] = HWallEnd;
+				if (tiles[i][j] == HDirtCorner && tiles[i][j + 1] == HWall)
+					tiles[i][j + 1] = HWallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i][j + 1] == Dirt)
+					tiles[i][j + 1] = DirtVwallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i][j + 1] == Floor)
+					tiles[i][j + 1] = VCorner;
+				if (tiles[i][j] == VWall && tiles[i][j + 1] == Floor)
+					tiles[i][j + 1] = VCorner;
+				if (tiles[i][j] == Floor && tiles[i][j + 1] == VCorner)
+					tiles[i][j + 1] = HCorner;
 			}
 			if (j > 0) {
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j - 1] == Dirt)
-					dungeon[i][j - 1] = HWallEnd;
-				if (dungeon[i][j] == VWallEnd && dungeon[i][j - 1] == Dirt)
-					dungeon[i][j - 1] = DirtVwallEnd;
-				if (dungeon[i][j] == HWallEnd && dungeon[i][j - 1] == DirtVwallEnd)
-					dungeon[i][j - 1] = HDirtCorner;
-				if (dungeon[i][j] == DirtHwall && dungeon[i][j - 1] == DirtVwallEnd)
-					dungeon[i][j - 1] = HDirtCorner;
+				if (tiles[i][j] == VWallEnd && tiles[i][j - 1] == Dirt)
+					tiles[i][j - 1] = HWallEnd;
+				if (tiles[i][j] == VWallEnd && tiles[i][j - 1] == Dirt)
+					tiles[i][j - 1] = DirtVwallEnd;
+				if (tiles[i][j] == HWallEnd && tiles[i][j - 1] == DirtVwallEnd)
+					tiles[i][j - 1] = HDirtCorner;
+				if (tiles[i][j] == DirtHwall && tiles[i][j - 1] == DirtVwallEnd)
+					tiles[i][j - 1] = HDirtCorner;
 			}
 		}
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (j + 1 < DMAXY && dungeon[i][j] == DWall && dungeon[i][j + 1] == HWall)
-				dungeon[i][j + 1] = HWallEnd;
-			if (i + 1 < DMAXX && dungeon[i][j] == HWall && dungeon[i + 1][j] == DirtVwall)
-				dungeon[i + 1][j] = HDirtCorner;
-			if (j + 1 < DMAXY && dungeon[i][j] == DirtHwall && dungeon[i][j + 1] == Dirt)
-				dungeon[i][j + 1] = VDirtCorner;
+			if (j + 1 < DMAXY && tiles[i][j] == DWall && tiles[i][j + 1] == HWall)
+				tiles[i][j + 1] = HWallEnd;
+			if (i + 1 < DMAXX && tiles[i][j] == HWall && tiles[i + 1][j] == DirtVwall)
+				tiles[i + 1][j] = HDirtCorner;
+			if (j + 1 < DMAXY && tiles[i][j] == DirtHwall && tiles[i][j + 1] == Dirt)
+				tiles[i][j + 1] = VDirtCorner;
 		}
 	}
 }
 
-void Substitution()
+void CathedralGenerator::substitution()
 {
 	for (int y = 0; y < DMAXY; y++) {
 		for (int x = 0; x < DMAXX; x++) {
-			if (FlipCoin(4)) {
-				uint8_t c = TileDecorations[dungeon[x][y]];
-				if (c != 0 && !Protected.test(x, y)) {
-					int rv = GenerateRnd(16);
+			if (flipCoin(4)) {
+				uint8_t c = TileDecorations[tiles[x][y]];
+				if (c != 0 && !protectedTiles.test(x, y)) {
+					int rv = generateRnd(16);
 					int i = -1;
 					while (rv >= 0) {
 						i++;
@@ -969,93 +1120,93 @@ void Substitution()
 
 					// BUGFIX: Add `&& y > 0` to the if statement. (fixed)
 					if (i == VWall4 && y > 0) {
-						if (TileDecorations[dungeon[x][y - 1]] != VWall2 || Protected.test(x, y - 1))
+						if (TileDecorations[tiles[x][y - 1]] != VWall2 || protectedTiles.test(x, y - 1))
 							i = VWall2;
 						else
-							dungeon[x][y - 1] = VWall5;
+							tiles[x][y - 1] = VWall5;
 					}
 					// BUGFIX: Add `&& x + 1 < DMAXX` to the if statement. (fixed)
 					if (i == HWall4 && x + 1 < DMAXX) {
-						if (TileDecorations[dungeon[x + 1][y]] != HWall2 || Protected.test(x + 1, y))
+						if (TileDecorations[tiles[x + 1][y]] != HWall2 || protectedTiles.test(x + 1, y))
 							i = HWall2;
 						else
-							dungeon[x + 1][y] = HWall5;
+							tiles[x + 1][y] = HWall5;
 					}
-					dungeon[x][y] = i;
+					tiles[x][y] = i;
 				}
 			}
 		}
 	}
 }
 
-void FillChambers()
+void CathedralGenerator::fillChambers()
 {
 	Point chamber1 { 0, 14 };
 	Point chamber3 { 28, 14 };
 	Point hall1 { 12, 18 };
 	Point hall2 { 26, 18 };
-	if (VerticalLayout) {
+	if (isVerticalLayout) {
 		std::swap(chamber1.x, chamber1.y);
 		std::swap(chamber3.x, chamber3.y);
 		std::swap(hall1.x, hall1.y);
 		std::swap(hall2.x, hall2.y);
 	}
 
-	if (HasChamber1)
-		GenerateChamber(chamber1, false, true, VerticalLayout);
-	if (HasChamber2)
-		GenerateChamber({ 14, 14 }, HasChamber1, HasChamber3, VerticalLayout);
-	if (HasChamber3)
-		GenerateChamber(chamber3, true, false, VerticalLayout);
-
-	if (HasChamber2) {
-		if (HasChamber1)
-			GenerateHall(hall1, 2, VerticalLayout);
-		if (HasChamber3)
-			GenerateHall(hall2, 2, VerticalLayout);
+	if (hasChamber1)
+		generateChamber(chamber1, false, true, isVerticalLayout);
+	if (hasChamber2)
+		generateChamber({ 14, 14 }, hasChamber1, hasChamber3, isVerticalLayout);
+	if (hasChamber3)
+		generateChamber(chamber3, true, false, isVerticalLayout);
+
+	if (hasChamber2) {
+		if (hasChamber1)
+			generateHall(hall1, 2, isVerticalLayout);
+		if (hasChamber3)
+			generateHall(hall2, 2, isVerticalLayout);
 	} else {
-		GenerateHall(hall1, 16, VerticalLayout);
+		generateHall(hall1, 16, isVerticalLayout);
 	}
 
-	if (leveltype == DTYPE_CRYPT) {
-		if (currlevel == 24) {
+	if (params.type == DTYPE_CRYPT) {
+		if (params.level == 24) {
 			SetCryptRoom();
 		} else if (CornerStone.isAvailable()) {
 			SetCornerRoom();
 		}
 	} else {
-		InitSetPiece();
+		initSetPiece();
 	}
 }
 
-void FixTransparency()
+void CathedralGenerator::fixTransparency()
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
 		int xx = 16;
 		for (int i = 0; i < DMAXX; i++) {
 			// BUGFIX: Should check for `j > 0` first. (fixed)
-			if (dungeon[i][j] == DirtHwallEnd && j > 0 && dungeon[i][j - 1] == DirtHwall) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (tiles[i][j] == DirtHwallEnd && j > 0 && tiles[i][j - 1] == DirtHwall) {
+				maps.transparency[xx + 1][yy] = maps.transparency[xx][yy];
+				maps.transparency[xx + 1][yy + 1] = maps.transparency[xx][yy];
 			}
 			// BUGFIX: Should check for `i + 1 < DMAXY` first. (fixed)
-			if (dungeon[i][j] == DirtVwallEnd && i + 1 < DMAXY && dungeon[i + 1][j] == DirtVwall) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (tiles[i][j] == DirtVwallEnd && i + 1 < DMAXY && tiles[i + 1][j] == DirtVwall) {
+				maps.transparency[xx][yy + 1] = maps.transparency[xx][yy];
+				maps.transparency[xx + 1][yy + 1] = maps.transparency[xx][yy];
 			}
-			if (dungeon[i][j] == DirtHwall) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (tiles[i][j] == DirtHwall) {
+				maps.transparency[xx + 1][yy] = maps.transparency[xx][yy];
+				maps.transparency[xx + 1][yy + 1] = maps.transparency[xx][yy];
 			}
-			if (dungeon[i][j] == DirtVwall) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (tiles[i][j] == DirtVwall) {
+				maps.transparency[xx][yy + 1] = maps.transparency[xx][yy];
+				maps.transparency[xx + 1][yy + 1] = maps.transparency[xx][yy];
 			}
-			if (dungeon[i][j] == VDirtCorner) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (tiles[i][j] == VDirtCorner) {
+				maps.transparency[xx + 1][yy] = maps.transparency[xx][yy];
+				maps.transparency[xx][yy + 1] = maps.transparency[xx][yy];
+				maps.transparency[xx + 1][yy + 1] = maps.transparency[xx][yy];
 			}
 			xx += 2;
 		}
@@ -1063,114 +1214,114 @@ void FixTransparency()
 	}
 }
 
-void FixDirtTiles()
+void CathedralGenerator::fixDirtTiles()
 {
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
-			if (dungeon[i][j] == HDirtCorner && dungeon[i + 1][j] != DirtVwall) {
-				dungeon[i][j] = DirtCorner2;
+			if (tiles[i][j] == HDirtCorner && tiles[i + 1][j] != DirtVwall) {
+				tiles[i][j] = DirtCorner2;
 			}
-			if (dungeon[i][j] == DirtVwall && dungeon[i + 1][j] != DirtVwall) {
-				dungeon[i][j] = DirtVWall2;
+			if (tiles[i][j] == DirtVwall && tiles[i + 1][j] != DirtVwall) {
+				tiles[i][j] = DirtVWall2;
 			}
-			if (dungeon[i][j] == DirtVwallEnd && dungeon[i + 1][j] != DirtVwall) {
-				dungeon[i][j] = DirtVWallEnd2;
+			if (tiles[i][j] == DirtVwallEnd && tiles[i + 1][j] != DirtVwall) {
+				tiles[i][j] = DirtVWallEnd2;
 			}
-			if (dungeon[i][j] == DirtHwall && dungeon[i][j + 1] != DirtHwall) {
-				dungeon[i][j] = DirtHWall2;
+			if (tiles[i][j] == DirtHwall && tiles[i][j + 1] != DirtHwall) {
+				tiles[i][j] = DirtHWall2;
 			}
-			if (dungeon[i][j] == HDirtCorner && dungeon[i][j + 1] != DirtHwall) {
-				dungeon[i][j] = DirtCorner2;
+			if (tiles[i][j] == HDirtCorner && tiles[i][j + 1] != DirtHwall) {
+				tiles[i][j] = DirtCorner2;
 			}
-			if (dungeon[i][j] == DirtHwallEnd && dungeon[i][j + 1] != DirtHwall) {
-				dungeon[i][j] = DirtHWallEnd2;
+			if (tiles[i][j] == DirtHwallEnd && tiles[i][j + 1] != DirtHwall) {
+				tiles[i][j] = DirtHWallEnd2;
 			}
 		}
 	}
 }
 
-void FixCornerTiles()
+void CathedralGenerator::fixCornerTiles()
 {
 	for (int j = 1; j < DMAXY - 1; j++) {
 		for (int i = 1; i < DMAXX - 1; i++) {
-			if (!Protected.test(i, j) && dungeon[i][j] == HCorner && dungeon[i - 1][j] == Floor && dungeon[i][j - 1] == VWall) {
-				dungeon[i][j] = VCorner;
+			if (!protectedTiles.test(i, j) && tiles[i][j] == HCorner && tiles[i - 1][j] == Floor && tiles[i][j - 1] == VWall) {
+				tiles[i][j] = VCorner;
 				// BUGFIX: Set tile as Protected
 			}
-			if (dungeon[i][j] == DirtCorner2 && dungeon[i + 1][j] == Floor && dungeon[i][j + 1] == VWall) {
-				dungeon[i][j] = HArchEnd;
+			if (tiles[i][j] == DirtCorner2 && tiles[i + 1][j] == Floor && tiles[i][j + 1] == VWall) {
+				tiles[i][j] = HArchEnd;
 			}
-			if (dungeon[i][j] == DirtCorner2 && dungeon[i][j + 1] == Floor && dungeon[i + 1][j] == HWall) {
-				dungeon[i][j] = VArchEnd;
+			if (tiles[i][j] == DirtCorner2 && tiles[i][j + 1] == Floor && tiles[i + 1][j] == HWall) {
+				tiles[i][j] = VArchEnd;
 			}
 		}
 	}
 }
 
-bool PlaceCathedralStairs(lvl_entry entry)
+bool CathedralGenerator::placeCathedralStairs(lvl_entry entry)
 {
 	bool success = true;
 	std::optional<Point> position;
 
 	// Place poison water entrance
-	if (Quests[Q_PWATER].IsAvailable()) {
-		position = PlaceMiniSet(PWATERIN, DMAXX * DMAXY, true);
+	if (params.poisonedWater) {
+		position = placeMiniSet(PWATERIN, DMAXX * DMAXY, true);
 		if (!position) {
 			success = false;
 		} else {
-			int8_t t = TransVal;
-			TransVal = 0;
+			int8_t t = maps.nextTransparency;
+			maps.nextTransparency = 0;
 			Point miniPosition = *position;
-			DRLG_MRectTrans({ miniPosition + Displacement { 0, 2 }, { 5, 2 } });
-			TransVal = t;
-			Quests[Q_PWATER].position = miniPosition.megaToWorld() + Displacement { 5, 6 };
+			DRLG_MRectTrans(maps, { miniPosition + Displacement { 0, 2 }, { 5, 2 } });
+			maps.nextTransparency = t;
+			poisonedWaterPosition = miniPosition.megaToWorld() + Displacement { 5, 6 };
 			if (entry == ENTRY_RTNLVL)
-				ViewPosition = Quests[Q_PWATER].position;
+				viewPosition = poisonedWaterPosition;
 		}
 	}
 
 	// Place stairs up
-	position = PlaceMiniSet(MyPlayer->pOriginalCathedral && !Quests[Q_LTBANNER].IsAvailable() ? L5STAIRSUP : STAIRSUP, DMAXX * DMAXY, true);
+	position = placeMiniSet(params.originalCathedral && !params.banner ? L5STAIRSUP : STAIRSUP, DMAXX * DMAXY, true);
 	if (!position) {
-		if (MyPlayer->pOriginalCathedral)
+		if (params.originalCathedral)
 			return false;
 		success = false;
 	} else if (entry == ENTRY_MAIN) {
-		ViewPosition = position->megaToWorld() + Displacement { 3, 4 };
+		viewPosition = position->megaToWorld() + Displacement { 3, 4 };
 	}
 
 	// Place stairs down
-	if (Quests[Q_LTBANNER].IsAvailable()) {
+	if (params.banner) {
 		if (entry == ENTRY_PREV)
-			ViewPosition = SetPiece.position.megaToWorld() + Displacement { 3, 11 };
+			viewPosition = setPiece.position.megaToWorld() + Displacement { 3, 11 };
 	} else {
-		position = PlaceMiniSet(STAIRSDOWN, DMAXX * DMAXY, true);
+		position = placeMiniSet(STAIRSDOWN, DMAXX * DMAXY, true);
 		if (!position) {
 			success = false;
 		} else if (entry == ENTRY_PREV) {
-			ViewPosition = position->megaToWorld() + Displacement { 3, 3 };
+			viewPosition = position->megaToWorld() + Displacement { 3, 3 };
 		}
 	}
 
 	return success;
 }
 
-bool PlaceStairs(lvl_entry entry)
+bool CathedralGenerator::placeStairs(lvl_entry entry)
 {
-	if (leveltype == DTYPE_CRYPT) {
+	if (params.type == DTYPE_CRYPT) {
 		return PlaceCryptStairs(entry);
 	}
 
-	return PlaceCathedralStairs(entry);
+	return placeCathedralStairs(entry);
 }
 
-void GenerateLevel(lvl_entry entry)
+void CathedralGenerator::generateLevel(lvl_entry entry)
 {
-	if (LevelSeeds[currlevel])
-		SetRndSeed(*LevelSeeds[currlevel]);
+	if (params.levelSeed)
+		seedEngine(*params.levelSeed);
 
 	size_t minarea = 761;
-	switch (currlevel) {
+	switch (params.level) {
 	case 1:
 		minarea = 533;
 		break;
@@ -1182,59 +1333,55 @@ void GenerateLevel(lvl_entry entry)
 	}
 
 	while (true) {
-		DRLG_InitTrans();
+		DRLG_InitTrans(maps);
 
 		do {
-			LevelSeeds[currlevel] = GetLCGEngineState();
-			FirstRoom();
-		} while (FindArea() < minarea);
-
-		InitDungeonFlags();
-		MakeDmt();
-		FillChambers();
-		FixTilesPatterns();
-		AddWall();
-		FloodTransparencyValues(13);
-		if (PlaceStairs(entry))
+			levelSeed = engineState();
+			firstRoom();
+		} while (findArea() < minarea);
+
+		initDungeonFlags();
+		makeDmt();
+		fillChambers();
+		fixTilesPatterns();
+		addWall();
+		FloodTransparencyValues(maps, 13);
+		if (placeStairs(entry))
 			break;
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == EntranceStairs) {
+			if (tiles[i][j] == EntranceStairs) {
 				int xx = 2 * i + 16; /* todo: fix loop */
 				int yy = 2 * j + 16;
-				DRLG_CopyTrans(xx, yy + 1, xx, yy);
-				DRLG_CopyTrans(xx + 1, yy + 1, xx + 1, yy);
+				DRLG_CopyTrans(maps, xx, yy + 1, xx, yy);
+				DRLG_CopyTrans(maps, xx + 1, yy + 1, xx + 1, yy);
 			}
 		}
 	}
 
-	FixTransparency();
-	if (leveltype == DTYPE_CRYPT) {
+	fixTransparency();
+	if (params.type == DTYPE_CRYPT) {
 		FixCryptDirtTiles();
 	} else {
-		FixDirtTiles();
+		fixDirtTiles();
 	}
-	FixCornerTiles();
+	fixCornerTiles();
 
-	if (leveltype == DTYPE_CRYPT) {
+	if (params.type == DTYPE_CRYPT) {
 		CryptSubstitution();
 	} else {
-		Substitution();
-		ApplyShadowsPatterns();
+		substitution();
+		applyShadowsPatterns();
 
-		int numt = GenerateRnd(5) + 5;
+		int numt = generateRnd(5) + 5;
 		for (int i = 0; i < numt; i++) {
-			PlaceMiniSet(LAMPS, DMAXX * DMAXY, true);
+			placeMiniSet(LAMPS, DMAXX * DMAXY, true);
 		}
 
-		FillFloor();
+		fillFloor();
 	}
-
-	memcpy(pdungeon, dungeon, sizeof(pdungeon));
-
-	DRLG_CheckQuests(SetPiece.position);
 }
 
 void Pass3()
@@ -1270,30 +1417,72 @@ void PlaceMiniSetRandom(const Miniset &miniset, int rndper)
 
 WorldTilePosition SelectChamber()
 {
-	int chamber;
-	if (HasChamber1 && HasChamber2 && HasChamber3) {
-		chamber = GenerateRnd(3) + 1;
-	} else if (HasChamber1 && HasChamber2) {
-		chamber = PickRandomlyAmong({ 2, 1 }); // Reverse order to match vanilla
-	} else if (HasChamber1 && HasChamber3) {
-		chamber = PickRandomlyAmong({ 3, 1 }); // Reverse order to match vanilla
-	} else if (HasChamber2 && HasChamber3) {
-		chamber = PickRandomlyAmong({ 2, 3 });
-	} else {
-		// The dungeon generation logic ensures that chamber 2 is available if
-		// either (or both of) 1 or 3 aren't, so if we ever end up with a single
-		// chamber layout it's always chamber 2.
-		chamber = 2;
-	}
+	return ActiveGenerator->selectChamber();
+}
 
-	switch (chamber) {
-	case 1:
-		return VerticalLayout ? WorldTilePosition { 16, 2 } : WorldTilePosition { 2, 16 };
-	case 3:
-		return VerticalLayout ? WorldTilePosition { 16, 30 } : WorldTilePosition { 30, 16 };
-	default:
-		return { 16, 16 };
+CathedralLevelParams GetCathedralLevelParams(uint8_t level)
+{
+	CathedralLevelParams params;
+	params.level = level;
+	params.type = GetLevelType(level);
+	params.levelSeed = LevelSeeds[level];
+	params.butcher = Quests[Q_BUTCHER].IsAvailableOn(level);
+	params.skeletonKing = Quests[Q_SKELKING].IsAvailableOn(level) && !UseMultiplayerQuests();
+	params.banner = Quests[Q_LTBANNER].IsAvailableOn(level);
+	params.poisonedWater = Quests[Q_PWATER].IsAvailableOn(level);
+	params.originalCathedral = MyPlayer->pOriginalCathedral;
+	if (params.type == DTYPE_CATHEDRAL) {
+		if (params.butcher) {
+			params.setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\rnd6.dun");
+		} else if (params.skeletonKing) {
+			params.setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\skngdo.dun");
+		} else if (params.banner) {
+			params.setPieceData = LoadFileInMem<uint16_t>("levels\\l1data\\banner2.dun");
+		}
 	}
+	return params;
+}
+
+void GenerateCathedralLevel(const CathedralLevelParams &params, uint32_t rseed, lvl_entry entry, CathedralLevel &level)
+{
+	assert(params.type == DTYPE_CATHEDRAL);
+
+	const WorldTileRectangle noSetPieceRoom { { 0, 0 }, { 0, 0 } };
+	const DungeonMaps maps { level.dungeon, level.protectedTiles, level.transparency, level.nextTransparency, noSetPieceRoom };
+	level.setPiece = { { 0, 0 }, { 0, 0 } };
+
+	DiabloGenerator rng(rseed);
+	CathedralGenerator generator(maps, level.setPiece, params, &rng);
+	generator.generateLevel(entry);
+
+	level.levelSeed = generator.levelSeed;
+	level.engineState = rng.engineState();
+	level.viewPosition = generator.viewPosition;
+	level.poisonedWaterPosition = generator.poisonedWaterPosition;
+}
+
+void LoadCathedralLevel(const CathedralLevel &level)
+{
+	memcpy(dungeon, level.dungeon, sizeof(dungeon));
+	Protected = level.protectedTiles;
+	memcpy(dTransVal, level.transparency, sizeof(dTransVal));
+	TransVal = level.nextTransparency;
+	TransList = {};
+	SetPiece = level.setPiece;
+	LevelSeeds[currlevel] = level.levelSeed;
+	if (level.viewPosition)
+		ViewPosition = *level.viewPosition;
+	if (level.poisonedWaterPosition)
+		Quests[Q_PWATER].position = *level.poisonedWaterPosition;
+	SetRndSeed(level.engineState);
+
+	UberRow = 0;
+	UberCol = 0;
+
+	memcpy(pdungeon, dungeon, sizeof(pdungeon));
+	DRLG_CheckQuests(SetPiece.position);
+
+	Pass3();
 }
 
 void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
@@ -1303,7 +1492,20 @@ void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
 	UberRow = 0;
 	UberCol = 0;
 
-	GenerateLevel(entry);
+	const CathedralLevelParams params = GetCathedralLevelParams(currlevel);
+	CathedralGenerator generator(GlobalDungeonMaps(), SetPiece, params, nullptr);
+	ActiveGenerator = &generator;
+	generator.generateLevel(entry);
+	ActiveGenerator = nullptr;
+
+	LevelSeeds[currlevel] = generator.levelSeed;
+	if (generator.viewPosition)
+		ViewPosition = *generator.viewPosition;
+	if (generator.poisonedWaterPosition)
+		Quests[Q_PWATER].position = *generator.poisonedWaterPosition;
+
+	memcpy(pdungeon, dungeon, sizeof(pdungeon));
+	DRLG_CheckQuests(SetPiece.position);
 
 	Pass3();
 
@@ -1315,13 +1517,15 @@ void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
 
 void LoadPreL1Dungeon(const char *path)
 {
-	InitDungeonFlags();
+	const CathedralLevelParams params;
+	CathedralGenerator generator(GlobalDungeonMaps(), SetPiece, params, nullptr);
+	generator.initDungeonFlags();
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 	PlaceDunTiles(dunData.get(), { 0, 0 }, Floor);
 
 	if (setlvltype == DTYPE_CATHEDRAL)
-		FillFloor();
+		generator.fillFloor();
 
 	memcpy(pdungeon, dungeon, sizeof(pdungeon));
 }
@@ -1330,8 +1534,11 @@ void LoadL1Dungeon(const char *path, Point spawn)
 {
 	LoadDungeonBase(path, spawn, Floor, Dirt);
 
-	if (setlvltype == DTYPE_CATHEDRAL)
-		FillFloor();
+	if (setlvltype == DTYPE_CATHEDRAL) {
+		const CathedralLevelParams params;
+		CathedralGenerator generator(GlobalDungeonMaps(), SetPiece, params, nullptr);
+		generator.fillFloor();
+	}
 
 	Pass3();
 
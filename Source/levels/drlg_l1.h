@@ -6,14 +6,76 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <optional>
 
+#include "engine/point.hpp"
 #include "engine/world_tile.hpp"
 #include "levels/gendung.h"
+#include "utils/bitset2d.hpp"
 
 namespace devilution {
 
+/**
+ * @brief What generating a Cathedral level needs to know about the game, see GetCathedralLevelParams()
+ */
+struct CathedralLevelParams {
+	uint8_t level = 0;
+	dungeon_type type = DTYPE_CATHEDRAL;
+	/** Engine state to generate from if the level was generated before, see LevelSeeds */
+	std::optional<uint32_t> levelSeed;
+	/** Place the Butcher's room */
+	bool butcher = false;
+	/** Place the entrance to King Leoric's tomb */
+	bool skeletonKing = false;
+	/** Place the room with Ogden's sign */
+	bool banner = false;
+	/** Place the entrance to the Poisoned Water Supply */
+	bool poisonedWater = false;
+	/** Use the stairs of the original Cathedral, see Player::pOriginalCathedral */
+	bool originalCathedral = true;
+	/** Quest room placed in one of the chambers, loaded up front since assets can only be read on the main thread */
+	std::unique_ptr<uint16_t[]> setPieceData;
+};
+
+/**
+ * @brief A Cathedral level generated by GenerateCathedralLevel()
+ */
+struct CathedralLevel {
+	uint8_t dungeon[DMAXX][DMAXY];
+	Bitset2d<DMAXX, DMAXY> protectedTiles;
+	int8_t transparency[MAXDUNX][MAXDUNY];
+	int8_t nextTransparency;
+	WorldTileRectangle setPiece;
+	/** Engine state the level was generated from, see LevelSeeds */
+	uint32_t levelSeed;
+	/** Engine state after generating the level */
+	uint32_t engineState;
+	std::optional<Point> viewPosition;
+	std::optional<Point> poisonedWaterPosition;
+};
+
 void PlaceMiniSetRandom(const Miniset &miniset, int rndper);
 WorldTilePosition SelectChamber();
+/**
+ * @brief Collects the game state that generating the given Cathedral level depends on
+ *
+ * Reads the quests, LevelSeeds and MyPlayer and loads the set piece, so call it on the main thread.
+ */
+CathedralLevelParams GetCathedralLevelParams(uint8_t level);
+/**
+ * @brief Generates a Cathedral level without touching the level globals or the global RNG
+ *
+ * Generates the same level as CreateL5Dungeon() with the same inputs. Several levels can be generated at once on
+ * different threads. Crypt levels are not supported.
+ */
+void GenerateCathedralLevel(const CathedralLevelParams &params, uint32_t rseed, lvl_entry entry, CathedralLevel &level);
+/**
+ * @brief Makes a level from GenerateCathedralLevel() the current level
+ *
+ * Leaves the level globals and the global RNG as CreateL5Dungeon() would have. currlevel must be the generated level.
+ */
+void LoadCathedralLevel(const CathedralLevel &level);
 void CreateL5Dungeon(uint32_t rseed, lvl_entry entry);
 void LoadPreL1Dungeon(const char *path);
 void LoadL1Dungeon(const char *path, Point spawn);
@@ -242,7 +242,7 @@ void CreateThemeRoom(int themeIndex)
 	}
 }
 
-bool IsFloor(Point p, uint8_t floorID)
+bool IsFloor(const DungeonMaps &maps, Point p, uint8_t floorID)
 {
 	int i = (p.x - 16) / 2;
 	int j = (p.y - 16) / 2;
@@ -250,10 +250,10 @@ bool IsFloor(Point p, uint8_t floorID)
 		return false;
 	if (j < 0 || j >= DMAXY)
 		return false;
-	return dungeon[i][j] == floorID;
+	return maps.tiles[i][j] == floorID;
 }
 
-void FillTransparencyValues(Point floor, uint8_t floorID)
+void FillTransparencyValues(const DungeonMaps &maps, Point floor, uint8_t floorID)
 {
 	Direction allDirections[] = {
 		Direction::North,
@@ -270,14 +270,14 @@ void FillTransparencyValues(Point floor, uint8_t floorID)
 	// because they would otherwise not be visited by the span filling algorithm
 	for (Direction dir : allDirections) {
 		Point adjacent = floor + dir;
-		if (!IsFloor(adjacent, floorID))
-			dTransVal[adjacent.x][adjacent.y] = TransVal;
+		if (!IsFloor(maps, adjacent, floorID))
+			maps.transparency[adjacent.x][adjacent.y] = maps.nextTransparency;
 	}
 
-	dTransVal[floor.x][floor.y] = TransVal;
+	maps.transparency[floor.x][floor.y] = maps.nextTransparency;
 }
 
-void FindTransparencyValues(Point floor, uint8_t floorID)
+void FindTransparencyValues(const DungeonMaps &maps, Point floor, uint8_t floorID)
 {
 	// Algorithm adapted from https://en.wikipedia.org/wiki/Flood_fill#Span_Filling
 	// Modified to include diagonally adjacent tiles that would otherwise not be visited
@@ -291,14 +291,14 @@ void FindTransparencyValues(Point floor, uint8_t floorID)
 	std::stack<Seed, std::vector<Seed>> seedStack;
 	seedStack.push({ floor.x, floor.x + 1, floor.y, 1 });
 
-	const auto isInside = [floorID](int x, int y) {
-		if (dTransVal[x][y] != 0)
+	const auto isInside = [&maps, floorID](int x, int y) {
+		if (maps.transparency[x][y] != 0)
 			return false;
-		return IsFloor({ x, y }, floorID);
+		return IsFloor(maps, { x, y }, floorID);
 	};
 
-	const auto set = [floorID](int x, int y) {
-		FillTransparencyValues({ x, y }, floorID);
+	const auto set = [&maps, floorID](int x, int y) {
+		FillTransparencyValues(maps, { x, y }, floorID);
 	};
 
 	const Displacement left = { -1, 0 };
@@ -557,28 +557,43 @@ void SetDungeonMicros()
 
 void DRLG_InitTrans()
 {
-	memset(dTransVal, 0, sizeof(dTransVal));
+	DRLG_InitTrans(GlobalDungeonMaps());
 	TransList = {}; // TODO duplicate reset in InitLighting()
-	TransVal = 1;
+}
+
+void DRLG_InitTrans(const DungeonMaps &maps)
+{
+	memset(maps.transparency, 0, sizeof(maps.transparency));
+	maps.nextTransparency = 1;
 }
 
 void DRLG_RectTrans(WorldTileRectangle area)
+{
+	DRLG_RectTrans(GlobalDungeonMaps(), area);
+}
+
+void DRLG_RectTrans(const DungeonMaps &maps, WorldTileRectangle area)
 {
 	WorldTilePosition position = area.position;
 	WorldTileSize size = area.size;
 
 	for (int j = position.y; j <= position.y + size.height; j++) {
 		for (int i = position.x; i <= position.x + size.width; i++) {
-			dTransVal[i][j] = TransVal;
+			maps.transparency[i][j] = maps.nextTransparency;
 		}
 	}
 
-	TransVal++;
+	maps.nextTransparency++;
 }
 
 void DRLG_MRectTrans(WorldTileRectangle area)
 {
-	DRLG_RectTrans({ area.position.megaToWorld() + WorldTileDisplacement { 1, 1 }, area.size * 2 - 1 });
+	DRLG_MRectTrans(GlobalDungeonMaps(), area);
+}
+
+void DRLG_MRectTrans(const DungeonMaps &maps, WorldTileRectangle area)
+{
+	DRLG_RectTrans(maps, { area.position.megaToWorld() + WorldTileDisplacement { 1, 1 }, area.size * 2 - 1 });
 }
 
 void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent)
@@ -588,7 +603,12 @@ void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent)
 
 void DRLG_CopyTrans(int sx, int sy, int dx, int dy)
 {
-	dTransVal[dx][dy] = dTransVal[sx][sy];
+	DRLG_CopyTrans(GlobalDungeonMaps(), sx, sy, dx, dy);
+}
+
+void DRLG_CopyTrans(const DungeonMaps &maps, int sx, int sy, int dx, int dy)
+{
+	maps.transparency[dx][dy] = maps.transparency[sx][sy];
 }
 
 void LoadTransparency(const uint16_t *dunData)
@@ -645,6 +665,15 @@ std::optional<Point> PlaceMiniSet(const Miniset &miniset, int tries, bool drlg1Q
 	int sh = miniset.size.height;
 	Point position { GenerateRnd(DMAXX - sw), GenerateRnd(DMAXY - sh) };
 
+	return PlaceMiniSet(GlobalDungeonMaps(), miniset, position, tries, drlg1Quirk);
+}
+
+std::optional<Point> PlaceMiniSet(const DungeonMaps &maps, const Miniset &miniset, Point start, int tries, bool drlg1Quirk)
+{
+	int sw = miniset.size.width;
+	int sh = miniset.size.height;
+	Point position = start;
+
 	for (int i = 0; i < tries; i++, position.x++) {
 		if (position.x == DMAXX - sw) {
 			position.x = 0;
@@ -670,12 +699,12 @@ std::optional<Point> PlaceMiniSet(const Miniset &miniset, int tries, bool drlg1Q
 			}
 		}
 
-		if (SetPieceRoom.contains(position))
+		if (maps.setPieceRoom.contains(position))
 			continue;
-		if (!miniset.matches(position))
+		if (!miniset.matches(maps, position))
 			continue;
 
-		miniset.place(position);
+		miniset.place(maps, position);
 
 		return position;
 	}
@@ -684,6 +713,11 @@ std::optional<Point> PlaceMiniSet(const Miniset &miniset, int tries, bool drlg1Q
 }
 
 void PlaceDunTiles(const uint16_t *dunData, Point position, int floorId)
+{
+	PlaceDunTiles(GlobalDungeonMaps(), dunData, position, floorId);
+}
+
+void PlaceDunTiles(const DungeonMaps &maps, const uint16_t *dunData, Point position, int floorId)
 {
 	WorldTileSize size = GetDunSize(dunData);
 
@@ -693,10 +727,10 @@ void PlaceDunTiles(const uint16_t *dunData, Point position, int floorId)
 		for (WorldTileCoord i = 0; i < size.width; i++) {
 			auto tileId = static_cast<uint8_t>(SDL_SwapLE16(tileLayer[j * size.width + i]));
 			if (tileId != 0) {
-				dungeon[position.x + i][position.y + j] = tileId;
-				Protected.set(position.x + i, position.y + j);
+				maps.tiles[position.x + i][position.y + j] = tileId;
+				maps.protectedTiles.set(position.x + i, position.y + j);
 			} else if (floorId != 0) {
-				dungeon[position.x + i][position.y + j] = floorId;
+				maps.tiles[position.x + i][position.y + j] = floorId;
 			}
 		}
 	}
@@ -814,14 +848,19 @@ void InitLevels()
 }
 
 void FloodTransparencyValues(uint8_t floorID)
+{
+	FloodTransparencyValues(GlobalDungeonMaps(), floorID);
+}
+
+void FloodTransparencyValues(const DungeonMaps &maps, uint8_t floorID)
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
 		int xx = 16;
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == floorID && dTransVal[xx][yy] == 0) {
-				FindTransparencyValues({ xx, yy }, floorID);
-				TransVal++;
+			if (maps.tiles[i][j] == floorID && maps.transparency[xx][yy] == 0) {
+				FindTransparencyValues(maps, { xx, yy }, floorID);
+				maps.nextTransparency++;
 			}
 			xx += 2;
 		}
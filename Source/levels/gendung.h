@@ -284,6 +284,30 @@ constexpr bool IsTileLit(Point position)
 	return InDungeonBounds(position) && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::Lit);
 }
 
+/**
+ * @brief The maps that the shared generation helpers read and write.
+ *
+ * The helpers that don't take one work on the level globals, see GlobalDungeonMaps(). A generator that builds a level
+ * in its own storage passes its maps instead, so it can run while another level is being generated or played.
+ */
+struct DungeonMaps {
+	/** Tile IDs, see dungeon */
+	uint8_t (&tiles)[DMAXX][DMAXY];
+	/** Tiles the generator may not overwrite, see Protected */
+	Bitset2d<DMAXX, DMAXY> &protectedTiles;
+	/** Transparency index of each dPiece coordinate, see dTransVal */
+	int8_t (&transparency)[MAXDUNX][MAXDUNY];
+	/** Next transparency index to hand out, see TransVal */
+	int8_t &nextTransparency;
+	/** Area that PlaceMiniSet keeps clear, see SetPieceRoom */
+	const WorldTileRectangle &setPieceRoom;
+};
+
+DVL_ALWAYS_INLINE DungeonMaps GlobalDungeonMaps()
+{
+	return { dungeon, Protected, dTransVal, TransVal, SetPieceRoom };
+}
+
 struct Miniset {
 	WorldTileSize size;
 	/* these are indexed as [y][x] */
@@ -291,34 +315,49 @@ struct Miniset {
 	uint8_t replace[6][6];
 
 	/**
+	 * @param maps Maps to check
 	 * @param position Coordinates of the dungeon tile to check
 	 * @param respectProtected Match bug from Crypt levels if false
 	 */
-	bool matches(WorldTilePosition position, bool respectProtected = true) const
+	bool matches(const DungeonMaps &maps, WorldTilePosition position, bool respectProtected = true) const
 	{
 		for (WorldTileCoord yy = 0; yy < size.height; yy++) {
 			for (WorldTileCoord xx = 0; xx < size.width; xx++) {
-				if (search[yy][xx] != 0 && dungeon[xx + position.x][yy + position.y] != search[yy][xx])
+				if (search[yy][xx] != 0 && maps.tiles[xx + position.x][yy + position.y] != search[yy][xx])
 					return false;
-				if (respectProtected && Protected.test(xx + position.x, yy + position.y))
+				if (respectProtected && maps.protectedTiles.test(xx + position.x, yy + position.y))
 					return false;
 			}
 		}
 		return true;
 	}
 
-	void place(WorldTilePosition position, bool protect = false) const
+	/**
+	 * @param position Coordinates of the dungeon tile to check
+	 * @param respectProtected Match bug from Crypt levels if false
+	 */
+	bool matches(WorldTilePosition position, bool respectProtected = true) const
+	{
+		return matches(GlobalDungeonMaps(), position, respectProtected);
+	}
+
+	void place(const DungeonMaps &maps, WorldTilePosition position, bool protect = false) const
 	{
 		for (WorldTileCoord y = 0; y < size.height; y++) {
 			for (WorldTileCoord x = 0; x < size.width; x++) {
 				if (replace[y][x] == 0)
 					continue;
-				dungeon[x + position.x][y + position.y] = replace[y][x];
+				maps.tiles[x + position.x][y + position.y] = replace[y][x];
 				if (protect)
-					Protected.set(x + position.x, y + position.y);
+					maps.protectedTiles.set(x + position.x, y + position.y);
 			}
 		}
 	}
+
+	void place(WorldTilePosition position, bool protect = false) const
+	{
+		place(GlobalDungeonMaps(), position, protect);
+	}
 };
 
 [[nodiscard]] DVL_ALWAYS_INLINE bool TileHasAny(Point coords, TileProperties property)
@@ -329,10 +368,14 @@ struct Miniset {
 tl::expected<void, std::string> LoadLevelSOLData();
 void SetDungeonMicros();
 void DRLG_InitTrans();
+void DRLG_InitTrans(const DungeonMaps &maps);
 void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent);
 void DRLG_MRectTrans(WorldTileRectangle area);
+void DRLG_MRectTrans(const DungeonMaps &maps, WorldTileRectangle area);
 void DRLG_RectTrans(WorldTileRectangle area);
+void DRLG_RectTrans(const DungeonMaps &maps, WorldTileRectangle area);
 void DRLG_CopyTrans(int sx, int sy, int dx, int dy);
+void DRLG_CopyTrans(const DungeonMaps &maps, int sx, int sy, int dx, int dy);
 void LoadTransparency(const uint16_t *dunData);
 void LoadDungeonBase(const char *path, Point spawn, int floorId, int dirtId);
 void Make_SetPC(WorldTileRectangle area);
@@ -342,7 +385,17 @@ void Make_SetPC(WorldTileRectangle area);
  * @param drlg1Quirk Match buggy behaviour of Diablo's Cathedral
  */
 std::optional<Point> PlaceMiniSet(const Miniset &miniset, int tries = 199, bool drlg1Quirk = false);
+/**
+ * @brief Same as PlaceMiniSet(const Miniset &, int, bool), but starts the search at the given tile instead of a random one
+ * @param maps The maps to place the miniset in
+ * @param miniset The miniset to place
+ * @param start First tile to try
+ * @param tries Tiles to try, 1600 will scan the full map
+ * @param drlg1Quirk Match buggy behaviour of Diablo's Cathedral
+ */
+std::optional<Point> PlaceMiniSet(const DungeonMaps &maps, const Miniset &miniset, Point start, int tries, bool drlg1Quirk);
 void PlaceDunTiles(const uint16_t *dunData, Point position, int floorId = 0);
+void PlaceDunTiles(const DungeonMaps &maps, const uint16_t *dunData, Point position, int floorId = 0);
 void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize);
 void DRLG_HoldThemeRooms();
 /**
@@ -359,6 +412,7 @@ void DRLG_LPass3(int lv);
 bool IsNearThemeRoom(WorldTilePosition position);
 void InitLevels();
 void FloodTransparencyValues(uint8_t floorID);
+void FloodTransparencyValues(const DungeonMaps &maps, uint8_t floorID);
 
 DVL_ALWAYS_INLINE const uint8_t *GetDunFrame(uint32_t frame)
 {
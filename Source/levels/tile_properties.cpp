@@ -8,6 +8,8 @@
 
 namespace devilution {
 
+static_assert(PathSearchGridSize == MAXDUNX && PathSearchGridSize == MAXDUNY, "Paths are searched on a grid the size of the dungeon");
+
 bool IsTileNotSolid(Point position)
 {
 	if (!InDungeonBounds(position)) {
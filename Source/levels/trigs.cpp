@@ -14,6 +14,7 @@
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
 #include "cursor.h"
+#include "diablo.h"
 #include "diablo_msg.hpp"
 #include "game_mode.hpp"
 #include "multi.h"
@@ -66,11 +67,56 @@ const uint16_t L5DownList[] = { 124, 125, 128, 130, 131, 134, 135, 139, 141 };
 const uint16_t L6TWarpUpList[] = { 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91 };
 const uint16_t L6UpList[] = { 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77 };
 const uint16_t L6DownList[] = { 56, 57, 58, 59, 60, 61, 62, 63 };
+
+/** Stairs closer than this many tiles start reading the tiles of the level they lead to. */
+constexpr int PrefetchTriggerDistance = 6;
+/** The level type last passed to PrefetchLevelGraphics, to only request its tiles once. */
+dungeon_type LastPrefetchedLevelType = DTYPE_NONE;
+
+dungeon_type GetTriggerDestinationLevelType(const TriggerStruct &trigger)
+{
+	switch (trigger._tmsg) {
+	case WM_DIABNEXTLVL:
+		return GetLevelType(currlevel + 1);
+	case WM_DIABPREVLVL:
+		return GetLevelType(currlevel - 1);
+	case WM_DIABTOWNWARP:
+		return GetLevelType(trigger._tlvl);
+	case WM_DIABTWARPUP:
+		return DTYPE_TOWN;
+	default:
+		// Set levels have their own tiles, quest maps are loaded on top of them.
+		return DTYPE_NONE;
+	}
+}
+
+/** @brief Reads the tiles of the level behind nearby stairs in the background, so taking them is quicker. */
+void PrefetchNearbyTriggerDestinations(const Player &player)
+{
+	if (setlevel)
+		return;
+	for (int i = 0; i < numtrigs; i++) {
+		if (player.position.tile.WalkingDistance(trigs[i].position) > PrefetchTriggerDistance)
+			continue;
+		const dungeon_type type = GetTriggerDestinationLevelType(trigs[i]);
+		if (type == DTYPE_NONE || type == leveltype || type == LastPrefetchedLevelType)
+			continue;
+		LastPrefetchedLevelType = type;
+		PrefetchLevelGraphics(type);
+	}
+}
+
+/** @brief Resets the triggers when a level is entered, its stairs may lead to a level type whose prefetched tiles are gone. */
+void ClearTriggers()
+{
+	numtrigs = 0;
+	LastPrefetchedLevelType = DTYPE_NONE;
+}
 } // namespace
 
 void InitNoTriggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	trigflag = false;
 }
 
@@ -109,7 +155,7 @@ bool IsWarpOpen(dungeon_type type)
 
 void InitTownTriggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 
 	// Cathedral
 	trigs[numtrigs].position = { 25, 29 };
@@ -152,7 +198,7 @@ void InitTownTriggers()
 
 void InitL1Triggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 128) {
@@ -172,7 +218,7 @@ void InitL1Triggers()
 
 void InitL2Triggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 266 && (!Quests[Q_SCHAMB].IsAvailable() || i != Quests[Q_SCHAMB].position.x || j != Quests[Q_SCHAMB].position.y)) {
@@ -200,7 +246,7 @@ void InitL2Triggers()
 
 void InitL3Triggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 170) {
@@ -227,7 +273,7 @@ void InitL3Triggers()
 
 void InitL4Triggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 82) {
@@ -265,7 +311,7 @@ void InitL4Triggers()
 
 void InitHiveTriggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 65) {
@@ -292,7 +338,7 @@ void InitHiveTriggers()
 
 void InitCryptTriggers()
 {
-	numtrigs = 0;
+	ClearTriggers();
 	for (WorldTileCoord j = 0; j < MAXDUNY; j++) {
 		for (WorldTileCoord i = 0; i < MAXDUNX; i++) {
 			if (dPiece[i][j] == 183) {
@@ -866,6 +912,8 @@ void CheckTriggers()
 {
 	Player &myPlayer = *MyPlayer;
 
+	PrefetchNearbyTriggerDestinations(myPlayer);
+
 	if (myPlayer._pmode != PM_STAND)
 		return;
 
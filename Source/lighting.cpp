@@ -7,17 +7,24 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <numeric>
+#include <span>
 #include <string>
+#include <utility>
 
 #include <expected.hpp>
 
 #include "automap.h"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
+#include "engine/rectangle.hpp"
+#include "engine/render/dirty_tiles.hpp"
 #include "player.h"
+#include "utils/algorithm/container.hpp"
 #include "utils/attributes.h"
 #include "utils/is_of.hpp"
+#include "utils/static_vector.hpp"
 #include "utils/status_macros.hpp"
 
 namespace devilution {
@@ -37,6 +44,8 @@ std::array<uint8_t, 256> PauseTable;
 bool DisableLighting;
 #endif
 bool UpdateLighting;
+uint8_t LightFalloffs[NumLightRadiuses][128];
+uint8_t LightConeInterpolations[8][8][16][16];
 
 namespace {
 
@@ -72,13 +81,41 @@ const DisplacementOf<int8_t> VisionCrawlTable[23][15] = {
 	// clang-format on
 };
 
-/** @brief Number of supported light radiuses (first radius starts with 0) */
-constexpr size_t NumLightRadiuses = 16;
-/** Falloff tables for the light cone */
-uint8_t LightFalloffs[NumLightRadiuses][128];
 bool UpdateVision;
-/** interpolations of a 32x32 (16x16 mirrored) light circle moving between tiles in steps of 1/8 of a tile */
-uint8_t LightConeInterpolations[8][8][16][16];
+
+/** @brief Distance from its tile to the furthest tile a light can reach. */
+constexpr int LightMaskRadius = 15;
+constexpr int LightMaskSize = 2 * LightMaskRadius + 1;
+
+/**
+ * @brief The light levels cast by a light with a given radius and offset, relative to the tile of the light.
+ *
+ * All the lights in the same state share a mask, so the light cone of each state is only computed once.
+ */
+struct LightMask {
+	/** @brief Indexed like dLight, LightsMax where the light does not reach. */
+	uint8_t levels[LightMaskSize][LightMaskSize];
+	/** @brief Distance from the tile of the light to the furthest tile that it lights. */
+	int reach;
+	uint8_t radius;
+	DisplacementOf<int8_t> offset;
+};
+
+/** @brief Masks by radius and offset, built the first time a light is in that state. Depend on the light falloffs. */
+std::array<std::unique_ptr<LightMask>, NumLightRadiuses * 8 * 8> LightMasks;
+
+constexpr Rectangle DungeonArea { { 0, 0 }, Size { MAXDUNX, MAXDUNY } };
+
+/** @brief Most areas that are kept track of between light updates, beyond that the lights are re-applied everywhere. */
+constexpr size_t MaxPendingLightAreas = 256;
+/** @brief Once the pending areas add up to this many tiles, re-lighting the whole level is cheaper than going through them. */
+constexpr int MaxPendingLightTiles = MAXDUNX * MAXDUNY / 4;
+/** @brief Areas of dLight that have been reverted to dPreLight or gained a light since the lights were last applied. */
+StaticVector<Rectangle, MaxPendingLightAreas> PendingLightAreas;
+/** @brief Sum of the sizes of PendingLightAreas, counting overlapping tiles more than once. */
+int PendingLightTiles;
+/** @brief Set instead of tracking PendingLightAreas when the whole level needs the lights re-applied. */
+bool PendingLightWholeLevel;
 
 /** RadiusAdj maps from VisionCrawlTable index to lighting vision radius adjustment. */
 const uint8_t RadiusAdj[23] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 4, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0 };
@@ -101,99 +138,123 @@ void RotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist,
 	}
 }
 
-DVL_ALWAYS_INLINE void SetLight(Point position, uint8_t v)
+std::unique_ptr<LightMask> BuildLightMask(uint8_t radius, DisplacementOf<int8_t> offset)
 {
-	if (LoadingMapObjects)
-		dPreLight[position.x][position.y] = v;
-	else
-		dLight[position.x][position.y] = v;
-}
+	auto mask = std::make_unique<LightMask>();
+	for (auto &column : mask->levels)
+		std::fill(std::begin(column), std::end(column), LightsMax);
+	mask->reach = 0;
+	mask->radius = radius;
+	mask->offset = offset;
+
+	const auto lightTile = [&mask](Displacement displacement, uint8_t v) {
+		uint8_t &level = mask->levels[displacement.deltaX + LightMaskRadius][displacement.deltaY + LightMaskRadius];
+		if (v >= level)
+			return;
+		level = v;
+		mask->reach = std::max({ mask->reach, std::abs(displacement.deltaX), std::abs(displacement.deltaY) });
+	};
 
-DVL_ALWAYS_INLINE uint8_t GetLight(Point position)
-{
-	if (LoadingMapObjects)
-		return dPreLight[position.x][position.y];
+	// Allow for dim lights in crypt and nest
+	lightTile({ 0, 0 }, IsAnyOf(leveltype, DTYPE_NEST, DTYPE_CRYPT) ? LightFalloffs[radius][0] : 0);
+
+	DisplacementOf<int8_t> light = {};
+	DisplacementOf<int8_t> block = {};
+	DisplacementOf<int8_t> dist = offset;
+	for (int i = 0; i < 4; i++) {
+		for (int y = 0; y < LightMaskRadius; y++) {
+			for (int x = 1; x < LightMaskRadius; x++) {
+				int linearDistance = LightConeInterpolations[offset.deltaX][offset.deltaY][x + block.deltaX][y + block.deltaY];
+				if (linearDistance >= 128)
+					continue;
+				lightTile((Displacement { x, y }).Rotate(-i), LightFalloffs[radius][linearDistance]);
+			}
+		}
+		RotateRadius(offset, dist, light, block);
+	}
 
-	return dLight[position.x][position.y];
+	return mask;
 }
 
-bool TileAllowsLight(Point position)
+const LightMask &GetLightMask(uint8_t radius, DisplacementOf<int8_t> offset)
 {
-	if (!InDungeonBounds(position))
-		return false;
-	return !TileHasAny(position, TileProperties::BlockLight);
+	std::unique_ptr<LightMask> &mask = LightMasks[(radius * 8 + offset.deltaX) * 8 + offset.deltaY];
+	if (mask == nullptr)
+		mask = BuildLightMask(radius, offset);
+	return *mask;
 }
 
-void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
+/** @brief Negative offsets are turned into positive ones from the previous tile, as the masks only cover those. */
+void NormalizeLightPosition(Point &position, DisplacementOf<int8_t> &offset)
 {
-	if (doAutomap != MAP_EXP_NONE) {
-		if (dFlags[position.x][position.y] != DungeonFlag::None)
-			SetAutomapView(position, doAutomap);
-		dFlags[position.x][position.y] |= DungeonFlag::Explored;
+	if (offset.deltaX < 0) {
+		offset.deltaX += 8;
+		position -= { 1, 0 };
+	}
+	if (offset.deltaY < 0) {
+		offset.deltaY += 8;
+		position -= { 0, 1 };
 	}
-	if (visible)
-		dFlags[position.x][position.y] |= DungeonFlag::Lit;
-	dFlags[position.x][position.y] |= DungeonFlag::Visible;
 }
 
-} // namespace
-
-void DoUnLight(Point position, uint8_t radius)
+Rectangle GetLightReach(const LightMask &mask, Point position)
 {
-	radius++;
-	radius++; // If lights moved at a diagonal it can result in some extra tiles being lit
-
-	auto searchArea = PointsInRectangle(WorldTileRectangle { position, radius });
+	return Rectangle { position, mask.reach };
+}
 
-	for (WorldTilePosition targetPosition : searchArea) {
-		if (InDungeonBounds(targetPosition))
-			dLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
-	}
+bool Overlaps(const Rectangle &a, const Rectangle &b)
+{
+	return a.position.x < b.position.x + b.size.width && b.position.x < a.position.x + a.size.width
+	    && a.position.y < b.position.y + b.size.height && b.position.y < a.position.y + a.size.height;
 }
 
-void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
+/** @brief Whether the light cone at `position` gets cut off by the edges of the level. */
+bool IsNearLevelEdge(Point position)
 {
-	assert(radius >= 0 && radius <= NumLightRadiuses);
-	assert(InDungeonBounds(position));
+	return position.x - LightMaskRadius < 0 || position.x + LightMaskRadius > MAXDUNX
+	    || position.y - LightMaskRadius < 0 || position.y + LightMaskRadius > MAXDUNY;
+}
 
+/**
+ * @brief Lights the tiles of `area` quadrant by quadrant, like the light cones have always been drawn.
+ *
+ * Close to the edges of the level, each quadrant is cut short at bounds that don't match the direction it extends in,
+ * so these lights look a little different from their masks. Lights there go through this loop to keep the old look.
+ */
+void ApplyLightQuadrants(const LightMask &mask, Point position, const Rectangle &area)
+{
+	auto &lightLevels = LoadingMapObjects ? dPreLight : dLight;
+	const auto setLight = [&](Point target, uint8_t v) {
+		if (!InDungeonBounds(target) || !area.contains(target))
+			return;
+		if (v < lightLevels[target.x][target.y])
+			lightLevels[target.x][target.y] = v;
+	};
+
+	DisplacementOf<int8_t> offset = mask.offset;
 	DisplacementOf<int8_t> light = {};
 	DisplacementOf<int8_t> block = {};
-
-	if (offset.deltaX < 0) {
-		offset.deltaX += 8;
-		position -= { 1, 0 };
-	}
-	if (offset.deltaY < 0) {
-		offset.deltaY += 8;
-		position -= { 0, 1 };
-	}
-
 	DisplacementOf<int8_t> dist = offset;
 
-	int minX = 15;
-	if (position.x - 15 < 0) {
+	int minX = LightMaskRadius;
+	if (position.x - LightMaskRadius < 0) {
 		minX = position.x + 1;
 	}
-	int maxX = 15;
-	if (position.x + 15 > MAXDUNX) {
+	int maxX = LightMaskRadius;
+	if (position.x + LightMaskRadius > MAXDUNX) {
 		maxX = MAXDUNX - position.x;
 	}
-	int minY = 15;
-	if (position.y - 15 < 0) {
+	int minY = LightMaskRadius;
+	if (position.y - LightMaskRadius < 0) {
 		minY = position.y + 1;
 	}
-	int maxY = 15;
-	if (position.y + 15 > MAXDUNY) {
+	int maxY = LightMaskRadius;
+	if (position.y + LightMaskRadius > MAXDUNY) {
 		maxY = MAXDUNY - position.y;
 	}
 
 	// Allow for dim lights in crypt and nest
-	if (IsAnyOf(leveltype, DTYPE_NEST, DTYPE_CRYPT)) {
-		if (GetLight(position) > LightFalloffs[radius][0])
-			SetLight(position, LightFalloffs[radius][0]);
-	} else {
-		SetLight(position, 0);
-	}
+	setLight(position, IsAnyOf(leveltype, DTYPE_NEST, DTYPE_CRYPT) ? LightFalloffs[mask.radius][0] : 0);
 
 	for (int i = 0; i < 4; i++) {
 		int yBound = i > 0 && i < 3 ? maxY : minY;
@@ -203,18 +264,98 @@ void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
 				int linearDistance = LightConeInterpolations[offset.deltaX][offset.deltaY][x + block.deltaX][y + block.deltaY];
 				if (linearDistance >= 128)
 					continue;
-				Point temp = position + (Displacement { x, y }).Rotate(-i);
-				uint8_t v = LightFalloffs[radius][linearDistance];
-				if (!InDungeonBounds(temp))
-					continue;
-				if (v < GetLight(temp))
-					SetLight(temp, v);
+				setLight(position + (Displacement { x, y }).Rotate(-i), LightFalloffs[mask.radius][linearDistance]);
 			}
 		}
 		RotateRadius(offset, dist, light, block);
 	}
 }
 
+/** @brief Lights the tiles of `area` that the light at `position` reaches, keeping the brightest light level of each tile. */
+void ApplyLightMask(const LightMask &mask, Point position, const Rectangle &area)
+{
+	if (IsNearLevelEdge(position)) {
+		ApplyLightQuadrants(mask, position, area);
+		return;
+	}
+
+	const int minX = std::max({ position.x - mask.reach, area.position.x, 0 });
+	const int maxX = std::min({ position.x + mask.reach, area.position.x + area.size.width - 1, MAXDUNX - 1 });
+	const int minY = std::max({ position.y - mask.reach, area.position.y, 0 });
+	const int maxY = std::min({ position.y + mask.reach, area.position.y + area.size.height - 1, MAXDUNY - 1 });
+	if (minX > maxX || minY > maxY)
+		return;
+
+	auto &lightLevels = LoadingMapObjects ? dPreLight : dLight;
+	const int length = maxY - minY + 1;
+	for (int x = minX; x <= maxX; x++) {
+		const uint8_t *levels = &mask.levels[x - position.x + LightMaskRadius][minY - position.y + LightMaskRadius];
+		uint8_t *tiles = &lightLevels[x][minY];
+		for (int i = 0; i < length; i++)
+			tiles[i] = std::min(tiles[i], levels[i]);
+	}
+}
+
+void AddPendingLightArea(const Rectangle &area)
+{
+	if (PendingLightWholeLevel)
+		return;
+	PendingLightTiles += area.size.width * area.size.height;
+	if (PendingLightAreas.size() == MaxPendingLightAreas || PendingLightTiles >= MaxPendingLightTiles) {
+		PendingLightAreas.clear();
+		PendingLightTiles = 0;
+		PendingLightWholeLevel = true;
+		return;
+	}
+	PendingLightAreas.emplace_back(area);
+}
+
+bool TileAllowsLight(Point position)
+{
+	if (!InDungeonBounds(position))
+		return false;
+	return !TileHasAny(position, TileProperties::BlockLight);
+}
+
+void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
+{
+	if (doAutomap != MAP_EXP_NONE) {
+		if (dFlags[position.x][position.y] != DungeonFlag::None)
+			SetAutomapView(position, doAutomap);
+		dFlags[position.x][position.y] |= DungeonFlag::Explored;
+	}
+	if (visible)
+		dFlags[position.x][position.y] |= DungeonFlag::Lit;
+	dFlags[position.x][position.y] |= DungeonFlag::Visible;
+}
+
+} // namespace
+
+void DoUnLight(Point position, uint8_t radius)
+{
+	radius++;
+	radius++; // If lights moved at a diagonal it can result in some extra tiles being lit
+
+	auto searchArea = PointsInRectangle(WorldTileRectangle { position, radius });
+
+	for (WorldTilePosition targetPosition : searchArea) {
+		if (InDungeonBounds(targetPosition))
+			dLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
+	}
+
+	// Other lights may be shining into the area as well
+	AddPendingLightArea(Rectangle { position, static_cast<int>(radius) });
+}
+
+void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
+{
+	assert(radius >= 0 && radius < NumLightRadiuses);
+	assert(InDungeonBounds(position));
+
+	NormalizeLightPosition(position, offset);
+	ApplyLightMask(GetLightMask(radius, offset), position, DungeonArea);
+}
+
 void DoUnVision(Point position, uint8_t radius)
 {
 	radius++;
@@ -356,6 +497,10 @@ void MakeLightTable()
 		}
 	}
 
+	// The masks are built from the falloffs
+	for (auto &mask : LightMasks)
+		mask = nullptr;
+
 	// Generate the light cone interpolations
 	for (int offsetY = 0; offsetY < 8; offsetY++) {
 		for (int offsetX = 0; offsetX < 8; offsetX++) {
@@ -394,6 +539,9 @@ void InitLighting()
 	ActiveLightCount = 0;
 	UpdateLighting = false;
 	UpdateVision = false;
+	PendingLightAreas.clear();
+	PendingLightTiles = 0;
+	PendingLightWholeLevel = true;
 #ifdef _DEBUG
 	DisableLighting = false;
 #endif
@@ -419,6 +567,9 @@ int AddLight(Point position, uint8_t radius)
 	light.position.offset = { 0, 0 };
 	light.isInvalid = false;
 	light.hasChanged = false;
+	light.isHidden = false;
+	MarkTilesDirty(position, radius + 1);
+	AddPendingLightArea(Rectangle { position, radius + 2 });
 
 	UpdateLighting = true;
 
@@ -515,6 +666,81 @@ void ChangeLight(int i, Point position, uint8_t radius)
 	UpdateLighting = true;
 }
 
+void UpdateLightMap(std::span<Light *const> lights)
+{
+	for (Light *light : lights) {
+		if (light->isInvalid) {
+			DoUnLight(light->position.tile, light->radius);
+			// The per-pixel lightmap blends with the neighbouring tiles, so one more tile has to be redrawn
+			MarkTilesDirty(light->position.tile, light->radius + 1);
+		}
+		if (light->hasChanged) {
+			DoUnLight(light->position.old, light->oldRadius);
+			AddPendingLightArea(Rectangle { light->position.tile, light->radius + 2 });
+			MarkTilesDirty(light->position.old, light->oldRadius + 1);
+			MarkTilesDirty(light->position.tile, light->radius + 1);
+			light->hasChanged = false;
+		}
+		if (light->isInvalid)
+			continue;
+		// Monsters hidden in a wall don't spoil the surprise, but they light up the level once the wall is gone.
+		const bool isHidden = TileHasAny(light->position.tile, TileProperties::Solid);
+		if (isHidden == light->isHidden)
+			continue;
+		// A light that gets walled in keeps what it already lit until it changes, like it always has.
+		if (!isHidden) {
+			AddPendingLightArea(Rectangle { light->position.tile, light->radius + 2 });
+			MarkTilesDirty(light->position.tile, light->radius + 1);
+		}
+		light->isHidden = isHidden;
+	}
+
+	// Only the pending areas changed since the lights were last applied, everywhere else dLight is still up to date.
+
+	// Lights in the same state cast the same light, so each state only has to be applied once.
+	StaticVector<std::pair<const LightMask *, Point>, MAXLIGHTS> appliedLights;
+	for (const Light *light : lights) {
+		if (light->isInvalid || light->isHidden)
+			continue;
+
+		Point position = light->position.tile;
+		DisplacementOf<int8_t> offset = light->position.offset;
+		NormalizeLightPosition(position, offset);
+		const LightMask &mask = GetLightMask(light->radius, offset);
+		const std::pair<const LightMask *, Point> state { &mask, position };
+		if (c_find(appliedLights, state) != appliedLights.end())
+			continue;
+		if (appliedLights.size() < MAXLIGHTS)
+			appliedLights.emplace_back(state);
+
+		if (PendingLightWholeLevel) {
+			ApplyLightMask(mask, position, DungeonArea);
+			continue;
+		}
+		// Re-applying a light to tiles that already have it changes nothing, so a single pass over the bounds
+		// of the pending areas it reaches is enough, even when these areas overlap.
+		const Rectangle reach = GetLightReach(mask, position);
+		int minX = MAXDUNX;
+		int minY = MAXDUNY;
+		int maxX = -1;
+		int maxY = -1;
+		for (const Rectangle &area : PendingLightAreas) {
+			if (!Overlaps(area, reach))
+				continue;
+			minX = std::min(minX, area.position.x);
+			minY = std::min(minY, area.position.y);
+			maxX = std::max(maxX, area.position.x + area.size.width - 1);
+			maxY = std::max(maxY, area.position.y + area.size.height - 1);
+		}
+		if (minX <= maxX)
+			ApplyLightMask(mask, position, Rectangle { { minX, minY }, Size { maxX - minX + 1, maxY - minY + 1 } });
+	}
+
+	PendingLightAreas.clear();
+	PendingLightTiles = 0;
+	PendingLightWholeLevel = false;
+}
+
 void ProcessLightList()
 {
 #ifdef _DEBUG
@@ -523,27 +749,18 @@ void ProcessLightList()
 #endif
 	if (!UpdateLighting)
 		return;
+
+	StaticVector<Light *, MAXLIGHTS> lights;
+	for (int i = 0; i < ActiveLightCount; i++)
+		lights.emplace_back(&Lights[ActiveLights[i]]);
+	UpdateLightMap(lights);
+
 	for (int i = 0; i < ActiveLightCount; i++) {
-		Light &light = Lights[ActiveLights[i]];
-		if (light.isInvalid) {
-			DoUnLight(light.position.tile, light.radius);
-		}
-		if (light.hasChanged) {
-			DoUnLight(light.position.old, light.oldRadius);
-			light.hasChanged = false;
-		}
-	}
-	for (int i = 0; i < ActiveLightCount; i++) {
-		const Light &light = Lights[ActiveLights[i]];
-		if (light.isInvalid) {
+		if (Lights[ActiveLights[i]].isInvalid) {
 			ActiveLightCount--;
 			std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
 			i--;
-			continue;
 		}
-		if (TileHasAny(light.position.tile, TileProperties::Solid))
-			continue; // Monster hidden in a wall, don't spoil the surprise
-		DoLighting(light.position.tile, light.radius, light.position.offset);
 	}
 
 	UpdateLighting = false;
@@ -554,6 +771,15 @@ void SavePreLighting()
 	memcpy(dPreLight, dLight, sizeof(dPreLight));
 }
 
+void RestorePreLighting()
+{
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	PendingLightAreas.clear();
+	PendingLightTiles = 0;
+	PendingLightWholeLevel = true;
+	MarkAllTilesDirty();
+}
+
 void ActivateVision(Point position, int r, size_t id)
 {
 	auto &vision = VisionList[id];
@@ -632,6 +858,7 @@ void lighting_color_cycling()
 		// shift elements between indexes 1-31 to left
 		std::rotate(lightTable.begin() + 1, lightTable.begin() + 2, lightTable.begin() + 32);
 	}
+	MarkAllTilesDirty();
 }
 
 } // namespace devilution
@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
 
 #include <expected.hpp>
 
@@ -38,6 +39,8 @@ struct Light {
 	uint8_t oldRadius;
 	bool isInvalid;
 	bool hasChanged;
+	/** @brief Left out of dLight by the last UpdateLightMap because the light was inside a solid tile. */
+	bool isHidden;
 };
 
 extern Light VisionList[MAXVISION];
@@ -58,6 +61,12 @@ extern std::array<uint8_t, 256> PauseTable;
 extern bool DisableLighting;
 #endif
 extern bool UpdateLighting;
+/** @brief Number of supported light radiuses (first radius starts with 0) */
+constexpr size_t NumLightRadiuses = 16;
+/** Falloff tables for the light cone */
+extern DVL_API_FOR_TEST uint8_t LightFalloffs[NumLightRadiuses][128];
+/** interpolations of a 32x32 (16x16 mirrored) light circle moving between tiles in steps of 1/8 of a tile */
+extern DVL_API_FOR_TEST uint8_t LightConeInterpolations[8][8][16][16];
 
 void DoUnLight(Point position, uint8_t radius);
 void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset);
@@ -75,8 +84,18 @@ void ChangeLightRadius(int i, uint8_t radius);
 void ChangeLightXY(int i, Point position);
 void ChangeLightOffset(int i, DisplacementOf<int8_t> offset);
 void ChangeLight(int i, Point position, uint8_t radius);
+/**
+ * @brief Brings dLight up to date with the given lights.
+ *
+ * Only the areas around lights that were added, changed or removed are re-lit, every other tile already has the
+ * right light level. Clears the `hasChanged` flags, dropping the invalid lights is up to the caller.
+ * ProcessLightList does this for the active lights.
+ */
+void UpdateLightMap(std::span<Light *const> lights);
 void ProcessLightList();
 void SavePreLighting();
+/** @brief Resets dLight to the static lights of the level, the next ProcessLightList re-applies all the lights. */
+void RestorePreLighting();
 void ActivateVision(Point position, int r, size_t id);
 void ChangeVisionRadius(size_t id, int r);
 void ChangeVisionXY(size_t id, Point position);
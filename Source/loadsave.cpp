@@ -180,7 +180,8 @@ public:
 };
 
 class SaveHelper {
-	SaveWriter &m_mpqWriter;
+	SaveWriter *m_mpqWriter = nullptr;
+	SaveSnapshot *m_snapshot = nullptr;
 	const char *m_szFileName_;
 	std::unique_ptr<std::byte[]> m_buffer_;
 	size_t m_cur_ = 0;
@@ -188,7 +189,16 @@ class SaveHelper {
 
 public:
 	SaveHelper(SaveWriter &mpqWriter, const char *szFileName, size_t bufferLen)
-	    : m_mpqWriter(mpqWriter)
+	    : m_mpqWriter(&mpqWriter)
+	    , m_szFileName_(szFileName)
+	    , m_buffer_(new std::byte[codec_get_encoded_len(bufferLen)])
+	    , m_capacity_(bufferLen)
+	{
+	}
+
+	/** @brief Hands the unencoded file to the snapshot instead of writing it. */
+	SaveHelper(SaveSnapshot &snapshot, const char *szFileName, size_t bufferLen)
+	    : m_snapshot(&snapshot)
 	    , m_szFileName_(szFileName)
 	    , m_buffer_(new std::byte[codec_get_encoded_len(bufferLen)])
 	    , m_capacity_(bufferLen)
@@ -238,10 +248,14 @@ public:
 
 	~SaveHelper()
 	{
+		if (m_snapshot != nullptr) {
+			m_snapshot->AddFile(m_szFileName_, std::move(m_buffer_), m_cur_);
+			return;
+		}
 		const auto encodedLen = codec_get_encoded_len(m_cur_);
 		const char *const password = pfile_get_password();
 		codec_encode(m_buffer_.get(), m_cur_, encodedLen, password);
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
+		m_mpqWriter->WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
 	}
 };
 
@@ -932,6 +946,7 @@ void LoadLighting(LoadHelper *file, Light *pLight)
 	file->Skip<int32_t>(); // _lid
 	pLight->isInvalid = file->NextBool32();
 	pLight->hasChanged = file->NextBool32();
+	pLight->isHidden = false;
 	file->Skip(4); // Unused
 	pLight->position.old.x = file->NextLE<int32_t>();
 	pLight->position.old.y = file->NextLE<int32_t>();
@@ -1781,7 +1796,7 @@ void SaveAdditionalMissiles(SaveWriter &saveWriter)
 
 	if (missileCountAdditional > 0) {
 		auto it = Missiles.cbegin();
-		// std::list::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
+		// The missile list only has forward iterators, using std::advance to get past the missiles we've already saved
 		std::advance(it, MaxMissilesForSaveGame);
 		for (; it != Missiles.cend(); it++) {
 			SaveMissile(&file, *it);
@@ -1998,7 +2013,7 @@ tl::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionDa
 		}
 
 		// No need to load dLight, we can recreate it accurately from LightList
-		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                                          // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
@@ -2269,7 +2284,10 @@ void LoadHotkeys()
 	myPlayer._pRSplType = static_cast<SpellType>(file.NextLE<uint8_t>());
 }
 
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+namespace {
+
+template <typename Writer>
+void DoSaveHotkeys(Writer &saveWriter, const Player &player)
 {
 	SaveHelper file(saveWriter, "hotkeys", HotkeysSize());
 
@@ -2289,6 +2307,18 @@ void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
 	file.WriteLE<uint8_t>(static_cast<uint8_t>(player._pRSplType));
 }
 
+} // namespace
+
+void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+{
+	DoSaveHotkeys(saveWriter, player);
+}
+
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player)
+{
+	DoSaveHotkeys(snapshot, player);
+}
+
 void LoadHeroItems(Player &player)
 {
 	LoadHelper file(OpenSaveArchive(gSaveNumber), "heroitems");
@@ -2526,7 +2556,7 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 		file.Skip(MAXDUNX * MAXDUNY); // dMissile
 
 		// No need to load dLight, we can recreate it accurately from LightList
-		memcpy(dLight, dPreLight, sizeof(dLight));               // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                    // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(myPlayer.lightId, myPlayer.position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
@@ -2571,7 +2601,10 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 	return {};
 }
 
-void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+namespace {
+
+template <typename Writer>
+void DoSaveHeroItems(Writer &saveWriter, const Player &player)
 {
 	size_t itemCount = static_cast<size_t>(NUM_INVLOC) + InventoryGridCells + MaxBeltItems;
 	SaveHelper file(saveWriter, "heroitems", itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize) + sizeof(uint8_t));
@@ -2586,7 +2619,8 @@ void SaveHeroItems(SaveWriter &saveWriter, Player &player)
 		SaveItem(file, item);
 }
 
-void SaveStash(SaveWriter &stashWriter)
+template <typename Writer>
+void DoSaveStash(Writer &stashWriter)
 {
 	const char *filename;
 	if (!gbIsMultiplayer)
@@ -2643,6 +2677,28 @@ void SaveStash(SaveWriter &stashWriter)
 	file.WriteLE<uint32_t>(static_cast<uint32_t>(Stash.GetPage()));
 }
 
+} // namespace
+
+void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+{
+	DoSaveHeroItems(saveWriter, player);
+}
+
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player)
+{
+	DoSaveHeroItems(snapshot, player);
+}
+
+void SaveStash(SaveWriter &stashWriter)
+{
+	DoSaveStash(stashWriter);
+}
+
+void SaveStash(SaveSnapshot &snapshot)
+{
+	DoSaveStash(snapshot);
+}
+
 void SaveGameData(SaveWriter &saveWriter)
 {
 	SaveHelper file(saveWriter, "game", 320 * 1024);
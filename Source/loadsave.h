@@ -38,7 +38,9 @@ void RemoveEmptyInventory(Player &player);
  */
 tl::expected<void, std::string> LoadGame(bool firstflag);
 void SaveHotkeys(SaveWriter &saveWriter, const Player &player);
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player);
 void SaveHeroItems(SaveWriter &saveWriter, Player &player);
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player);
 void SaveGameData(SaveWriter &saveWriter);
 void SaveGame();
 void SaveLevel(SaveWriter &saveWriter);
@@ -46,5 +48,6 @@ tl::expected<void, std::string> LoadLevel();
 tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter);
 void LoadStash();
 void SaveStash(SaveWriter &stashWriter);
+void SaveStash(SaveSnapshot &snapshot);
 
 } // namespace devilution
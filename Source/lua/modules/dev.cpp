@@ -4,6 +4,7 @@
 #include <sol/sol.hpp>
 
 #include "lua/metadoc.hpp"
+#include "lua/modules/dev/assets.hpp"
 #include "lua/modules/dev/display.hpp"
 #include "lua/modules/dev/items.hpp"
 #include "lua/modules/dev/level.hpp"
@@ -18,6 +19,9 @@ namespace devilution {
 sol::table LuaDevModule(sol::state_view &lua)
 {
 	sol::table table = lua.create_table();
+#ifndef UNPACKED_MPQS
+	SetDocumented(table, "assets", "", "Asset loading and caching commands.", LuaDevAssetsModule(lua));
+#endif
 	SetDocumented(table, "display", "", "Debugging HUD and rendering commands.", LuaDevDisplayModule(lua));
 	SetDocumented(table, "items", "", "Item-related commands.", LuaDevItemsModule(lua));
 	SetDocumented(table, "level", "", "Level-related commands.", LuaDevLevelModule(lua));
@@ -0,0 +1,48 @@
+#if defined(_DEBUG) && !defined(UNPACKED_MPQS)
+#include "lua/modules/dev/assets.hpp"
+
+#include <string>
+
+#include <sol/sol.hpp>
+
+#include "lua/metadoc.hpp"
+#include "mpq/mpq_block_cache.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+std::string DebugCmdBlockCacheInfo()
+{
+	const MpqBlockCacheStats stats = GetMpqBlockCacheStats();
+	const size_t lookups = stats.hits + stats.misses;
+	const size_t hitPercent = lookups == 0 ? 0 : stats.hits * 100 / lookups;
+	return StrCat("MPQ block cache: ", stats.numBlocks, " blocks, ", stats.usedBytes / 1024, "/", stats.budgetBytes / 1024, " KiB\n",
+	    "hits=", stats.hits, " misses=", stats.misses, " (", hitPercent, "% hits) evictions=", stats.evictions);
+}
+
+std::string DebugCmdBlockCacheClear()
+{
+	ClearMpqBlockCache();
+	return "MPQ block cache cleared.";
+}
+
+std::string DebugCmdBlockCacheBudget(size_t kibibytes)
+{
+	SetMpqBlockCacheBudget(kibibytes * 1024);
+	return StrCat("MPQ block cache budget set to ", kibibytes, " KiB.");
+}
+
+} // namespace
+
+sol::table LuaDevAssetsModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	SetDocumented(table, "blockCache", "()", "Size and hit/miss counters of the decompressed MPQ block cache.", &DebugCmdBlockCacheInfo);
+	SetDocumented(table, "blockCacheBudget", "(kib: number)", "Set the size limit of the MPQ block cache, 0 disables it.", &DebugCmdBlockCacheBudget);
+	SetDocumented(table, "clearBlockCache", "()", "Drop all cached MPQ blocks and reset the counters.", &DebugCmdBlockCacheClear);
+	return table;
+}
+
+} // namespace devilution
+#endif // defined(_DEBUG) && !defined(UNPACKED_MPQS)
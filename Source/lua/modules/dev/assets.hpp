@@ -0,0 +1,10 @@
+#pragma once
+#if defined(_DEBUG) && !defined(UNPACKED_MPQS)
+#include <sol/sol.hpp>
+
+namespace devilution {
+
+sol::table LuaDevAssetsModule(sol::state_view &lua);
+
+} // namespace devilution
+#endif // defined(_DEBUG) && !defined(UNPACKED_MPQS)
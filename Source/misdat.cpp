@@ -127,31 +127,35 @@ void LoadMissileSpriteData()
 	const std::string_view filename = "txtdata\\missiles\\missile_sprites.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	MissileAnimDelays.clear();
-	MissileAnimLengths.clear();
-	MissileSpriteData.clear();
-	MissileSpriteData.reserve(dataFile.numRecords());
-
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		MissileFileData &item = MissileSpriteData.emplace_back();
-		MissileGraphicID id;
-		reader.read("id", id, ParseMissileGraphicID);
-		assert(static_cast<size_t>(id) + 1 == MissileSpriteData.size());
-		reader.readInt("width", item.animWidth);
-		reader.readInt("width2", item.animWidth2);
-		reader.readString("name", item.name);
-		reader.readInt("numFrames", item.animFAmt);
-		reader.read("flags", item.flags, ParseMissileGraphicsFlag);
-
-		std::array<uint8_t, 16> arr;
-		reader.readIntArray("frameDelay", arr);
-		item.animDelayIdx = static_cast<uint8_t>(ToIndex(MissileAnimDelays, arr));
-
-		reader.readIntArray("frameLength", arr);
-		item.animLenIdx = static_cast<uint8_t>(ToIndex(MissileAnimLengths, arr));
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		MissileAnimDelays.clear();
+		MissileAnimLengths.clear();
+		MissileSpriteData.clear();
+		MissileSpriteData.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			MissileFileData &item = MissileSpriteData.emplace_back();
+			MissileGraphicID id;
+			reader.read("id", id, ParseMissileGraphicID);
+			// Replayed values were checked when they were recorded.
+			assert(cache.replaying() || static_cast<size_t>(id) + 1 == MissileSpriteData.size());
+			reader.readInt("width", item.animWidth);
+			reader.readInt("width2", item.animWidth2);
+			reader.readString("name", item.name);
+			reader.readInt("numFrames", item.animFAmt);
+			reader.read("flags", item.flags, ParseMissileGraphicsFlag);
+
+			std::array<uint8_t, 16> arr;
+			reader.readIntArray("frameDelay", arr);
+			item.animDelayIdx = static_cast<uint8_t>(ToIndex(MissileAnimDelays, arr));
+
+			reader.readIntArray("frameLength", arr);
+			item.animLenIdx = static_cast<uint8_t>(ToIndex(MissileAnimLengths, arr));
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 
 	MissileSpriteData.shrink_to_fit();
 	MissileAnimDelays.shrink_to_fit();
@@ -37,7 +37,7 @@
 
 namespace devilution {
 
-std::list<Missile> Missiles;
+PooledList<Missile> Missiles;
 bool MissilePreFlag;
 
 namespace {
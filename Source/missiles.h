@@ -6,7 +6,6 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 #include <optional>
 
 #include "engine/displacement.hpp"
@@ -17,6 +16,7 @@
 #include "player.h"
 #include "spelldat.h"
 #include "utils/is_of.hpp"
+#include "utils/pooled_list.hpp"
 
 namespace devilution {
 
@@ -177,7 +177,7 @@ struct Missile {
 	}
 };
 
-extern std::list<Missile> Missiles;
+extern PooledList<Missile> Missiles;
 extern bool MissilePreFlag;
 
 struct DamageRange {
@@ -35,6 +35,7 @@ bool DropRateManager::LoadConfig(const std::string& configPath)
 	}
 	
 	// Load the configuration
+	settingsVersion++;
 	return config.LoadFromFile(configPath);
 }
 
@@ -78,6 +79,7 @@ bool DropRateManager::ReloadConfig(const std::string& configPath)
 	}
 	
 	// Reload the configuration
+	settingsVersion++;
 	return config.LoadFromFile(path);
 }
 
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "itemdat.h"
 #include "mods/config/drop_rate_config.h"
 #include "utils/log.hpp"
@@ -54,6 +56,7 @@ public:
 		
 		// Set the value
 		goldDropRatePercent = percent;
+		settingsVersion++;
 		
 		// Log the change
 		LogVerbose("Gold drop rate set to {}%", goldDropRatePercent);
@@ -79,6 +82,7 @@ public:
 		
 		// Set the value
 		goldAmountPercent = percent;
+		settingsVersion++;
 		
 		// Log the change
 		LogVerbose("Gold amount set to {}%", goldAmountPercent);
@@ -104,6 +108,7 @@ public:
 		
 		// Set the value
 		itemDropRatePercent = percent;
+		settingsVersion++;
 		
 		// Log the change
 		LogVerbose("Item drop rate set to {}%", itemDropRatePercent);
@@ -122,6 +127,7 @@ public:
 	void SetItemTypePreference(ItemType type)
 	{
 		itemTypePreference = type;
+		settingsVersion++;
 		LogVerbose("Item type preference set to {}", static_cast<int>(itemTypePreference));
 	}
 	
@@ -143,6 +149,7 @@ public:
 		
 		// Set the value
 		itemQualityPercent = percent;
+		settingsVersion++;
 		
 		// Log the change
 		LogVerbose("Item quality set to {}%", itemQualityPercent);
@@ -166,6 +173,7 @@ public:
 		
 		// Set the value
 		specialObjectQualityScalingFactor = factor;
+		settingsVersion++;
 		
 		// Log the change
 		LogVerbose("Special object quality scaling factor set to {}%", specialObjectQualityScalingFactor);
@@ -194,6 +202,8 @@ public:
 		// Reset special object quality scaling factor to default
 		specialObjectQualityScalingFactor = 25;
 		
+		settingsVersion++;
+		
 		LogVerbose("Drop rates reset to defaults");
 		LogVerbose("Gold drop rate: {}%", goldDropRatePercent);
 		LogVerbose("Gold amount: {}%", goldAmountPercent);
@@ -205,6 +215,12 @@ public:
 		// Note: We've removed the SaveSettings call for now to focus on core functionality
 	}
 	
+	/**
+	 * @brief Get a number that changes whenever any drop rate setting changes
+	 * @return The settings version, for invalidating anything computed from the settings
+	 */
+	uint32_t GetSettingsVersion() const { return settingsVersion; }
+	
 	// We're not implementing SaveSettings and LoadSettings for now to focus on the core functionality
 	
 	/**
@@ -274,6 +290,7 @@ private:
 	ItemType itemTypePreference = ItemType::Normal; // Default normal item type preference
 	int itemQualityPercent = 50; // Default 50% item quality
 	int specialObjectQualityScalingFactor = 25; // Default 25% special object quality scaling factor
+	uint32_t settingsVersion = 0; // Incremented on every settings change
 	
 	// Configuration loading and saving
 	bool LoadConfig(const std::string& configPath, DropRateConfig& config);
@@ -482,66 +482,71 @@ void LoadMonstDat()
 	const std::string_view filename = "txtdata\\monsters\\monstdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	MonstersData.clear();
-	MonstersData.reserve(dataFile.numRecords());
-	ankerl::unordered_dense::map<std::string, size_t> spritePathToId;
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		MonsterData &monster = MonstersData.emplace_back();
-		reader.advance(); // Skip the first column (monster ID).
-		reader.readString("name", monster.name);
-		{
-			std::string assetsSuffix;
-			reader.readString("assetsSuffix", assetsSuffix);
-			const auto [it, inserted] = spritePathToId.emplace(assetsSuffix, spritePathToId.size());
-			if (inserted)
-				MonsterSpritePaths.push_back(it->first);
-			monster.spriteId = static_cast<uint16_t>(it->second);
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		MonstersData.clear();
+		MonsterSpritePaths.clear();
+		MonstersData.reserve(dataFile.numRecords());
+		ankerl::unordered_dense::map<std::string, size_t> spritePathToId;
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			MonsterData &monster = MonstersData.emplace_back();
+			reader.advance(); // Skip the first column (monster ID).
+			reader.readString("name", monster.name);
+			{
+				std::string assetsSuffix;
+				reader.readString("assetsSuffix", assetsSuffix);
+				const auto [it, inserted] = spritePathToId.emplace(assetsSuffix, spritePathToId.size());
+				if (inserted)
+					MonsterSpritePaths.push_back(it->first);
+				monster.spriteId = static_cast<uint16_t>(it->second);
+			}
+			reader.readString("soundSuffix", monster.soundSuffix);
+			reader.readString("trnFile", monster.trnFile);
+			reader.read("availability", monster.availability, ParseMonsterAvailability);
+			reader.readInt("width", monster.width);
+			reader.readInt("image", monster.image);
+			reader.readBool("hasSpecial", monster.hasSpecial);
+			reader.readBool("hasSpecialSound", monster.hasSpecialSound);
+			reader.readIntArray("frames", monster.frames);
+			reader.readIntArray("rate", monster.rate);
+			reader.readInt("minDunLvl", monster.minDunLvl);
+			reader.readInt("maxDunLvl", monster.maxDunLvl);
+			reader.readInt("level", monster.level);
+			reader.readInt("hitPointsMinimum", monster.hitPointsMinimum);
+			reader.readInt("hitPointsMaximum", monster.hitPointsMaximum);
+			reader.read("ai", monster.ai, ParseAiId);
+			reader.readEnumList("abilityFlags", monster.abilityFlags, ParseMonsterFlag);
+			reader.readInt("intelligence", monster.intelligence);
+			reader.readInt("toHit", monster.toHit);
+			reader.readInt("animFrameNum", monster.animFrameNum);
+			reader.readInt("minDamage", monster.minDamage);
+			reader.readInt("maxDamage", monster.maxDamage);
+			reader.readInt("toHitSpecial", monster.toHitSpecial);
+			reader.readInt("animFrameNumSpecial", monster.animFrameNumSpecial);
+			reader.readInt("minDamageSpecial", monster.minDamageSpecial);
+			reader.readInt("maxDamageSpecial", monster.maxDamageSpecial);
+			reader.readInt("armorClass", monster.armorClass);
+			reader.read("monsterClass", monster.monsterClass, ParseMonsterClass);
+			reader.readEnumList("resistance", monster.resistance, ParseMonsterResistance);
+			reader.readEnumList("resistanceHell", monster.resistanceHell, ParseMonsterResistance);
+			reader.readEnumList("selectionRegion", monster.selectionRegion, ParseSelectionRegion);
+
+			// treasure
+			// TODO: Replace this hack with proper parsing once items have been migrated to data files.
+			reader.read("treasure", monster.treasure, [](std::string_view value) -> tl::expected<uint16_t, std::string> {
+				if (value.empty()) return 0;
+				if (value == "None") return T_NODROP;
+				if (value == "Uniq(SKCROWN)") return Uniq(UITEM_SKCROWN);
+				if (value == "Uniq(CLEAVER)") return Uniq(UITEM_CLEAVER);
+				return tl::make_unexpected("Invalid value. NOTE: Parser is incomplete");
+			});
+
+			reader.readInt("exp", monster.exp);
 		}
-		reader.readString("soundSuffix", monster.soundSuffix);
-		reader.readString("trnFile", monster.trnFile);
-		reader.read("availability", monster.availability, ParseMonsterAvailability);
-		reader.readInt("width", monster.width);
-		reader.readInt("image", monster.image);
-		reader.readBool("hasSpecial", monster.hasSpecial);
-		reader.readBool("hasSpecialSound", monster.hasSpecialSound);
-		reader.readIntArray("frames", monster.frames);
-		reader.readIntArray("rate", monster.rate);
-		reader.readInt("minDunLvl", monster.minDunLvl);
-		reader.readInt("maxDunLvl", monster.maxDunLvl);
-		reader.readInt("level", monster.level);
-		reader.readInt("hitPointsMinimum", monster.hitPointsMinimum);
-		reader.readInt("hitPointsMaximum", monster.hitPointsMaximum);
-		reader.read("ai", monster.ai, ParseAiId);
-		reader.readEnumList("abilityFlags", monster.abilityFlags, ParseMonsterFlag);
-		reader.readInt("intelligence", monster.intelligence);
-		reader.readInt("toHit", monster.toHit);
-		reader.readInt("animFrameNum", monster.animFrameNum);
-		reader.readInt("minDamage", monster.minDamage);
-		reader.readInt("maxDamage", monster.maxDamage);
-		reader.readInt("toHitSpecial", monster.toHitSpecial);
-		reader.readInt("animFrameNumSpecial", monster.animFrameNumSpecial);
-		reader.readInt("minDamageSpecial", monster.minDamageSpecial);
-		reader.readInt("maxDamageSpecial", monster.maxDamageSpecial);
-		reader.readInt("armorClass", monster.armorClass);
-		reader.read("monsterClass", monster.monsterClass, ParseMonsterClass);
-		reader.readEnumList("resistance", monster.resistance, ParseMonsterResistance);
-		reader.readEnumList("resistanceHell", monster.resistanceHell, ParseMonsterResistance);
-		reader.readEnumList("selectionRegion", monster.selectionRegion, ParseSelectionRegion);
-
-		// treasure
-		// TODO: Replace this hack with proper parsing once items have been migrated to data files.
-		reader.read("treasure", monster.treasure, [](std::string_view value) -> tl::expected<uint16_t, std::string> {
-			if (value.empty()) return 0;
-			if (value == "None") return T_NODROP;
-			if (value == "Uniq(SKCROWN)") return Uniq(UITEM_SKCROWN);
-			if (value == "Uniq(CLEAVER)") return Uniq(UITEM_CLEAVER);
-			return tl::make_unexpected("Invalid value. NOTE: Parser is incomplete");
-		});
-
-		reader.readInt("exp", monster.exp);
-	}
+	} while (!cache.finishReplay());
+	cache.save();
 	MonstersData.shrink_to_fit();
 }
 
@@ -550,39 +555,43 @@ void LoadUniqueMonstDat()
 	const std::string_view filename = "txtdata\\monsters\\unique_monstdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
-
-	UniqueMonstersData.clear();
-	UniqueMonstersData.reserve(dataFile.numRecords());
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		UniqueMonsterData &monster = UniqueMonstersData.emplace_back();
-		reader.read("type", monster.mtype, ParseMonsterId);
-		reader.readString("name", monster.mName);
-		reader.readString("trn", monster.mTrnName);
-		reader.readInt("level", monster.mlevel);
-		reader.readInt("maxHp", monster.mmaxhp);
-		reader.read("ai", monster.mAi, ParseAiId);
-		reader.readInt("intelligence", monster.mint);
-		reader.readInt("minDamage", monster.mMinDamage);
-		reader.readInt("maxDamage", monster.mMaxDamage);
-		reader.readEnumList("resistance", monster.mMagicRes, ParseMonsterResistance);
-		reader.read("monsterPack", monster.monsterPack, ParseUniqueMonsterPack);
-		reader.readInt("customToHit", monster.customToHit);
-		reader.readInt("customArmorClass", monster.customArmorClass);
-
-		// talkMessage
-		// TODO: Replace this hack with proper parsing once messages have been migrated to data files.
-		reader.read("talkMessage", monster.mtalkmsg, [](std::string_view value) -> tl::expected<_speech_id, std::string> {
-			if (value.empty()) return TEXT_NONE;
-			if (value == "TEXT_GARBUD1") return TEXT_GARBUD1;
-			if (value == "TEXT_ZHAR1") return TEXT_ZHAR1;
-			if (value == "TEXT_BANNER10") return TEXT_BANNER10;
-			if (value == "TEXT_VILE13") return TEXT_VILE13;
-			if (value == "TEXT_VEIL9") return TEXT_VEIL9;
-			if (value == "TEXT_WARLRD9") return TEXT_WARLRD9;
-			return tl::make_unexpected("Invalid value. NOTE: Parser is incomplete");
-		});
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+
+	do {
+		UniqueMonstersData.clear();
+		UniqueMonstersData.reserve(dataFile.numRecords());
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			UniqueMonsterData &monster = UniqueMonstersData.emplace_back();
+			reader.read("type", monster.mtype, ParseMonsterId);
+			reader.readString("name", monster.mName);
+			reader.readString("trn", monster.mTrnName);
+			reader.readInt("level", monster.mlevel);
+			reader.readInt("maxHp", monster.mmaxhp);
+			reader.read("ai", monster.mAi, ParseAiId);
+			reader.readInt("intelligence", monster.mint);
+			reader.readInt("minDamage", monster.mMinDamage);
+			reader.readInt("maxDamage", monster.mMaxDamage);
+			reader.readEnumList("resistance", monster.mMagicRes, ParseMonsterResistance);
+			reader.read("monsterPack", monster.monsterPack, ParseUniqueMonsterPack);
+			reader.readInt("customToHit", monster.customToHit);
+			reader.readInt("customArmorClass", monster.customArmorClass);
+
+			// talkMessage
+			// TODO: Replace this hack with proper parsing once messages have been migrated to data files.
+			reader.read("talkMessage", monster.mtalkmsg, [](std::string_view value) -> tl::expected<_speech_id, std::string> {
+				if (value.empty()) return TEXT_NONE;
+				if (value == "TEXT_GARBUD1") return TEXT_GARBUD1;
+				if (value == "TEXT_ZHAR1") return TEXT_ZHAR1;
+				if (value == "TEXT_BANNER10") return TEXT_BANNER10;
+				if (value == "TEXT_VILE13") return TEXT_VILE13;
+				if (value == "TEXT_VEIL9") return TEXT_VEIL9;
+				if (value == "TEXT_WARLRD9") return TEXT_WARLRD9;
+				return tl::make_unexpected("Invalid value. NOTE: Parser is incomplete");
+			});
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 	UniqueMonstersData.shrink_to_fit();
 }
 
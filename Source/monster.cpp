@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <numeric>
 #include <string>
 #include <string_view>
@@ -25,6 +26,8 @@
 #include "crawl.hpp"
 #include "cursor.h"
 #include "dead.h"
+#include "engine/asset_loader.hpp"
+#include "engine/flow_field.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
@@ -1647,18 +1650,40 @@ bool RandomWalk2(Monster &monster, Direction md)
 }
 
 /**
- * @brief Check if a tile is affected by a spell we are vulnerable to
+ * @brief The kinds of tiles a monster is willing to walk through, monsters that agree on these share flow fields.
  */
-bool IsTileSafe(const Monster &monster, Point position)
+struct MonsterPassability {
+	bool canOpenDoors;
+	bool fearsFire;
+	bool fearsLightning;
+
+	bool operator==(const MonsterPassability &) const = default;
+};
+
+MonsterPassability GetPassability(const Monster &monster)
+{
+	return MonsterPassability {
+		.canOpenDoors = (monster.flags & MFLAG_CAN_OPEN_DOOR) != 0,
+		.fearsFire = (monster.resistance & IMMUNE_FIRE) == 0 || monster.type().type == MT_DIABLO,
+		.fearsLightning = (monster.resistance & IMMUNE_LIGHTNING) == 0 || monster.type().type == MT_DIABLO,
+	};
+}
+
+bool IsTileSafe(MonsterPassability passability, Point position)
 {
 	if (!InDungeonBounds(position))
 		return false;
 
-	const bool fearsFire = (monster.resistance & IMMUNE_FIRE) == 0 || monster.type().type == MT_DIABLO;
-	const bool fearsLightning = (monster.resistance & IMMUNE_LIGHTNING) == 0 || monster.type().type == MT_DIABLO;
+	return !(passability.fearsFire && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileFireWall))
+	    && !(passability.fearsLightning && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileLightningWall));
+}
 
-	return !(fearsFire && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileFireWall))
-	    && !(fearsLightning && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileLightningWall));
+/**
+ * @brief Check if a tile is affected by a spell we are vulnerable to
+ */
+bool IsTileSafe(const Monster &monster, Point position)
+{
+	return IsTileSafe(GetPassability(monster), position);
 }
 
 /**
@@ -1689,14 +1714,97 @@ bool IsTileAccessible(const Monster &monster, Point position)
 	return IsTileSafe(monster, position);
 }
 
+/**
+ * @brief A flow field towards the enemy of some monsters, shared by all of them that have the same passability.
+ */
+struct MonsterFlowField {
+	FlowField field;
+	Point target;
+	MonsterPassability passability;
+	/** @brief Value of MonsterFlowFieldGeneration when the entry was made. */
+	uint32_t generation = 0;
+	/** @brief The field is only built once a second monster asks for it, a lone chaser just runs FindPath. */
+	bool built = false;
+};
+
+/** @brief Room for a few packs chasing different players, the oldest entry gets replaced once they are all taken. */
+std::array<MonsterFlowField, 8> MonsterFlowFields;
+size_t NextMonsterFlowField;
+/** @brief Bumped by InvalidateMonsterFlowFields(), starts at 1 so the default constructed entries are not valid. */
+uint32_t MonsterFlowFieldGeneration = 1;
+/** @brief Tiles that fire and lightning walls were burning on when the monsters were last processed. */
+std::bitset<MAXDUNX * MAXDUNY> FireWallTiles;
+std::bitset<MAXDUNX * MAXDUNY> LightningWallTiles;
+
+/**
+ * @brief Returns the flow field towards `target`, or nullptr the first time it is asked for since the last invalidation.
+ *
+ * The field only accounts for the layout of the level, not where the monsters and players are standing,
+ * so it stays valid while they move around and is kept across game ticks.
+ */
+const FlowField *GetMonsterFlowField(Point target, MonsterPassability passability)
+{
+	for (MonsterFlowField &cached : MonsterFlowFields) {
+		if (cached.generation != MonsterFlowFieldGeneration || cached.passability != passability || cached.target != target)
+			continue;
+		if (!cached.built) {
+			// FindPath skips canStep for the last step when the destination itself is not walkable, so the field
+			// does too. Otherwise it could call a target unreachable that FindPath gets to.
+			cached.field.build(
+			    [target](Point from, Point to) { return to == target || CanStep(from, to); },
+			    [passability](Point position) { return IsTileWalkable(position, passability.canOpenDoors) && IsTileSafe(passability, position); },
+			    target);
+			cached.built = true;
+		}
+		return &cached.field;
+	}
+
+	MonsterFlowField &cached = MonsterFlowFields[NextMonsterFlowField];
+	NextMonsterFlowField = (NextMonsterFlowField + 1) % MonsterFlowFields.size();
+	cached.target = target;
+	cached.passability = passability;
+	cached.generation = MonsterFlowFieldGeneration;
+	cached.built = false;
+	return nullptr;
+}
+
+/**
+ * @brief Forgets the flow fields if a fire or lightning wall was lit or burnt out since the last tick.
+ */
+void InvalidateMonsterFlowFieldsOnWallChange()
+{
+	std::bitset<MAXDUNX * MAXDUNY> fireWallTiles;
+	std::bitset<MAXDUNX * MAXDUNY> lightningWallTiles;
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			if (HasAnyOf(dFlags[i][j], DungeonFlag::MissileFireWall))
+				fireWallTiles.set(i * MAXDUNY + j);
+			if (HasAnyOf(dFlags[i][j], DungeonFlag::MissileLightningWall))
+				lightningWallTiles.set(i * MAXDUNY + j);
+		}
+	}
+	if (fireWallTiles == FireWallTiles && lightningWallTiles == LightningWallTiles)
+		return;
+	FireWallTiles = fireWallTiles;
+	LightningWallTiles = lightningWallTiles;
+	InvalidateMonsterFlowFields();
+}
+
 bool AiPlanWalk(Monster &monster)
 {
 	int8_t path[MaxPathLengthMonsters];
-
 	/** Maps from walking path step to facing direction. */
 	const Direction plr2monst[9] = { Direction::South, Direction::NorthEast, Direction::NorthWest, Direction::SouthEast, Direction::SouthWest, Direction::North, Direction::East, Direction::South, Direction::West };
 
-	if (FindPath(CanStep, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
+	// The field ignores who is standing where, so it reaches everything FindPath does. When the field says the
+	// enemy cannot be reached, there is no need to search. Otherwise the step still comes from FindPath, which
+	// breaks ties between equally short paths its own way.
+	const FlowField *field = GetMonsterFlowField(monster.enemyPosition, GetPassability(monster));
+	if (field != nullptr && field->distance(monster.position.tile) == FlowField::Unreachable) {
+		return false;
+	}
+
+	if (GetPathSearchContext().findPath(CanStep, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
 		return false;
 	}
 
@@ -3116,6 +3224,16 @@ MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
 	return result;
 }
 
+/** @brief Starts reading the files LoadMonsterSpritesData will need, so that happens while the rest of the level loads. */
+void PrefetchMonsterSprites(const MonsterData &monsterData)
+{
+	const FileNameWithCharAffixGenerator generator({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter);
+	for (size_t i = 0, numAnims = GetNumAnims(monsterData); i < numAnims; ++i) {
+		if (monsterData.hasAnim(i))
+			PrefetchAsset(generator(i), AssetLoadPriority::Urgent);
+	}
+}
+
 void EnsureMonsterIndexIsActive(size_t monsterId)
 {
 	assert(monsterId < MaxMonsters);
@@ -3154,6 +3272,7 @@ tl::expected<size_t, std::string> AddMonsterType(_monster_id type, placeflag pla
 			}
 		}
 
+		PrefetchMonsterSprites(monsterData);
 		RETURN_IF_ERROR(InitMonsterSND(monsterType));
 	}
 
@@ -3265,6 +3384,7 @@ void InitLevelMonsters()
 	ClrAllMonsters();
 	ActiveMonsterCount = 0;
 	totalmonsters = MaxMonsters;
+	InvalidateMonsterFlowFields();
 
 	std::iota(std::begin(ActiveMonsters), std::end(ActiveMonsters), 0u);
 	uniquetrans = 0;
@@ -4035,9 +4155,15 @@ void DeleteMonsterList()
 	}
 }
 
+void InvalidateMonsterFlowFields()
+{
+	MonsterFlowFieldGeneration++;
+}
+
 void ProcessMonsters()
 {
 	DeleteMonsterList();
+	InvalidateMonsterFlowFieldsOnWallChange();
 
 	assert(ActiveMonsterCount <= MaxMonsters);
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
@@ -538,6 +538,12 @@ void PrepDoEnding();
 bool Walk(Monster &monster, Direction md);
 void GolumAi(Monster &monster);
 void DeleteMonsterList();
+/**
+ * @brief Forgets the flow fields that the monsters path to their enemies with.
+ *
+ * Must be called whenever the walkability of a tile changes, e.g. a door opening or a barrel breaking.
+ */
+void InvalidateMonsterFlowFields();
 void ProcessMonsters();
 void FreeMonsters();
 bool DirOK(const Monster &monster, Direction mdir);
@@ -0,0 +1,133 @@
+#include "mpq/mpq_block_cache.hpp"
+
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+namespace {
+
+/**
+ * @brief Enough for the blocks of a few streamed sounds and the start of a music track.
+ *
+ * Diablo MPQs use 4 KiB blocks, so this is 1024 blocks.
+ */
+constexpr size_t DefaultBudgetBytes = 4 * 1024 * 1024;
+
+struct BlockKey {
+	uint32_t archiveId;
+	uint32_t fileNumber;
+	uint32_t blockNumber;
+
+	bool operator==(const BlockKey &other) const
+	{
+		return archiveId == other.archiveId && fileNumber == other.fileNumber && blockNumber == other.blockNumber;
+	}
+};
+
+struct BlockKeyHash {
+	size_t operator()(const BlockKey &key) const
+	{
+		const uint64_t fileKey = (static_cast<uint64_t>(key.archiveId) << 32) | key.fileNumber;
+		return std::hash<uint64_t> {}(fileKey * 31 + key.blockNumber);
+	}
+};
+
+struct CachedBlock {
+	BlockKey key;
+	std::unique_ptr<uint8_t[]> data;
+	size_t size;
+};
+
+SdlMutex CacheMutex;
+/** @brief Most recently used first. */
+std::list<CachedBlock> Blocks;
+std::unordered_map<BlockKey, std::list<CachedBlock>::iterator, BlockKeyHash> BlockIndex;
+size_t UsedBytes;
+size_t BudgetBytes = DefaultBudgetBytes;
+size_t Hits;
+size_t Misses;
+size_t Evictions;
+
+void EvictToFit(size_t budget)
+{
+	while (UsedBytes > budget && !Blocks.empty()) {
+		const CachedBlock &oldest = Blocks.back();
+		UsedBytes -= oldest.size;
+		BlockIndex.erase(oldest.key);
+		Blocks.pop_back();
+		++Evictions;
+	}
+}
+
+} // namespace
+
+bool ReadCachedMpqBlock(uint32_t archiveId, uint32_t fileNumber, uint32_t blockNumber, uint8_t *out, size_t size)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	const auto it = BlockIndex.find(BlockKey { archiveId, fileNumber, blockNumber });
+	if (it == BlockIndex.end() || it->second->size != size) {
+		++Misses;
+		return false;
+	}
+	Blocks.splice(Blocks.begin(), Blocks, it->second);
+	std::memcpy(out, it->second->data.get(), size);
+	++Hits;
+	return true;
+}
+
+void CacheMpqBlock(uint32_t archiveId, uint32_t fileNumber, uint32_t blockNumber, const uint8_t *data, size_t size)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	if (size > BudgetBytes)
+		return;
+	const BlockKey key { archiveId, fileNumber, blockNumber };
+	if (BlockIndex.find(key) != BlockIndex.end())
+		return;
+
+	EvictToFit(BudgetBytes - size);
+	std::unique_ptr<uint8_t[]> copy { new uint8_t[size] };
+	std::memcpy(copy.get(), data, size);
+	Blocks.push_front(CachedBlock { key, std::move(copy), size });
+	BlockIndex.emplace(key, Blocks.begin());
+	UsedBytes += size;
+}
+
+void SetMpqBlockCacheBudget(size_t bytes)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	BudgetBytes = bytes;
+	EvictToFit(BudgetBytes);
+}
+
+void ClearMpqBlockCache()
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	Blocks.clear();
+	BlockIndex.clear();
+	UsedBytes = 0;
+	Hits = 0;
+	Misses = 0;
+	Evictions = 0;
+}
+
+MpqBlockCacheStats GetMpqBlockCacheStats()
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	return MpqBlockCacheStats {
+		Hits,
+		Misses,
+		Evictions,
+		Blocks.size(),
+		UsedBytes,
+		BudgetBytes,
+	};
+}
+
+} // namespace devilution
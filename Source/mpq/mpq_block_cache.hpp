@@ -0,0 +1,45 @@
+/**
+ * @file mpq_block_cache.hpp
+ *
+ * A cache of decompressed MPQ blocks, shared by all handles to the same archive.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+struct MpqBlockCacheStats {
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t numBlocks;
+	size_t usedBytes;
+	size_t budgetBytes;
+};
+
+/**
+ * @brief Copies a cached block into `out`.
+ *
+ * @param archiveId MpqArchive::id() of the archive, which clones share with the original.
+ * @return false if the block is not cached.
+ */
+bool ReadCachedMpqBlock(uint32_t archiveId, uint32_t fileNumber, uint32_t blockNumber, uint8_t *out, size_t size);
+
+/**
+ * @brief Stores a copy of a decompressed block, evicting the least recently used blocks to stay within the budget.
+ */
+void CacheMpqBlock(uint32_t archiveId, uint32_t fileNumber, uint32_t blockNumber, const uint8_t *data, size_t size);
+
+/**
+ * @brief Sets the maximum number of bytes of block data to keep. 0 disables the cache.
+ */
+void SetMpqBlockCacheBudget(size_t bytes);
+
+/** @brief Drops all cached blocks and resets the counters. */
+void ClearMpqBlockCache();
+
+MpqBlockCacheStats GetMpqBlockCacheStats();
+
+} // namespace devilution
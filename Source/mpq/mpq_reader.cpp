@@ -1,5 +1,6 @@
 #include "mpq/mpq_reader.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <optional>
 #include <string_view>
@@ -8,6 +9,10 @@
 
 namespace devilution {
 
+namespace {
+std::atomic<uint32_t> NextArchiveId;
+} // namespace
+
 std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 {
 	mpq_archive_s *archive;
@@ -17,7 +22,7 @@ std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 			error = 0;
 		return std::nullopt;
 	}
-	return MpqArchive { std::string(path), archive };
+	return MpqArchive { std::string(path), archive, NextArchiveId++ };
 }
 
 std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
@@ -26,7 +31,7 @@ std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
 	error = libmpq__archive_dup(archive_, path_.c_str(), &copy);
 	if (error != 0)
 		return std::nullopt;
-	return MpqArchive { path_, copy };
+	return MpqArchive { path_, copy, id_ };
 }
 
 const char *MpqArchive::ErrorMessage(int32_t errorCode)
@@ -41,6 +46,7 @@ MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 		libmpq__archive_close(archive_);
 	archive_ = other.archive_;
 	other.archive_ = nullptr;
+	id_ = other.id_;
 	tmp_buf_ = std::move(other.tmp_buf_);
 	return *this;
 }
@@ -145,4 +151,28 @@ bool MpqArchive::HasFile(std::string_view filename) const
 	return error == 0;
 }
 
+bool MpqArchive::GetUnencodedFileRegion(uint32_t fileNumber, std::size_t &offset, std::size_t &size) const
+{
+	uint32_t encrypted;
+	uint32_t compressed;
+	uint32_t imploded;
+	if (libmpq__file_encrypted(archive_, fileNumber, &encrypted) != 0 || encrypted != 0
+	    || libmpq__file_compressed(archive_, fileNumber, &compressed) != 0 || compressed != 0
+	    || libmpq__file_imploded(archive_, fileNumber, &imploded) != 0 || imploded != 0)
+		return false;
+
+	libmpq__off_t packedSize;
+	libmpq__off_t unpackedSize;
+	libmpq__off_t fileOffset;
+	if (libmpq__file_size_packed(archive_, fileNumber, &packedSize) != 0
+	    || libmpq__file_size_unpacked(archive_, fileNumber, &unpackedSize) != 0
+	    || packedSize != unpackedSize
+	    || libmpq__file_offset(archive_, fileNumber, &fileOffset) != 0)
+		return false;
+
+	offset = static_cast<size_t>(fileOffset);
+	size = static_cast<size_t>(unpackedSize);
+	return true;
+}
+
 } // namespace devilution
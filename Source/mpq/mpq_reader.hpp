@@ -29,6 +29,7 @@ public:
 	MpqArchive(MpqArchive &&other) noexcept
 	    : path_(std::move(other.path_))
 	    , archive_(other.archive_)
+	    , id_(other.id_)
 	    , tmp_buf_(std::move(other.tmp_buf_))
 	{
 		other.archive_ = nullptr;
@@ -59,10 +60,25 @@ public:
 
 	bool HasFile(std::string_view filename) const;
 
+	/**
+	 * @brief Finds where the file is stored in the archive file if it is stored as-is,
+	 * i.e. neither compressed nor encrypted.
+	 *
+	 * @param offset Absolute offset of the file data in the archive file.
+	 * @return false if the file data has to be decoded.
+	 */
+	bool GetUnencodedFileRegion(uint32_t fileNumber, std::size_t &offset, std::size_t &size) const;
+
+	[[nodiscard]] const std::string &path() const { return path_; }
+
+	/** @brief Identifies the opened archive file, shared by its clones. */
+	[[nodiscard]] uint32_t id() const { return id_; }
+
 private:
-	MpqArchive(std::string path, mpq_archive_s *archive)
+	MpqArchive(std::string path, mpq_archive_s *archive, uint32_t id)
 	    : path_(std::move(path))
 	    , archive_(archive)
+	    , id_(id)
 	{
 	}
 
@@ -75,6 +91,7 @@ private:
 
 	std::string path_;
 	mpq_archive_s *archive_;
+	uint32_t id_;
 	std::vector<std::uint8_t> tmp_buf_;
 };
 
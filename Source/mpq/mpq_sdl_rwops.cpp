@@ -6,6 +6,8 @@
 #include <string_view>
 #include <vector>
 
+#include "mpq/mpq_block_cache.hpp"
+
 namespace devilution {
 
 namespace {
@@ -19,6 +21,7 @@ struct Data {
 	size_t lastBlockSize;
 	uint32_t numBlocks;
 	size_t size;
+	bool cacheBlocks;
 
 	// State:
 	size_t position;
@@ -113,10 +116,15 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 		const size_t currentBlockSize = blockNumber + 1 == data.numBlocks ? data.lastBlockSize : data.blockSize;
 
 		if (!data.blockRead) {
-			const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
-			if (error != 0) {
-				SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
-				return 0;
+			const uint32_t archiveId = data.mpqArchive->id();
+			if (!data.cacheBlocks || !ReadCachedMpqBlock(archiveId, data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize)) {
+				const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
+				if (error != 0) {
+					SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
+					return 0;
+				}
+				if (data.cacheBlocks)
+					CacheMpqBlock(archiveId, data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
 			}
 			data.blockRead = true;
 		}
@@ -185,6 +193,10 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 		data->mpqArchive = &mpqArchive;
 	}
 	data->fileNumber = fileNumber;
+	// Thread-safe handles are the ones that stream sounds and music, which read the same blocks
+	// again whenever they loop, seek back or are replayed. Whole-file reads are only done once,
+	// caching them would just push those blocks out.
+	data->cacheBlocks = threadsafe;
 	MpqArchive &archive = *data->mpqArchive;
 
 	error = archive.OpenBlockOffsetTable(fileNumber, filename);
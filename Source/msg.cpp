@@ -4,10 +4,12 @@
  * Implementation of function for sending and receiving network messages.
  */
 #include <climits>
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <fmt/format.h>
@@ -222,6 +224,12 @@ struct DLevel {
 	ankerl::unordered_dense::map<WorldTilePosition, DObjectStr> object;
 	ankerl::unordered_dense::map<size_t, DSpawnedMonster> spawnedMonsters;
 	DMonsterStr monster[MaxMonsters];
+	/**
+	 * @brief Compressed CMD_DLEVEL payload from the last export.
+	 *
+	 * Empty when the level has been handed out for modification since then.
+	 */
+	std::vector<std::byte> exportCache;
 };
 
 #pragma pack(push, 1)
@@ -284,12 +292,14 @@ uint8_t GetLevelForMultiplayer(uint8_t level, bool isSetLevel)
 	return level;
 }
 
-/** @brief Gets a delta level. */
+/** @brief Gets a delta level for modification, invalidating its cached export. */
 DLevel &GetDeltaLevel(uint8_t level)
 {
 	auto keyIt = DeltaLevels.find(level);
-	if (keyIt != DeltaLevels.end())
+	if (keyIt != DeltaLevels.end()) {
+		keyIt->second.exportCache.clear();
 		return keyIt->second;
+	}
 	DLevel &deltaLevel = DeltaLevels[level];
 	memset(&deltaLevel.item, 0xFF, sizeof(deltaLevel.item));
 	memset(&deltaLevel.monster, 0xFF, sizeof(deltaLevel.monster));
@@ -665,6 +675,51 @@ uint32_t CompressData(std::byte *buffer, std::byte *end)
 #endif
 }
 
+/** @brief Checks whether a delta level holds nothing a freshly created one wouldn't. */
+bool IsDeltaLevelPristine(const DLevel &deltaLevel)
+{
+	return deltaLevel.object.empty()
+	    && deltaLevel.spawnedMonsters.empty()
+	    && std::all_of(std::begin(deltaLevel.item), std::end(deltaLevel.item), [](const TCmdPItem &item) { return item.bCmd == CMD_INVALID; })
+	    && std::all_of(std::begin(deltaLevel.monster), std::end(deltaLevel.monster), [](const DMonsterStr &monster) { return monster.position.x == 0xFF; });
+}
+
+/**
+ * @brief Gets the compressed CMD_DLEVEL payload for a delta level.
+ *
+ * The payload is kept until the level is next modified, so players joining one after
+ * another don't make the host recompress levels nobody has touched in the meantime.
+ */
+const std::vector<std::byte> &GetDeltaLevelExport(uint8_t levelNum, DLevel &deltaLevel)
+{
+	std::vector<std::byte> &exportCache = deltaLevel.exportCache;
+	if (!exportCache.empty())
+		return exportCache;
+
+	const size_t bufferSize = 1U                                                      /* marker byte, always 0 */
+	    + sizeof(uint8_t)                                                             /* level id */
+	    + sizeof(deltaLevel.item)                                                     /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
+	    + sizeof(uint8_t)                                                             /* count of object interactions which caused a state change since dungeon generation */
+	    + (sizeof(WorldTilePosition) + sizeof(DObjectStr)) * deltaLevel.object.size() /* location/action pairs for the object interactions */
+	    + sizeof(deltaLevel.monster)                                                  /* latest monster state */
+	    + sizeof(uint16_t)                                                            /* spanwned monster count */
+	    + (sizeof(uint16_t) + sizeof(DSpawnedMonster)) * MaxMonsters;                 /* spanwned monsters */
+	exportCache.resize(bufferSize);
+
+	std::byte *dst = exportCache.data();
+	std::byte *dstEnd = &dst[1];
+	*dstEnd = static_cast<std::byte>(levelNum);
+	dstEnd += sizeof(uint8_t);
+	dstEnd = DeltaExportItem(dstEnd, deltaLevel.item);
+	dstEnd = DeltaExportObject(dstEnd, deltaLevel.object);
+	dstEnd = DeltaExportMonster(dstEnd, deltaLevel.monster);
+	dstEnd = DeltaExportSpawnedMonsters(dstEnd, deltaLevel.spawnedMonsters);
+	exportCache.resize(CompressData(dst, dstEnd));
+	exportCache.shrink_to_fit();
+
+	return exportCache;
+}
+
 void DeltaImportData(_cmd_id cmd, uint32_t recvOffset)
 {
 #ifdef USE_PKWARE
@@ -2504,26 +2559,12 @@ void run_delta_info()
 
 void DeltaExportData(uint8_t pnum)
 {
-	for (const auto &[levelNum, deltaLevel] : DeltaLevels) {
-		const size_t bufferSize = 1U                                                      /* marker byte, always 0 */
-		    + sizeof(uint8_t)                                                             /* level id */
-		    + sizeof(deltaLevel.item)                                                     /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
-		    + sizeof(uint8_t)                                                             /* count of object interactions which caused a state change since dungeon generation */
-		    + (sizeof(WorldTilePosition) + sizeof(DObjectStr)) * deltaLevel.object.size() /* location/action pairs for the object interactions */
-		    + sizeof(deltaLevel.monster)                                                  /* latest monster state */
-		    + sizeof(uint16_t)                                                            /* spanwned monster count */
-		    + (sizeof(uint16_t) + sizeof(DSpawnedMonster)) * MaxMonsters;                 /* spanwned monsters */
-		std::unique_ptr<std::byte[]> dst { new std::byte[bufferSize] };
-
-		std::byte *dstEnd = &dst.get()[1];
-		*dstEnd = static_cast<std::byte>(levelNum);
-		dstEnd += sizeof(uint8_t);
-		dstEnd = DeltaExportItem(dstEnd, deltaLevel.item);
-		dstEnd = DeltaExportObject(dstEnd, deltaLevel.object);
-		dstEnd = DeltaExportMonster(dstEnd, deltaLevel.monster);
-		dstEnd = DeltaExportSpawnedMonsters(dstEnd, deltaLevel.spawnedMonsters);
-		uint32_t size = CompressData(dst.get(), dstEnd);
-		multi_send_zero_packet(pnum, CMD_DLEVEL, dst.get(), size);
+	for (auto &[levelNum, deltaLevel] : DeltaLevels) {
+		// The receiver creates untouched levels on demand, so there is no point sending them
+		if (IsDeltaLevelPristine(deltaLevel))
+			continue;
+		const std::vector<std::byte> &payload = GetDeltaLevelExport(levelNum, deltaLevel);
+		multi_send_zero_packet(pnum, CMD_DLEVEL, payload.data(), payload.size());
 	}
 
 	std::byte dst[sizeof(DJunk) + 1];
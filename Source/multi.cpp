@@ -18,6 +18,7 @@
 #include "engine/demomode.h"
 #include "engine/point.hpp"
 #include "engine/random.hpp"
+#include "engine/tick_profiler.hpp"
 #include "engine/world_tile.hpp"
 #include "menu.h"
 #include "nthread.h"
@@ -706,6 +707,8 @@ void multi_process_network_packets()
 				}
 			}
 		}
+		if (TickProfilerEnabled)
+			TickProfilerRecordNetworkLatency(SNetGetMessageQueueTime());
 		HandleAllPackets(playerId, (const std::byte *)(pkt + 1), dwMsgSize - sizeof(TPktHdr));
 	}
 	CheckPlayerInfoTimeouts();
@@ -259,40 +259,44 @@ void LoadObjectData()
 	const std::string_view filename = "txtdata\\objects\\objdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
 	dataFile.skipHeaderOrDie(filename);
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
 
-	AllObjects.clear();
-	ObjMasterLoadList.clear();
+	do {
+		AllObjects.clear();
+		ObjMasterLoadList.clear();
 
-	ankerl::unordered_dense::map<std::string, uint8_t> filenameToId;
+		ankerl::unordered_dense::map<std::string, uint8_t> filenameToId;
 
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		ObjectData &item = AllObjects.emplace_back();
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			ObjectData &item = AllObjects.emplace_back();
 
-		reader.advance(); // skip id
+			reader.advance(); // skip id
 
-		std::string filename;
-		reader.readString("file", filename);
-		if (const auto it = filenameToId.find(filename); it != filenameToId.end()) {
-			item.ofindex = it->second;
-		} else {
-			const auto id = static_cast<uint8_t>(ObjMasterLoadList.size());
-			ObjMasterLoadList.push_back(filename);
-			filenameToId.emplace(std::move(filename), id);
-			item.ofindex = id;
-		}
+			std::string filename;
+			reader.readString("file", filename);
+			if (const auto it = filenameToId.find(filename); it != filenameToId.end()) {
+				item.ofindex = it->second;
+			} else {
+				const auto id = static_cast<uint8_t>(ObjMasterLoadList.size());
+				ObjMasterLoadList.push_back(filename);
+				filenameToId.emplace(std::move(filename), id);
+				item.ofindex = id;
+			}
 
-		reader.readInt("minLevel", item.minlvl);
-		reader.readInt("maxLevel", item.maxlvl);
-		reader.read("levelType", item.olvltype, ParseDungeonType);
-		reader.read("theme", item.otheme, ParseTheme);
-		reader.read("quest", item.oquest, ParseQuest);
-		reader.readEnumList("flags", item.flags, ParseObjectDataFlags);
-		reader.readInt("animDelay", item.animDelay);
-		reader.readInt("animLen", item.animLen);
-		reader.readInt("animWidth", item.animWidth);
-		reader.readEnumList("selectionRegion", item.selectionRegion, ParseSelectionRegion);
-	}
+			reader.readInt("minLevel", item.minlvl);
+			reader.readInt("maxLevel", item.maxlvl);
+			reader.read("levelType", item.olvltype, ParseDungeonType);
+			reader.read("theme", item.otheme, ParseTheme);
+			reader.read("quest", item.oquest, ParseQuest);
+			reader.readEnumList("flags", item.flags, ParseObjectDataFlags);
+			reader.readInt("animDelay", item.animDelay);
+			reader.readInt("animLen", item.animLen);
+			reader.readInt("animWidth", item.animWidth);
+			reader.readEnumList("selectionRegion", item.selectionRegion, ParseSelectionRegion);
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 
 	// Sanity check because we do not actually parse the IDs yet.
 	assert(static_cast<size_t>(OBJ_LAST) + 1 == AllObjects.size());
@@ -724,6 +724,8 @@ GraphicsOptions::GraphicsOptions()
     , brightness("Brightness Correction", OptionEntryFlags::Invisible, "Brightness Correction", "Brightness correction level.", 0)
     , zoom("Zoom", OptionEntryFlags::None, N_("Zoom"), N_("Zoom on when enabled."), false)
     , perPixelLighting("Per-pixel Lighting", OptionEntryFlags::None, N_("Per-pixel Lighting"), N_("Subtile lighting for smoother light gradients."), DEFAULT_PER_PIXEL_LIGHTING)
+    , multithreadedRendering("Multithreaded Rendering", OptionEntryFlags::None, N_("Multithreaded Rendering"), N_("Renders the dungeon on several CPU cores. Helps at high resolutions with per-pixel lighting."), false)
+    , partialRedraw("Partial Redraw", OptionEntryFlags::None, N_("Partial Redraw"), N_("Only redraws the parts of the game view that changed. Saves battery when little is moving on screen."), false)
     , colorCycling("Color Cycling", OptionEntryFlags::None, N_("Color Cycling"), N_("Color cycling effect used for water, lava, and acid animation."), true)
     , alternateNestArt("Alternate nest art", OptionEntryFlags::OnlyHellfire | OptionEntryFlags::CantChangeInGame, N_("Alternate nest art"), N_("The game will use an alternative palette for Hellfire’s nest tileset."), false)
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -755,6 +757,8 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&zoom,
 		&showFPS,
 		&perPixelLighting,
+		&multithreadedRendering,
+		&partialRedraw,
 		&colorCycling,
 		&alternateNestArt,
 #if SDL_VERSION_ATLEAST(2, 0, 0)
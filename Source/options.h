@@ -532,6 +532,10 @@ struct GraphicsOptions : OptionCategoryBase {
 	OptionEntryBoolean zoom;
 	/** @brief Subtile lighting for smoother light gradients. */
 	OptionEntryBoolean perPixelLighting;
+	/** @brief Render the dungeon in horizontal bands on several threads. */
+	OptionEntryBoolean multithreadedRendering;
+	/** @brief Only redraw the parts of the game view that changed since the previous frame. */
+	OptionEntryBoolean partialRedraw;
 	/** @brief Enable color cycling animations. */
 	OptionEntryBoolean colorCycling;
 	/** @brief Use alternate nest palette. */
@@ -5,7 +5,9 @@
  */
 #include "pfile.h"
 
+#include <atomic>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -26,8 +28,10 @@
 #include "utils/endian_read.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
+#include "utils/sdl_thread.h"
 #include "utils/stdcompat/filesystem.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
@@ -152,19 +156,115 @@ void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
 	saveWriter.WriteFile("hero", packed.get(), packedLen);
 }
 
+void EncodeHero(SaveSnapshot &snapshot, const PlayerPack *pack)
+{
+	std::unique_ptr<std::byte[]> packed { new std::byte[codec_get_encoded_len(sizeof(*pack))] };
+	memcpy(packed.get(), pack, sizeof(*pack));
+	snapshot.AddFile("hero", std::move(packed), sizeof(*pack));
+}
+
+/** @brief Save data captured on the game thread, waiting to be written by the autosave thread. */
+struct Autosave {
+	std::optional<SaveSnapshot> hero;
+	std::optional<SaveSnapshot> stash;
+};
+
+SdlThread AutosaveThread;
+std::atomic<bool> AutosaveFinished;
+/** @brief Set by the autosave thread when the stash couldn't be written, so that it is saved again. */
+std::atomic<bool> StashAutosaveFailed;
+/** @brief Snapshot taken since the autosave thread was last started. */
+std::unique_ptr<Autosave> PendingAutosave;
+
+int SDLCALL AutosaveThreadMain(void *data)
+{
+	std::unique_ptr<Autosave> autosave { static_cast<Autosave *>(data) };
+	if (autosave->hero)
+		autosave->hero->Commit();
+	if (autosave->stash && !autosave->stash->Commit())
+		StashAutosaveFailed = true;
+	AutosaveFinished = true;
+	return 0;
+}
+
+/**
+ * @brief Captures the hero and stash so they can be written without blocking the game.
+ *
+ * Replaces any snapshot that has not been handed to the autosave thread yet.
+ */
+void QueueAutosave()
+{
+	auto autosave = std::make_unique<Autosave>();
+
+	PlayerPack pkplr;
+	Player &myPlayer = *MyPlayer;
+	PackPlayer(pkplr, myPlayer);
+	SaveSnapshot &hero = autosave->hero.emplace(GetSavePath(gSaveNumber), pfile_get_password());
+	EncodeHero(hero, &pkplr);
+	if (!gbVanilla) {
+		SaveHotkeys(hero, myPlayer);
+		SaveHeroItems(hero, myPlayer);
+	}
+
+	if (StashAutosaveFailed.exchange(false))
+		Stash.dirty = true;
+	if (Stash.dirty) {
+		SaveStash(autosave->stash.emplace(GetStashSavePath(), pfile_get_password()));
+		Stash.dirty = false;
+	} else if (PendingAutosave != nullptr) {
+		autosave->stash = std::move(PendingAutosave->stash);
+	}
+
+	PendingAutosave = std::move(autosave);
+}
+
+/** @brief Hands the pending snapshot to the autosave thread unless it is still busy. */
+void StartPendingAutosave()
+{
+	if (PendingAutosave == nullptr)
+		return;
+	if (AutosaveThread.joinable()) {
+		if (!AutosaveFinished)
+			return;
+		AutosaveThread.join();
+	}
+
+	AutosaveFinished = false;
+	AutosaveThread = SdlThread { AutosaveThreadMain, PendingAutosave.release() };
+}
+
+/** @brief Waits for the autosave thread and writes out any snapshot that is still pending. */
+void FinishAutosave()
+{
+	AutosaveThread.join();
+	if (StashAutosaveFailed.exchange(false))
+		Stash.dirty = true;
+	if (PendingAutosave == nullptr)
+		return;
+
+	std::unique_ptr<Autosave> autosave = std::move(PendingAutosave);
+	if (autosave->hero)
+		autosave->hero->Commit();
+	if (autosave->stash && !autosave->stash->Commit())
+		Stash.dirty = true;
+}
+
 SaveWriter GetSaveWriter(uint32_t saveNum)
 {
+	FinishAutosave();
 	return SaveWriter(GetSavePath(saveNum));
 }
 
 SaveWriter GetStashWriter()
 {
+	FinishAutosave();
 	return SaveWriter(GetStashSavePath());
 }
 
 #ifndef DISABLE_DEMOMODE
 void CopySaveFile(uint32_t saveNum, std::string targetPath)
 {
+	FinishAutosave();
 	const std::string savePath = GetSavePath(saveNum);
 #if defined(UNPACKED_SAVES)
 #ifdef DVL_NO_FILESYSTEM
@@ -450,6 +550,7 @@ struct CompareTargets {
 
 HeroCompareResult CompareSaves(const std::string &actualSavePath, const std::string &referenceSavePath, bool logDetails)
 {
+	FinishAutosave();
 	std::vector<CompareTargets> possibleFileToCheck;
 	possibleFileToCheck.push_back({ "hero", "hero", false });
 	possibleFileToCheck.push_back({ "game", "game", false });
@@ -581,13 +682,61 @@ void SaveWriter::RemoveHashEntries(bool (*fnGetName)(uint8_t, char *))
 }
 #endif
 
+void SaveSnapshot::AddFile(const char *filename, std::unique_ptr<std::byte[]> data, size_t size)
+{
+	files_.push_back(File { filename, std::move(data), size });
+}
+
+bool SaveSnapshot::Commit()
+{
+	for (File &file : files_) {
+		const size_t encodedLen = codec_get_encoded_len(file.size);
+		codec_encode(file.data.get(), file.size, encodedLen, password_);
+		file.size = encodedLen;
+	}
+
+#ifdef UNPACKED_SAVES
+	SaveWriter saveWriter { std::string(path_) };
+	for (const File &file : files_) {
+		const std::string tempName = StrCat(file.name, ".tmp");
+		if (!saveWriter.WriteFile(tempName.c_str(), file.data.get(), file.size)
+		    || !SyncAndReplaceFile((path_ + tempName).c_str(), (path_ + file.name).c_str())) {
+			LogError("Failed to save {}{}", path_, file.name);
+			return false;
+		}
+	}
+#else
+	const std::string tempPath = StrCat(path_, ".tmp");
+	if (FileExists(path_))
+		CopyFileOverwrite(path_.c_str(), tempPath.c_str());
+	else
+		RemoveFile(tempPath.c_str());
+	{
+		SaveWriter saveWriter(tempPath);
+		for (const File &file : files_) {
+			if (!saveWriter.WriteFile(file.name, file.data.get(), file.size)) {
+				LogError("Failed to write {} to {}", file.name, tempPath);
+				return false;
+			}
+		}
+	}
+	if (!SyncAndReplaceFile(tempPath.c_str(), path_.c_str())) {
+		LogError("Failed to replace {}", path_);
+		return false;
+	}
+#endif
+	return true;
+}
+
 std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum)
 {
+	FinishAutosave();
 	return CreateSaveReader(GetSavePath(saveNum));
 }
 
 std::optional<SaveReader> OpenStashArchive()
 {
+	FinishAutosave();
 	return CreateSaveReader(GetStashSavePath());
 }
 
@@ -746,6 +895,7 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 {
 	uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
+		FinishAutosave();
 		hero_names[saveNum][0] = '\0';
 		RemoveFile(GetSavePath(saveNum).c_str());
 	}
@@ -802,12 +952,11 @@ void pfile_update(bool forceSave)
 		return;
 
 	Uint32 tick = SDL_GetTicks();
-	if (!forceSave && tick - prevTick <= 60000)
-		return;
-
-	prevTick = tick;
-	pfile_write_hero();
-	sfile_write_stash();
+	if (forceSave || tick - prevTick > 60000) {
+		prevTick = tick;
+		QueueAutosave();
+	}
+	StartPendingAutosave();
 }
 
 } // namespace devilution
@@ -6,7 +6,9 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -83,6 +85,44 @@ using SaveReader = MpqArchive;
 using SaveWriter = MpqWriter;
 #endif
 
+/**
+ * @brief Save files captured in memory, to be encoded and written to their archive later.
+ *
+ * The snapshot doesn't refer to any game state, so it can be committed on another thread.
+ */
+class SaveSnapshot {
+public:
+	SaveSnapshot(std::string &&path, const char *password)
+	    : path_(std::move(path))
+	    , password_(password)
+	{
+	}
+
+	/**
+	 * @brief Adds a file to the snapshot.
+	 * @param data Buffer of codec_get_encoded_len(size) bytes, the first size of which are the file contents.
+	 */
+	void AddFile(const char *filename, std::unique_ptr<std::byte[]> data, size_t size);
+
+	/**
+	 * @brief Encodes the files and writes them to the archive.
+	 *
+	 * The archive is updated through a temporary copy that replaces it once it has been flushed to disk.
+	 */
+	bool Commit();
+
+private:
+	struct File {
+		std::string name;
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	std::string path_;
+	const char *password_;
+	std::vector<File> files_;
+};
+
 /**
  * @brief Comparison result of pfile_compare_hero_demo
  */
@@ -934,7 +934,12 @@ bool Quest::IsAvailable()
 {
 	if (setlevel)
 		return false;
-	if (currlevel != _qlevel)
+	return IsAvailableOn(currlevel);
+}
+
+bool Quest::IsAvailableOn(uint8_t level) const
+{
+	if (level != _qlevel)
 		return false;
 	if (_qactive == QUEST_NOTAVAIL)
 		return false;
@@ -92,6 +92,8 @@ struct Quest {
 	uint8_t _qvar2;
 
 	bool IsAvailable();
+	/** @brief Same as IsAvailable(), but for the given dungeon level instead of the current one */
+	bool IsAvailableOn(uint8_t level) const;
 };
 
 struct QuestData {
@@ -229,31 +229,35 @@ tl::expected<SpellID, std::string> ParseSpellId(std::string_view value)
 
 void LoadSpellData()
 {
-	SpellsData.clear();
 	const std::string_view filename = "txtdata\\spells\\spelldat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
-	SpellsData.reserve(dataFile.numRecords() + 1);
-	AddNullSpell();
 	dataFile.skipHeaderOrDie(filename);
-	for (DataFileRecord record : dataFile) {
-		RecordReader reader { record, filename };
-		SpellData &item = SpellsData.emplace_back();
-		reader.advance(); // skip id
-		reader.readString("name", item.sNameText);
-		reader.read("soundId", item.sSFX, ParseSpellSoundId);
-		reader.readInt("bookCost10", item.bookCost10);
-		reader.readInt("staffCost10", item.staffCost10);
-		reader.readInt("manaCost", item.sManaCost);
-		reader.readEnumList("flags", item.flags, ParseSpellDataFlag);
-		reader.readInt("bookLevel", item.sBookLvl);
-		reader.readInt("staffLevel", item.sStaffLvl);
-		reader.readInt("minIntelligence", item.minInt);
-		reader.readEnumArray("missiles", /*fillMissing=*/std::make_optional(MissileID::Null), item.sMissiles, ParseMissileId);
-		reader.readInt("manaMultiplier", item.sManaAdj);
-		reader.readInt("minMana", item.sMinMana);
-		reader.readInt("staffMin", item.sStaffMin);
-		reader.readInt("staffMax", item.sStaffMax);
-	}
+	RecordCache cache { filename, dataFile, /*schemaVersion=*/1 };
+	do {
+		SpellsData.clear();
+		SpellsData.reserve(dataFile.numRecords() + 1);
+		AddNullSpell();
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, filename, cache };
+			SpellData &item = SpellsData.emplace_back();
+			reader.advance(); // skip id
+			reader.readString("name", item.sNameText);
+			reader.read("soundId", item.sSFX, ParseSpellSoundId);
+			reader.readInt("bookCost10", item.bookCost10);
+			reader.readInt("staffCost10", item.staffCost10);
+			reader.readInt("manaCost", item.sManaCost);
+			reader.readEnumList("flags", item.flags, ParseSpellDataFlag);
+			reader.readInt("bookLevel", item.sBookLvl);
+			reader.readInt("staffLevel", item.sStaffLvl);
+			reader.readInt("minIntelligence", item.minInt);
+			reader.readEnumArray("missiles", /*fillMissing=*/std::make_optional(MissileID::Null), item.sMissiles, ParseMissileId);
+			reader.readInt("manaMultiplier", item.sManaAdj);
+			reader.readInt("minMana", item.sMinMana);
+			reader.readInt("staffMin", item.sStaffMin);
+			reader.readInt("staffMax", item.sStaffMax);
+		}
+	} while (!cache.finishReplay());
+	cache.save();
 	SpellsData.shrink_to_fit();
 }
 
@@ -38,6 +38,14 @@ bool SNetReceiveMessage(uint8_t *senderplayerid, void **data, size_t *databytes)
 	return dvlnet_inst->SNetReceiveMessage(senderplayerid, data, databytes);
 }
 
+uint64_t SNetGetMessageQueueTime()
+{
+#ifndef NONET
+	std::lock_guard<SdlMutex> lg(storm_net_mutex);
+#endif
+	return dvlnet_inst->SNetGetMessageQueueTime();
+}
+
 bool SNetSendMessage(uint8_t playerID, void *data, size_t databytes)
 {
 #ifndef NONET
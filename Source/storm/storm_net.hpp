@@ -88,6 +88,12 @@ bool SNetJoinGame(char *gameName, char *gamePassword, int *playerid);
 bool SNetLeaveGame(int type);
 
 bool SNetReceiveMessage(uint8_t *senderplayerid, void **data, size_t *databytes);
+
+/**
+ * @brief Nanoseconds the message last returned by SNetReceiveMessage() waited between
+ * being read from the network and being handed to the game, 0 if the provider doesn't know.
+ */
+uint64_t SNetGetMessageQueueTime();
 bool SNetReceiveTurns(int arraysize, char **arraydata, size_t *arraydatabytes, uint32_t *arrayplayerstatus);
 
 typedef void (*SEVTHANDLER)(struct _SNETEVENT *);
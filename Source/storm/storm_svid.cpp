@@ -237,6 +237,7 @@ bool BlitFrame()
 		}
 	}
 
+	InvalidateOutputSurface();
 	RenderPresent();
 	return true;
 }
@@ -404,6 +405,7 @@ void SVidPlayEnd()
 		if (renderer != nullptr && SDL_RenderSetLogicalSize(renderer, gnScreenWidth, gnScreenHeight) <= -1) {
 			ErrSdl();
 		}
+		InvalidateOutputSurface();
 	}
 #else
 	if (IsSVidVideoMode) {
@@ -29,6 +29,7 @@
 #endif
 
 #if (_POSIX_C_SOURCE >= 200112L || defined(_BSD_SOURCE) || defined(__APPLE__)) && !defined(DEVILUTIONX_WINDOWS_NO_WCHAR)
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -376,6 +377,46 @@ void RenameFile(const char *from, const char *to)
 #endif
 }
 
+bool SyncAndReplaceFile(const char *from, const char *to)
+{
+#ifdef _WIN32
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	// MoveFileEx is not available on Windows 9x
+	::DeleteFile(to);
+	return ::MoveFile(from, to) != 0;
+#else
+	const auto fromUtf16 = ToWideChar(from);
+	const auto toUtf16 = ToWideChar(to);
+	if (fromUtf16 == nullptr || toUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	return ::MoveFileExW(&fromUtf16[0], &toUtf16[0], MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#endif // _WIN32
+#else
+#if _POSIX_C_SOURCE >= 200112L || defined(_BSD_SOURCE) || defined(__APPLE__)
+	const int fd = ::open(from, O_RDONLY);
+	if (fd == -1) {
+		LogError("Failed to open {} for syncing: {}", from, std::strerror(errno));
+		return false;
+	}
+	const bool synced = ::fsync(fd) == 0;
+	::close(fd);
+	if (!synced) {
+		LogError("Failed to sync {}: {}", from, std::strerror(errno));
+		return false;
+	}
+#endif
+#ifdef DVL_HAS_FILESYSTEM
+	std::error_code ec;
+	std::filesystem::rename(reinterpret_cast<const char8_t *>(from), reinterpret_cast<const char8_t *>(to), ec);
+	return !ec;
+#else
+	return ::rename(from, to) == 0;
+#endif
+#endif
+}
+
 void CopyFileOverwrite(const char *from, const char *to)
 {
 #ifdef _WIN32
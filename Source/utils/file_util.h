@@ -39,6 +39,15 @@ bool CreateDir(const char *path);
 void RecursivelyCreateDir(const char *path);
 bool ResizeFile(const char *path, std::uintmax_t size);
 void RenameFile(const char *from, const char *to);
+
+/**
+ * @brief Flushes `from` to disk and renames it to `to`, replacing `to` if it exists.
+ *
+ * Where the platform supports it, `to` holds either its old or its new contents at any point,
+ * even if the game or the system crashes halfway through.
+ */
+bool SyncAndReplaceFile(const char *from, const char *to);
+
 void CopyFileOverwrite(const char *from, const char *to);
 void RemoveFile(const char *path);
 FILE *OpenFile(const char *path, const char *mode);
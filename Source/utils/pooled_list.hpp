@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief A replacement for std::list that keeps its elements in reusable chunks instead of allocating each one.
+ *
+ * Like std::list, elements never move, iteration follows insertion order and elements added while iterating are
+ * visited by that same iteration. Removing elements is only supported through remove_if and clear, outside of iteration.
+ *
+ * @tparam T element type, must be default constructible.
+ * @tparam ChunkSize number of elements allocated at once.
+ */
+template <typename T, size_t ChunkSize = 64>
+class PooledList {
+	template <bool IsConst>
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T *, T *>;
+		using reference = std::conditional_t<IsConst, const T &, T &>;
+
+		Iterator() = default;
+
+		Iterator(const std::vector<T *> *elements, size_t index)
+		    : elements_(elements)
+		    , index_(index)
+		{
+		}
+
+		operator Iterator<true>() const
+		{
+			return { elements_, index_ };
+		}
+
+		reference operator*() const
+		{
+			return *(*elements_)[index_];
+		}
+
+		pointer operator->() const
+		{
+			return (*elements_)[index_];
+		}
+
+		Iterator &operator++()
+		{
+			++index_;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator copy = *this;
+			++index_;
+			return copy;
+		}
+
+		/** The end iterator compares equal to any iterator that went past the last element, including ones added after it was taken. */
+		bool operator==(const Iterator &other) const
+		{
+			if (atEnd() || other.atEnd())
+				return atEnd() == other.atEnd();
+			return index_ == other.index_;
+		}
+
+	private:
+		[[nodiscard]] bool atEnd() const
+		{
+			return elements_ == nullptr || index_ >= elements_->size();
+		}
+
+		const std::vector<T *> *elements_ = nullptr;
+		size_t index_ = 0;
+	};
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+	using size_type = size_t;
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	PooledList() = default;
+	PooledList(const PooledList &) = delete;
+	PooledList &operator=(const PooledList &) = delete;
+
+	[[nodiscard]] iterator begin() { return { &elements_, 0 }; }
+	[[nodiscard]] const_iterator begin() const { return { &elements_, 0 }; }
+	[[nodiscard]] const_iterator cbegin() const { return begin(); }
+
+	[[nodiscard]] iterator end() { return { &elements_, EndIndex }; }
+	[[nodiscard]] const_iterator end() const { return { &elements_, EndIndex }; }
+	[[nodiscard]] const_iterator cend() const { return end(); }
+
+	[[nodiscard]] size_t size() const { return elements_.size(); }
+	[[nodiscard]] bool empty() const { return elements_.empty(); }
+	[[nodiscard]] size_t max_size() const { return elements_.max_size(); } // NOLINT(readability-identifier-naming)
+
+	[[nodiscard]] T &front() { return *elements_.front(); }
+	[[nodiscard]] const T &front() const { return *elements_.front(); }
+	[[nodiscard]] T &back() { return *elements_.back(); }
+	[[nodiscard]] const T &back() const { return *elements_.back(); }
+
+	template <typename... Args>
+	T &emplace_back(Args &&...args) // NOLINT(readability-identifier-naming)
+	{
+		T *element = allocate();
+		*element = T { std::forward<Args>(args)... };
+		elements_.push_back(element);
+		return *element;
+	}
+
+	void push_back(const T &value) // NOLINT(readability-identifier-naming)
+	{
+		emplace_back(value);
+	}
+
+	/**
+	 * @brief Removes every element matching the predicate, keeping the order of the others.
+	 * @return The number of removed elements.
+	 */
+	template <typename Predicate>
+	size_t remove_if(Predicate &&predicate) // NOLINT(readability-identifier-naming)
+	{
+		size_t kept = 0;
+		for (T *element : elements_) {
+			if (predicate(*element)) {
+				release(element);
+			} else {
+				elements_[kept++] = element;
+			}
+		}
+		const size_t removed = elements_.size() - kept;
+		elements_.resize(kept);
+		return removed;
+	}
+
+	void clear()
+	{
+		for (T *element : elements_)
+			release(element);
+		elements_.clear();
+	}
+
+private:
+	static constexpr size_t EndIndex = std::numeric_limits<size_t>::max();
+
+	T *allocate()
+	{
+		if (free_.empty()) {
+			std::array<T, ChunkSize> &chunk = *chunks_.emplace_back(std::make_unique<std::array<T, ChunkSize>>());
+			// Reversed so the chunk gets used from the front.
+			for (auto it = chunk.rbegin(); it != chunk.rend(); ++it)
+				free_.push_back(&*it);
+		}
+		T *element = free_.back();
+		free_.pop_back();
+		return element;
+	}
+
+	void release(T *element)
+	{
+		*element = T {};
+		free_.push_back(element);
+	}
+
+	std::vector<std::unique_ptr<std::array<T, ChunkSize>>> chunks_;
+	/** @brief The elements in insertion order. */
+	std::vector<T *> elements_;
+	/** @brief Unused elements, the most recently removed last so it's reused while still in the cache. */
+	std::vector<T *> free_;
+};
+
+} // namespace devilution
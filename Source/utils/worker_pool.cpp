@@ -0,0 +1,107 @@
+#include "utils/worker_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "appfat.h"
+
+namespace devilution {
+
+WorkerPool::WorkerPool(unsigned threadCount)
+    : wake_(SDL_CreateCond())
+    , idle_(SDL_CreateCond())
+    , initialGeneration_(generation_)
+{
+	if (wake_ == nullptr || idle_ == nullptr)
+		ErrSdl();
+	threads_.reserve(threadCount);
+	for (unsigned i = 0; i < threadCount; i++)
+		threads_.emplace_back(WorkerMain, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		stop_ = true;
+		SDL_CondBroadcast(wake_);
+	}
+	for (SdlThread &thread : threads_)
+		thread.join();
+	SDL_DestroyCond(idle_);
+	SDL_DestroyCond(wake_);
+}
+
+unsigned WorkerPool::DefaultThreadCount()
+{
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return static_cast<unsigned>(std::clamp(SDL_GetCPUCount() - 1, 0, 7));
+#else
+	return 0;
+#endif
+}
+
+int SDLCALL WorkerPool::WorkerMain(void *data)
+{
+	static_cast<WorkerPool *>(data)->runLoop();
+	return 0;
+}
+
+void WorkerPool::runLoop()
+{
+	mutex_.lock();
+	// Start from the generation the pool was created with rather than the current one: a loop that started
+	// before this thread got the mutex counts this thread as busy and has to be run.
+	uint32_t seenGeneration = initialGeneration_;
+	while (true) {
+		while (!stop_ && generation_ == seenGeneration)
+			SDL_CondWait(wake_, mutex_.get());
+		if (stop_)
+			break;
+		seenGeneration = generation_;
+		mutex_.unlock();
+
+		runIterations();
+
+		mutex_.lock();
+		if (--busy_ == 0)
+			SDL_CondSignal(idle_);
+	}
+	mutex_.unlock();
+}
+
+void WorkerPool::runIterations()
+{
+	for (unsigned i = next_.fetch_add(1, std::memory_order_relaxed); i < count_; i = next_.fetch_add(1, std::memory_order_relaxed))
+		(*fn_)(i);
+}
+
+void WorkerPool::parallelFor(unsigned count, tl::function_ref<void(unsigned)> fn)
+{
+	if (threads_.empty() || count <= 1) {
+		for (unsigned i = 0; i < count; i++)
+			fn(i);
+		return;
+	}
+
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		fn_.emplace(fn);
+		count_ = count;
+		next_.store(0, std::memory_order_relaxed);
+		busy_ = static_cast<unsigned>(threads_.size());
+		generation_++;
+		SDL_CondBroadcast(wake_);
+	}
+
+	runIterations();
+
+	// Every worker has to acknowledge the loop before returning, otherwise a slow one
+	// could pick up an iteration of the next loop while still holding this loop's `fn`.
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	while (busy_ != 0)
+		SDL_CondWait(idle_, mutex_.get());
+	fn_ = std::nullopt;
+}
+
+} // namespace devilution
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <SDL.h>
+#include <function_ref.hpp>
+
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+/**
+ * @brief A fixed set of threads that split the iterations of a loop between them.
+ *
+ * The calling thread takes part in every loop, so a pool without any worker threads
+ * simply runs the loop serially.
+ */
+class WorkerPool final {
+public:
+	explicit WorkerPool(unsigned threadCount);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	/** @brief Number of threads running the iterations of a loop, including the calling thread. */
+	[[nodiscard]] unsigned concurrency() const
+	{
+		return static_cast<unsigned>(threads_.size()) + 1;
+	}
+
+	/**
+	 * @brief Calls `fn(i)` for every `i` in `[0, count)` and returns once all the calls finished.
+	 *
+	 * Must not be called from within `fn`.
+	 */
+	void parallelFor(unsigned count, tl::function_ref<void(unsigned)> fn);
+
+	/** @brief One worker thread per additional CPU core, capped to keep the synchronization cheap. */
+	static unsigned DefaultThreadCount();
+
+private:
+	static int SDLCALL WorkerMain(void *data);
+
+	void runLoop();
+	void runIterations();
+
+	SdlMutex mutex_;
+	SDL_cond *wake_;
+	SDL_cond *idle_;
+	std::vector<SdlThread> threads_;
+
+	std::optional<tl::function_ref<void(unsigned)>> fn_;
+	unsigned count_ = 0;
+	std::atomic<unsigned> next_ = 0;
+	/** @brief Worker threads that have not yet finished the current loop, guarded by mutex_. */
+	unsigned busy_ = 0;
+	/** @brief Incremented for every loop so sleeping workers can tell it apart from the previous one. */
+	uint32_t generation_ = 0;
+	/** @brief generation_ before any worker thread was started, where every worker begins. */
+	const uint32_t initialGeneration_;
+	bool stop_ = false;
+};
+
+} // namespace devilution
@@ -96,6 +96,7 @@ set(devilutionx_fixtures
   text_render_integration_test/kerning_fit_spacing__align_right.png
   text_render_integration_test/vertical_overflow.png
   text_render_integration_test/vertical_overflow-colors.png
+  timedemo/benchmark_baseline.json
   timedemo/WarriorLevel1to2/demo_0.dmo
   timedemo/WarriorLevel1to2/demo_0_reference_spawn_0.sv
   timedemo/WarriorLevel1to2/spawn_0.sv
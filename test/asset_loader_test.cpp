@@ -0,0 +1,116 @@
+#include "engine/asset_loader.hpp"
+
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+
+#ifndef UNPACKED_MPQS
+namespace devilution {
+namespace {
+
+constexpr std::string_view TilesPath = "levels\\towndata\\town.til";
+constexpr std::string_view PalettePath = "levels\\towndata\\town.pal";
+constexpr std::string_view MissingPath = "levels\\towndata\\missing.til";
+
+class AssetLoaderTest : public ::testing::Test {
+public:
+	static void SetUpTestSuite()
+	{
+		LoadCoreArchives();
+		LoadGameArchives();
+
+		// The tests need spawn.mpq or diabdat.mpq
+		// Please provide them so that the tests can run successfully
+		ASSERT_TRUE(HaveSpawn() || HaveDiabdat());
+	}
+
+	void SetUp() override
+	{
+		// Nothing is read ahead in headless mode.
+		HeadlessMode = false;
+	}
+
+	void TearDown() override
+	{
+		StopAssetLoader();
+		HeadlessMode = true;
+	}
+};
+
+std::string ReadDirectly(std::string_view path)
+{
+	tl::expected<AssetData, std::string> asset = LoadAsset(path);
+	if (!asset.has_value()) {
+		ADD_FAILURE() << asset.error();
+		return {};
+	}
+	return std::string(asset->data.get(), asset->size);
+}
+
+std::string ReadAndClose(SDL_RWops *handle)
+{
+	std::string result;
+	char buffer[4096];
+	size_t count;
+	while ((count = SDL_RWread(handle, buffer, 1, sizeof(buffer))) > 0)
+		result.append(buffer, count);
+	SDL_RWclose(handle);
+	return result;
+}
+
+TEST_F(AssetLoaderTest, PrefetchedFileIsHandedOverOnce)
+{
+	const std::string expected = ReadDirectly(TilesPath);
+	ASSERT_FALSE(expected.empty());
+
+	PrefetchAsset(TilesPath, AssetLoadPriority::Urgent);
+	WaitForQueuedAssets();
+	SDL_RWops *prefetched = OpenPrefetchedAsset(TilesPath);
+	ASSERT_NE(prefetched, nullptr);
+	EXPECT_EQ(ReadAndClose(prefetched), expected);
+
+	EXPECT_EQ(OpenPrefetchedAsset(TilesPath), nullptr) << "The data is dropped once it was used";
+	EXPECT_EQ(ReadDirectly(TilesPath), expected);
+}
+
+TEST_F(AssetLoaderTest, FileThatWasNotPrefetchedIsReadDirectly)
+{
+	const std::string expected = ReadDirectly(PalettePath);
+	ASSERT_FALSE(expected.empty());
+
+	PrefetchAsset(TilesPath, AssetLoadPriority::Urgent);
+	WaitForQueuedAssets();
+	EXPECT_EQ(OpenPrefetchedAsset(PalettePath), nullptr);
+	EXPECT_EQ(ReadDirectly(PalettePath), expected);
+}
+
+TEST_F(AssetLoaderTest, FailedPrefetchFallsBackToDirectRead)
+{
+	PrefetchAsset(MissingPath, AssetLoadPriority::Urgent);
+	WaitForQueuedAssets();
+	EXPECT_EQ(OpenPrefetchedAsset(MissingPath), nullptr);
+
+	// Failed reads aren't kept around, so requesting the file again queues it again.
+	PrefetchAsset(MissingPath, AssetLoadPriority::Urgent);
+	WaitForQueuedAssets();
+	EXPECT_EQ(OpenPrefetchedAsset(MissingPath), nullptr);
+	EXPECT_FALSE(FindAsset(MissingPath).ok());
+}
+
+TEST_F(AssetLoaderTest, QueuedFileIsReadDirectly)
+{
+	const std::string expected = ReadDirectly(TilesPath);
+	ASSERT_FALSE(expected.empty());
+
+	// Opened right away, so the file is either still queued, being read, or ready, the contents are the same either way.
+	PrefetchAsset(TilesPath, AssetLoadPriority::Prefetch);
+	EXPECT_EQ(ReadDirectly(TilesPath), expected);
+}
+
+} // namespace
+} // namespace devilution
+#endif
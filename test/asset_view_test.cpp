@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/asset_view.hpp"
+
+using namespace devilution;
+
+namespace {
+
+std::string WriteTestFile(const std::vector<char> &contents)
+{
+	const auto *currentTest = ::testing::UnitTest::GetInstance()->current_test_info();
+	std::string path = "Test_";
+	path.append(currentTest->test_case_name());
+	path += '_';
+	path.append(currentTest->name());
+	path.append(".tmp");
+	FILE *file = std::fopen(path.c_str(), "wb");
+	EXPECT_NE(file, nullptr);
+	std::fwrite(contents.data(), contents.size(), 1, file);
+	std::fclose(file);
+	return path;
+}
+
+std::vector<char> MakeContents(size_t size)
+{
+	std::vector<char> contents(size);
+	for (size_t i = 0; i < size; ++i)
+		contents[i] = static_cast<char>(i * 7);
+	return contents;
+}
+
+TEST(AssetView, MapFileRegionAtUnalignedOffset)
+{
+	const std::vector<char> contents = MakeContents(100000);
+	const std::string path = WriteTestFile(contents);
+	const AssetView view = MapFileRegion(path.c_str(), 12345, 50000);
+	if (view.empty())
+		GTEST_SKIP() << "Memory-mapped files are not supported";
+	EXPECT_TRUE(view.mapped());
+	ASSERT_EQ(view.size(), 50000);
+	EXPECT_EQ(std::memcmp(view.data(), &contents[12345], view.size()), 0);
+}
+
+TEST(AssetView, BufferWritesDoNotChangeTheFile)
+{
+	const std::vector<char> contents = MakeContents(8192);
+	const std::string path = WriteTestFile(contents);
+	AssetBuffer buffer;
+	{
+		const AssetView view = MapFileRegion(path.c_str(), 0, contents.size());
+		if (view.empty())
+			GTEST_SKIP() << "Memory-mapped files are not supported";
+		buffer = ToAssetBuffer(view);
+	}
+	// The buffer keeps the mapping alive after the view is gone.
+	buffer[0] = static_cast<uint8_t>(contents[0] + 1);
+
+	const AssetView other = MapFileRegion(path.c_str(), 0, contents.size());
+	ASSERT_FALSE(other.empty());
+	EXPECT_EQ(static_cast<char>(other.data()[0]), contents[0]);
+}
+
+TEST(AssetView, OwnedArrayConvertsToAssetBuffer)
+{
+	std::unique_ptr<uint8_t[]> data { new uint8_t[4] { 1, 2, 3, 4 } };
+	const AssetBuffer buffer = std::move(data);
+	EXPECT_EQ(buffer[3], 4);
+}
+
+} // namespace
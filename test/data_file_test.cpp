@@ -2,11 +2,16 @@
 
 #include "data/file.hpp"
 #include "data/parser.hpp"
+#include "data/record_cache.hpp"
+#include "data/record_reader.hpp"
 
+#include <cstdio>
 #include <string_view>
 #include <vector>
 
+#include "utils/file_util.h"
 #include "utils/paths.h"
+#include "utils/stdcompat/filesystem.hpp"
 
 namespace devilution {
 auto LoadDataFile(std::string_view file)
@@ -529,4 +534,125 @@ TEST(DataFileTest, SkipRowIterator)
 	EXPECT_EQ(row, expectedFields.size()) << "Parsing returned fewer records than expected";
 }
 
+TEST(DataFileTest, RecordCacheReplaysValues)
+{
+	auto loadDataResult = LoadDataFile("txtdata\\sample.tsv");
+	ASSERT_TRUE(loadDataResult.has_value()) << "Unable to load sample.tsv";
+
+	DataFile &dataFile = loadDataResult.value();
+	ASSERT_TRUE(dataFile.skipHeader().has_value()) << "sample.tsv should have a header and at least one record";
+
+	const std::string cacheDirectory = paths::BasePath() + "record_cache_test";
+	const std::string cacheFile = cacheDirectory + DIRECTORY_SEPARATOR_STR "txtdata_sample.tsv.bin";
+	RemoveFile(cacheFile.c_str());
+	SetRecordCacheDirectory(cacheDirectory);
+
+	std::string parsedString;
+	uint8_t parsedByte = 0;
+	int parsedInt = 0;
+	int parsedFixed = 0;
+	for (const bool replaying : { false, true }) {
+		RecordCache cache { "txtdata\\sample.tsv", dataFile, /*schemaVersion=*/1 };
+		EXPECT_EQ(cache.replaying(), replaying) << "The second load should replay the values recorded by the first";
+		for (DataFileRecord record : dataFile) {
+			RecordReader reader { record, "sample.tsv", cache };
+			std::string stringVal;
+			uint8_t byteVal = 0;
+			int intVal = 0;
+			int fixedVal = 0;
+			reader.readString("String", stringVal);
+			reader.readInt("Byte", byteVal);
+			reader.readInt("Int", intVal);
+			reader.readFixed6("Float", fixedVal);
+			if (!replaying) {
+				parsedString = stringVal;
+				parsedByte = byteVal;
+				parsedInt = intVal;
+				parsedFixed = fixedVal;
+			} else {
+				EXPECT_EQ(stringVal, parsedString);
+				EXPECT_EQ(byteVal, parsedByte);
+				EXPECT_EQ(intVal, parsedInt);
+				EXPECT_EQ(fixedVal, parsedFixed);
+			}
+		}
+		cache.save();
+	}
+	EXPECT_EQ(parsedString, "Sample");
+	EXPECT_EQ(parsedByte, 145);
+	EXPECT_EQ(parsedInt, 70322);
+
+	const RecordCache newerLoader { "txtdata\\sample.tsv", dataFile, /*schemaVersion=*/2 };
+	EXPECT_FALSE(newerLoader.replaying()) << "A loader that reads other values must not replay the old ones";
+
+	SetRecordCacheDirectory({});
+	RemoveFile(cacheFile.c_str());
+#ifdef DVL_HAS_FILESYSTEM
+	std::error_code error;
+	std::filesystem::remove(cacheDirectory, error);
+#endif
+}
+
+TEST(DataFileTest, RecordCacheMismatchIsAMiss)
+{
+	auto loadDataResult = LoadDataFile("txtdata\\sample.tsv");
+	ASSERT_TRUE(loadDataResult.has_value()) << "Unable to load sample.tsv";
+
+	DataFile &dataFile = loadDataResult.value();
+	ASSERT_TRUE(dataFile.skipHeader().has_value()) << "sample.tsv should have a header and at least one record";
+
+	const std::string cacheDirectory = paths::BasePath() + "record_cache_test";
+	const std::string cacheFile = cacheDirectory + DIRECTORY_SEPARATOR_STR "txtdata_sample.tsv.bin";
+	RemoveFile(cacheFile.c_str());
+	SetRecordCacheDirectory(cacheDirectory);
+
+	// Loads the first column, or the first two to simulate a loader that changed without bumping its schema version.
+	const auto load = [&](size_t numValues, bool expectReplaying) {
+		RecordCache cache { "txtdata\\sample.tsv", dataFile, /*schemaVersion=*/1 };
+		EXPECT_EQ(cache.replaying(), expectReplaying);
+		std::string stringVal;
+		uint8_t byteVal = 0;
+		int passes = 0;
+		do {
+			++passes;
+			for (DataFileRecord record : dataFile) {
+				RecordReader reader { record, "sample.tsv", cache };
+				reader.readString("String", stringVal);
+				if (numValues > 1)
+					reader.readInt("Byte", byteVal);
+			}
+		} while (!cache.finishReplay());
+		cache.save();
+		EXPECT_EQ(stringVal, "Sample");
+		if (numValues > 1)
+			EXPECT_EQ(byteVal, 145);
+		return passes;
+	};
+
+	EXPECT_EQ(load(1, /*expectReplaying=*/false), 1);
+	EXPECT_EQ(load(1, /*expectReplaying=*/true), 1);
+	EXPECT_EQ(load(2, /*expectReplaying=*/true), 2) << "Reading past the recorded values should parse the file again";
+	EXPECT_EQ(load(1, /*expectReplaying=*/true), 2) << "Leaving recorded values unread should parse the file again";
+
+	{
+		FILE *file = OpenFile(cacheFile.c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		ASSERT_EQ(std::fseek(file, -1, SEEK_END), 0);
+		const int last = std::fgetc(file);
+		ASSERT_NE(last, EOF);
+		ASSERT_EQ(std::fseek(file, -1, SEEK_END), 0);
+		std::fputc(last ^ 0xFF, file);
+		std::fclose(file);
+	}
+	EXPECT_EQ(load(1, /*expectReplaying=*/false), 1) << "A corrupted payload must not be replayed";
+	EXPECT_EQ(load(1, /*expectReplaying=*/true), 1);
+
+	SetRecordCacheDirectory({});
+	RemoveFile(cacheFile.c_str());
+#ifdef DVL_HAS_FILESYSTEM
+	std::error_code error;
+	std::filesystem::remove(cacheDirectory, error);
+#endif
+}
+
 } // namespace devilution
@@ -1,11 +1,136 @@
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "drlg_test.hpp"
+#include "engine/random.hpp"
+#include "levels/drlg_l1.h"
 
 using namespace devilution;
 
 namespace {
 
+struct CathedralJob {
+	int level;
+	uint32_t seed;
+	lvl_entry entry;
+	CathedralLevelParams params;
+	std::unique_ptr<CathedralLevel> result;
+};
+
+/** @brief The level globals that CreateL5Dungeon() leaves behind for a Cathedral level */
+struct CathedralSnapshot {
+	uint8_t dungeon[DMAXX][DMAXY];
+	uint8_t pdungeon[DMAXX][DMAXY];
+	int8_t dTransVal[MAXDUNX][MAXDUNY];
+	uint16_t dPiece[MAXDUNX][MAXDUNY];
+	Bitset2d<DMAXX, DMAXY> protectedTiles;
+	int8_t transVal;
+	WorldTileRectangle setPiece;
+	Point viewPosition;
+	Point poisonedWaterPosition;
+	std::optional<uint32_t> levelSeed;
+	uint32_t engineState;
+
+	void take(int level)
+	{
+		memcpy(this->dungeon, devilution::dungeon, sizeof(this->dungeon));
+		memcpy(this->pdungeon, devilution::pdungeon, sizeof(this->pdungeon));
+		memcpy(this->dTransVal, devilution::dTransVal, sizeof(this->dTransVal));
+		memcpy(this->dPiece, devilution::dPiece, sizeof(this->dPiece));
+		protectedTiles = Protected;
+		transVal = TransVal;
+		setPiece = SetPiece;
+		viewPosition = ViewPosition;
+		poisonedWaterPosition = Quests[Q_PWATER].position;
+		levelSeed = LevelSeeds[level];
+		engineState = GetLCGEngineState();
+	}
+};
+
+void ExpectSameLevel(const CathedralSnapshot &expected, const CathedralSnapshot &actual, const CathedralJob &job)
+{
+	SCOPED_TRACE(testing::Message() << "level " << job.level << " seed " << job.seed << " entry " << static_cast<int>(job.entry));
+	EXPECT_EQ(memcmp(expected.dungeon, actual.dungeon, sizeof(expected.dungeon)), 0);
+	EXPECT_EQ(memcmp(expected.pdungeon, actual.pdungeon, sizeof(expected.pdungeon)), 0);
+	EXPECT_EQ(memcmp(expected.dTransVal, actual.dTransVal, sizeof(expected.dTransVal)), 0);
+	EXPECT_EQ(memcmp(expected.dPiece, actual.dPiece, sizeof(expected.dPiece)), 0);
+	for (int y = 0; y < DMAXY; y++) {
+		for (int x = 0; x < DMAXX; x++) {
+			ASSERT_EQ(expected.protectedTiles.test(x, y), actual.protectedTiles.test(x, y)) << "Protected doesn't match at " << x << "x" << y;
+		}
+	}
+	EXPECT_EQ(expected.transVal, actual.transVal);
+	EXPECT_EQ(expected.setPiece.position, actual.setPiece.position);
+	EXPECT_EQ(expected.setPiece.size, actual.setPiece.size);
+	EXPECT_EQ(expected.viewPosition, actual.viewPosition);
+	EXPECT_EQ(expected.poisonedWaterPosition, actual.poisonedWaterPosition);
+	EXPECT_EQ(expected.levelSeed, actual.levelSeed);
+	EXPECT_EQ(expected.engineState, actual.engineState);
+}
+
+/**
+ * Generates every job with CreateL5Dungeon() and with GenerateCathedralLevel() on several threads at once, and checks
+ * that loading the latter leaves the same level globals behind.
+ */
+void TestGenerateCathedralLevel(std::vector<CathedralJob> &jobs)
+{
+	for (CathedralJob &job : jobs) {
+		LevelSeeds[job.level] = std::nullopt;
+		job.params = GetCathedralLevelParams(job.level);
+		job.result = std::make_unique<CathedralLevel>();
+	}
+
+	constexpr size_t NumThreads = 4;
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < NumThreads; t++) {
+		workers.emplace_back([&jobs, t]() {
+			for (size_t i = t; i < jobs.size(); i += NumThreads) {
+				const CathedralJob &job = jobs[i];
+				GenerateCathedralLevel(job.params, job.seed, job.entry, *job.result);
+			}
+		});
+	}
+
+	std::vector<CathedralSnapshot> expected(jobs.size());
+	for (size_t i = 0; i < jobs.size(); i++) {
+		const CathedralJob &job = jobs[i];
+		LevelSeeds[job.level] = std::nullopt;
+		currlevel = job.level;
+		leveltype = GetLevelType(job.level);
+		pMegaTiles = std::make_unique<MegaTile[]>(GetTileCount(leveltype));
+		ViewPosition = { 0, 0 };
+		Quests[Q_PWATER].position = { 0, 0 };
+		CreateDungeon(job.seed, job.entry);
+		expected[i].take(job.level);
+	}
+
+	for (std::thread &worker : workers)
+		worker.join();
+
+	for (size_t i = 0; i < jobs.size(); i++) {
+		const CathedralJob &job = jobs[i];
+		LevelSeeds[job.level] = std::nullopt;
+		currlevel = job.level;
+		leveltype = GetLevelType(job.level);
+		memset(dungeon, 0xFF, sizeof(dungeon));
+		memset(dTransVal, 0x7F, sizeof(dTransVal));
+		Protected.reset();
+		SetPiece = { { 1, 1 }, { 1, 1 } };
+		ViewPosition = { 0, 0 };
+		Quests[Q_PWATER].position = { 0, 0 };
+		SetRndSeed(0);
+		LoadCathedralLevel(*job.result);
+
+		CathedralSnapshot actual;
+		actual.take(job.level);
+		ExpectSameLevel(expected[i], actual, job);
+	}
+}
+
 TEST(Drlg_l1, CreateL5Dungeon_diablo_1_2588)
 {
 	LoadExpectedLevelData("diablo/1-2588.dun");
@@ -249,4 +374,30 @@ TEST(Drlg_l1, CreateL5Dungeon_crypt_4_1324803725)
 	EXPECT_EQ(ViewPosition, Point(79, 47));
 }
 
+TEST(Drlg_l1, GenerateCathedralLevel_matches_CreateL5Dungeon)
+{
+	// Set look up path to the location to load set pieces from:
+	paths::SetPrefPath(paths::BasePath() + "test/fixtures/");
+
+	for (bool originalCathedral : { true, false }) {
+		TestInitGame(true, originalCathedral);
+		// Use the other quest of each pool on the second pass
+		if (!originalCathedral) {
+			Quests[Q_PWATER]._qactive = QUEST_INIT;
+			Quests[Q_BUTCHER]._qactive = QUEST_NOTAVAIL;
+			Quests[Q_LTBANNER]._qactive = QUEST_NOTAVAIL;
+		}
+
+		std::vector<CathedralJob> jobs;
+		for (int level = 1; level <= 4; level++) {
+			for (uint32_t seed : { 2588U, 743271966U, 1383137027U, 844660068U, 609325643U, 902156014U, 401921334U, 128964898U }) {
+				for (lvl_entry entry : { ENTRY_MAIN, ENTRY_PREV, ENTRY_RTNLVL }) {
+					jobs.push_back({ level, seed, entry, {}, nullptr });
+				}
+			}
+		}
+		TestGenerateCathedralLevel(jobs);
+	}
+}
+
 } // namespace
@@ -0,0 +1,213 @@
+/**
+ * Generates a dungeon level for a range of seeds and prints a hash of each layout, one line per seed:
+ *
+ *     <seed> <layout hash> <view x> <view y>
+ *
+ * Diffing the output of two builds shows which seeds a change to the level generators affects.
+ * The seeds of interesting layouts can then be added as drlg_l*_test fixtures.
+ *
+ * Usage: drlg_seed_sweep <level> <first seed> <count> [--jobs=N] [--entry=main|prev|rtnlvl|twarpdn] [--multiplayer]
+ *
+ * The level generators work on global state, so --jobs splits the seeds between forked worker processes.
+ */
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define DRLG_SEED_SWEEP_FORK
+#endif
+
+#include "drlg_test.hpp"
+#include "headless_mode.hpp"
+
+namespace {
+
+struct SweepResult {
+	uint32_t seed;
+	uint64_t hash;
+	int viewX;
+	int viewY;
+};
+
+struct SweepOptions {
+	int level;
+	uint32_t firstSeed;
+	uint32_t count;
+	unsigned jobs = 1;
+	lvl_entry entry = ENTRY_MAIN;
+	bool multiplayer = false;
+};
+
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+SweepResult Generate(const SweepOptions &options, uint32_t seed)
+{
+	// Quests are reset for every seed, so that the results don't depend on which seeds a worker generated before.
+	TestInitGame(!options.multiplayer);
+	LevelSeeds[options.level] = std::nullopt;
+	currlevel = options.level;
+	leveltype = GetLevelType(options.level);
+
+	CreateDungeon(seed, options.entry);
+	CreateThemeRooms();
+
+	// The same data that the drlg_l*_test fixtures compare.
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hash = HashBytes(hash, dungeon, sizeof(dungeon));
+	hash = HashBytes(hash, dTransVal, sizeof(dTransVal));
+	return SweepResult { seed, hash, ViewPosition.x, ViewPosition.y };
+}
+
+void GenerateRange(const SweepOptions &options, unsigned worker, std::vector<SweepResult> &out)
+{
+	for (uint32_t i = worker; i < options.count; i += options.jobs)
+		out.push_back(Generate(options, options.firstSeed + i));
+}
+
+#ifdef DRLG_SEED_SWEEP_FORK
+bool GenerateInWorkers(const SweepOptions &options, std::vector<SweepResult> &results)
+{
+	std::vector<pid_t> workers;
+	std::vector<int> pipes;
+	for (unsigned worker = 0; worker < options.jobs; ++worker) {
+		int fds[2];
+		if (pipe(fds) != 0) {
+			std::perror("pipe");
+			return false;
+		}
+		const pid_t pid = fork();
+		if (pid == -1) {
+			std::perror("fork");
+			return false;
+		}
+		if (pid == 0) {
+			close(fds[0]);
+			std::vector<SweepResult> out;
+			GenerateRange(options, worker, out);
+			const auto *data = reinterpret_cast<const char *>(out.data());
+			size_t remaining = out.size() * sizeof(SweepResult);
+			while (remaining > 0) {
+				const ssize_t written = write(fds[1], data, remaining);
+				if (written <= 0)
+					_exit(1);
+				data += written;
+				remaining -= static_cast<size_t>(written);
+			}
+			_exit(0);
+		}
+		close(fds[1]);
+		workers.push_back(pid);
+		pipes.push_back(fds[0]);
+	}
+
+	bool ok = true;
+	for (unsigned worker = 0; worker < options.jobs; ++worker) {
+		SweepResult result;
+		size_t filled = 0;
+		ssize_t numRead;
+		while ((numRead = read(pipes[worker], reinterpret_cast<char *>(&result) + filled, sizeof(result) - filled)) > 0) {
+			filled += static_cast<size_t>(numRead);
+			if (filled == sizeof(result)) {
+				results[result.seed - options.firstSeed] = result;
+				filled = 0;
+			}
+		}
+		close(pipes[worker]);
+		int status;
+		if (waitpid(workers[worker], &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			std::fprintf(stderr, "Worker %u failed\n", worker);
+			ok = false;
+		}
+	}
+	return ok;
+}
+#endif
+
+bool ParseEntry(std::string_view name, lvl_entry &entry)
+{
+	if (name == "main")
+		entry = ENTRY_MAIN;
+	else if (name == "prev")
+		entry = ENTRY_PREV;
+	else if (name == "rtnlvl")
+		entry = ENTRY_RTNLVL;
+	else if (name == "twarpdn")
+		entry = ENTRY_TWARPDN;
+	else
+		return false;
+	return true;
+}
+
+int PrintUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s <level> <first seed> <count> [--jobs=N] [--entry=main|prev|rtnlvl|twarpdn] [--multiplayer]\n", program);
+	return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc < 4)
+		return PrintUsage(argv[0]);
+
+	SweepOptions options;
+	options.level = std::atoi(argv[1]);
+	options.firstSeed = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+	options.count = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+	if (options.level < 1 || options.level >= NUMLEVELS)
+		return PrintUsage(argv[0]);
+	for (int i = 4; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg.substr(0, 7) == "--jobs=") {
+			options.jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[i] + 7)));
+		} else if (arg.substr(0, 8) == "--entry=") {
+			if (!ParseEntry(arg.substr(8), options.entry))
+				return PrintUsage(argv[0]);
+		} else if (arg == "--multiplayer") {
+			options.multiplayer = true;
+		} else {
+			return PrintUsage(argv[0]);
+		}
+	}
+
+	// Disable error dialogs.
+	HeadlessMode = true;
+	// Set pieces are loaded from the test fixtures, like in the drlg_l*_test tests.
+	paths::SetPrefPath(paths::BasePath() + "test/fixtures/");
+	pMegaTiles = std::make_unique<MegaTile[]>(GetTileCount(GetLevelType(options.level)));
+
+	std::vector<SweepResult> results;
+#ifdef DRLG_SEED_SWEEP_FORK
+	if (options.jobs > 1) {
+		results.resize(options.count);
+		if (!GenerateInWorkers(options, results))
+			return 1;
+	} else {
+		GenerateRange(options, 0, results);
+	}
+#else
+	options.jobs = 1;
+	GenerateRange(options, 0, results);
+#endif
+
+	for (const SweepResult &result : results) {
+		std::printf("%" PRIu32 " %016" PRIx64 " %d %d\n", result.seed, result.hash, result.viewX, result.viewY);
+	}
+	return 0;
+}
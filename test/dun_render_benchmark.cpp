@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cstddef>
 #include <span>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <benchmark/benchmark.h>
@@ -9,7 +11,9 @@
 #include "engine/clx_sprite.hpp"
 #include "engine/displacement.hpp"
 #include "engine/load_file.hpp"
+#include "engine/render/blit_simd.hpp"
 #include "engine/render/dun_render.hpp"
+#include "engine/render/light_render.hpp"
 #include "engine/surface.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung.h"
@@ -17,11 +21,14 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/sdl_wrap.h"
+#include "utils/worker_pool.hpp"
 
 namespace devilution {
 namespace {
 
 SDLSurfaceUniquePtr SdlSurface;
+SDLSurfaceUniquePtr ScreenSurface;
+std::vector<uint8_t> ScreenLightmapBuffer;
 ankerl::unordered_dense::map<TileType, std::vector<LevelCelBlock>> Tiles;
 
 void InitOnce()
@@ -46,6 +53,20 @@ void InitOnce()
 			exit(1);
 		}
 
+		ScreenSurface = SDLWrap::CreateRGBSurfaceWithFormat(
+		    /*flags=*/0, /*width=*/2560, /*height=*/1440, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+		if (ScreenSurface == nullptr) {
+			LogError("Failed to create SDL Surface: {}", SDL_GetError());
+			exit(1);
+		}
+		ScreenLightmapBuffer.resize(static_cast<size_t>(ScreenSurface->pitch) * ScreenSurface->h);
+		for (int y = 0; y < ScreenSurface->h; ++y) {
+			for (int x = 0; x < ScreenSurface->pitch; ++x) {
+				// Diagonal bands of light, so that the per-pixel path sees all the light levels.
+				ScreenLightmapBuffer[static_cast<size_t>(y) * ScreenSurface->pitch + x] = static_cast<uint8_t>(((x + y) / 8) % LightsMax);
+			}
+		}
+
 		for (size_t i = 0; i < 700; ++i) {
 			for (size_t j = 0; j < 10; ++j) {
 				if (const LevelCelBlock levelCelBlock = DPieceMicros[i].mt[j]; levelCelBlock.hasValue()) {
@@ -62,10 +83,9 @@ void InitOnce()
 	}();
 }
 
-void RunForTileMaskLight(benchmark::State &state, TileType tileType, MaskType maskType, const uint8_t *lightTable)
+void RunForTileMaskLight(benchmark::State &state, TileType tileType, MaskType maskType, const uint8_t *lightTable, const Lightmap &lightmap)
 {
 	Surface out = Surface(SdlSurface.get());
-	Lightmap lightmap(nullptr, {}, 1, nullptr, 0);
 	size_t numItemsProcessed = 0;
 	const std::span<const LevelCelBlock> tiles = Tiles[tileType];
 	for (auto _ : state) {
@@ -89,7 +109,25 @@ template <TileType TileT, MaskType MaskT, GetLightTableFn GetLightTableFnT>
 void Render(benchmark::State &state)
 {
 	InitOnce();
-	RunForTileMaskLight(state, TileT, MaskT, GetLightTableFnT());
+	GetOptions().Graphics.perPixelLighting.SetValue(false);
+	RunForTileMaskLight(state, TileT, MaskT, GetLightTableFnT(), Lightmap(nullptr, {}, 1, nullptr, 0));
+}
+
+template <TileType TileT, MaskType MaskT, BlitIsa IsaT>
+void RenderPerPixel(benchmark::State &state)
+{
+	InitOnce();
+	if (!IsBlitIsaSupported(IsaT)) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	const BlitIsa isa = GetBlitIsa();
+	SetBlitIsa(IsaT);
+	GetOptions().Graphics.perPixelLighting.SetValue(true);
+	Surface out = Surface(SdlSurface.get());
+	const Lightmap lightmap(out.at(0, 0), out.pitch(), ScreenLightmapBuffer, static_cast<uint16_t>(ScreenSurface->pitch), LightTables[0].data(), LightTables[0].size());
+	RunForTileMaskLight(state, TileT, MaskT, LightTables[0].data(), lightmap);
+	SetBlitIsa(isa);
 }
 
 // Define aliases in order to have shorter benchmark names.
@@ -101,11 +139,15 @@ constexpr auto LeftTrapezoid = TileType::LeftTrapezoid;
 constexpr auto RightTrapezoid = TileType::RightTrapezoid;
 constexpr auto Transparent = MaskType::Transparent;
 constexpr auto Solid = MaskType::Solid;
+constexpr auto Scalar = BlitIsa::Scalar;
+constexpr auto Avx2 = BlitIsa::Avx2;
 
-#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)      \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);  \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark); \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit);
+#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)           \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);       \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark);      \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit);   \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE, Scalar); \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE, Avx2);
 
 #define DEFINE_FOR_TILE_TYPE(TILE_TYPE)             \
 	DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, Solid) \
@@ -133,5 +175,54 @@ void BM_RenderBlackTile(benchmark::State &state)
 }
 BENCHMARK(BM_RenderBlackTile);
 
+/**
+ * @brief Covers a 1440p screen with square tiles using per-pixel lighting.
+ *
+ * The screen is split into `state.range(0)` horizontal bands that are rendered concurrently,
+ * the same way the game renders the view when multithreaded rendering is enabled.
+ */
+void BM_RenderScreenInBands(benchmark::State &state)
+{
+	InitOnce();
+	const bool perPixelLighting = *GetOptions().Graphics.perPixelLighting;
+	GetOptions().Graphics.perPixelLighting.SetValue(true);
+
+	const int bandCount = static_cast<int>(state.range(0));
+	WorkerPool workers(static_cast<unsigned>(bandCount - 1));
+	Surface out = Surface(ScreenSurface.get());
+	const Lightmap lightmap(out.at(0, 0), ScreenLightmapBuffer, out.pitch(), LightTables[0].data(), LightTables[0].size());
+	const std::span<const LevelCelBlock> tiles = Tiles[TileType::Square];
+	const int bandHeight = (out.h() + bandCount - 1) / bandCount;
+	const int columns = out.w() / DunFrameWidth;
+	const int rows = out.h() / DunFrameHeight;
+
+	size_t numItemsProcessed = 0;
+	for (auto _ : state) {
+		workers.parallelFor(static_cast<unsigned>(bandCount), [&](unsigned band) {
+			const int top = static_cast<int>(band) * bandHeight;
+			if (top >= out.h())
+				return;
+			const Surface bandOut = out.subregionY(top, std::min(bandHeight, out.h() - top));
+			const Lightmap bandLightmap = lightmap.subregionY(top);
+			for (int row = 0; row < rows; ++row) {
+				const int y = (row + 1) * DunFrameHeight - 1 - top;
+				if (y < 0 || y - DunFrameHeight >= bandOut.h())
+					continue;
+				for (int column = 0; column < columns; ++column) {
+					const LevelCelBlock levelCelBlock = tiles[(row * columns + column) % tiles.size()];
+					RenderTile(bandOut, bandLightmap, Point { static_cast<int>(column * DunFrameWidth), y }, levelCelBlock, MaskType::Solid, LightTables[5].data());
+				}
+			}
+		});
+		uint8_t color = out[Point { 1280, 720 }];
+		benchmark::DoNotOptimize(color);
+		numItemsProcessed += static_cast<size_t>(rows) * columns;
+	}
+	state.SetItemsProcessed(numItemsProcessed);
+
+	GetOptions().Graphics.perPixelLighting.SetValue(perPixelLighting);
+}
+BENCHMARK(BM_RenderScreenInBands)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
 } // namespace
 } // namespace devilution
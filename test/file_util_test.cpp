@@ -61,6 +61,27 @@ TEST(FileUtil, ResizeFile)
 	EXPECT_EQ(size, 30);
 }
 
+TEST(FileUtil, SyncAndReplaceFile)
+{
+	const std::string from = GetTmpPathName(".new");
+	const std::string to = GetTmpPathName();
+	WriteDummyFile(to.c_str(), 42);
+	WriteDummyFile(from.c_str(), 30);
+	ASSERT_TRUE(SyncAndReplaceFile(from.c_str(), to.c_str()));
+	EXPECT_FALSE(FileExists(from.c_str()));
+	std::uintmax_t size;
+	ASSERT_TRUE(GetFileSize(to.c_str(), &size));
+	EXPECT_EQ(size, 30);
+
+	// Also works when there is nothing to replace yet
+	RemoveFile(to.c_str());
+	WriteDummyFile(from.c_str(), 20);
+	ASSERT_TRUE(SyncAndReplaceFile(from.c_str(), to.c_str()));
+	EXPECT_FALSE(FileExists(from.c_str()));
+	ASSERT_TRUE(GetFileSize(to.c_str(), &size));
+	EXPECT_EQ(size, 20);
+}
+
 TEST(FileUtil, Dirname)
 {
 	EXPECT_EQ(Dirname(""), ".");
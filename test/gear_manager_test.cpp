@@ -0,0 +1,86 @@
+#include "gear/gear_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "gear/composite_score.h"
+#include "items.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+class GearManagerTest : public ::testing::Test {
+public:
+	void SetUp() override
+	{
+		Players.resize(1);
+		MyPlayer = &Players[0];
+		for (Item &item : MyPlayer->InvBody)
+			item.clear();
+		GearLevelManager::GetInstance().InvalidateCache(*MyPlayer);
+	}
+};
+
+Item MakeArmor(uint32_t seed, int16_t armorClass)
+{
+	Item item {};
+	item._itype = ItemType::HeavyArmor;
+	item._iMagical = ITEM_QUALITY_MAGIC;
+	item._iSeed = seed;
+	item._iCreateInfo = 20;
+	item._iAC = armorClass;
+	item._iDurability = 60;
+	item._iMaxDur = 60;
+	return item;
+}
+
+TEST_F(GearManagerTest, MatchesFreshCalculation)
+{
+	MyPlayer->InvBody[INVLOC_CHEST] = MakeArmor(1, 30);
+	GearLevelManager::GetInstance().OnItemEquipped(*MyPlayer, MyPlayer->InvBody[INVLOC_CHEST], INVLOC_CHEST);
+	EXPECT_FLOAT_EQ(GearLevelManager::GetInstance().GetCurrentGearLevel(*MyPlayer), GearScorer::CalculateGearLevel(*MyPlayer));
+}
+
+TEST_F(GearManagerTest, ChangedItemIsScoredAgain)
+{
+	GearLevelManager &manager = GearLevelManager::GetInstance();
+	MyPlayer->InvBody[INVLOC_CHEST] = MakeArmor(1, 30);
+	manager.OnItemEquipped(*MyPlayer, MyPlayer->InvBody[INVLOC_CHEST], INVLOC_CHEST);
+	const float before = manager.GetCurrentGearLevel(*MyPlayer);
+
+	// Level ups keep the slot scores, the worn armor getting worse still has to show once the gear level is recalculated.
+	Item &armor = MyPlayer->InvBody[INVLOC_CHEST];
+	armor._iAC = 5;
+	armor._iDurability = 1;
+	manager.OnPlayerLevelUp(*MyPlayer);
+	const float after = manager.GetCurrentGearLevel(*MyPlayer);
+	EXPECT_LT(after, before);
+	EXPECT_FLOAT_EQ(after, GearScorer::CalculateGearLevel(*MyPlayer));
+
+	// Same for the other slots when trying out an item.
+	const Item helm = MakeArmor(2, 10);
+	armor._iAC = 30;
+	armor._iDurability = 60;
+	const float potential = manager.GetPotentialGearLevel(*MyPlayer, helm, INVLOC_HEAD);
+	MyPlayer->InvBody[INVLOC_HEAD] = helm;
+	EXPECT_FLOAT_EQ(potential, GearScorer::CalculateGearLevel(*MyPlayer));
+}
+
+TEST_F(GearManagerTest, ChangedCandidateIsScoredAgain)
+{
+	GearLevelManager &manager = GearLevelManager::GetInstance();
+	Item candidate = MakeArmor(3, 40);
+	const float good = manager.GetPotentialGearLevel(*MyPlayer, candidate, INVLOC_CHEST);
+
+	// Same item, but it got damaged since it was last hovered
+	candidate._iAC = 2;
+	candidate._iDurability = 1;
+	const float damaged = manager.GetPotentialGearLevel(*MyPlayer, candidate, INVLOC_CHEST);
+	EXPECT_LT(damaged, good);
+
+	MyPlayer->InvBody[INVLOC_CHEST] = candidate;
+	EXPECT_FLOAT_EQ(damaged, GearScorer::CalculateGearLevel(*MyPlayer));
+}
+
+} // namespace
+} // namespace devilution
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <climits>
 #include <random>
 
@@ -119,5 +120,44 @@ TEST_F(ItemsTest, AllHellfireUniquesCanDrop)
 	GenerateAllUniques(true, 99);
 }
 
+TEST(WeightedItemTableTest, PicksSameItemAsSearch)
+{
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> itemCount(1, 300);
+	// Lots of zero weights, like items whose drop rate was turned off, and a few huge ones
+	std::uniform_int_distribution<unsigned> weight(0, 12);
+	std::uniform_int_distribution<unsigned> hugeWeight(0, 1000000);
+
+	for (int tableIndex = 0; tableIndex < 2000; tableIndex++) {
+		WeightedItemTable table;
+		const int count = itemCount(rng);
+		unsigned cumulativeWeight = 0;
+		for (int i = 0; i < count; i++) {
+			cumulativeWeight += tableIndex % 10 == 0 ? hugeWeight(rng) : weight(rng) * weight(rng);
+			table.items.push_back({ static_cast<_item_indexes>(i), cumulativeWeight });
+		}
+		if (table.totalWeight() == 0)
+			continue;
+		table.buildGuide();
+
+		const auto search = [&table](unsigned targetWeight) {
+			return std::upper_bound(table.items.begin(), table.items.end(), targetWeight, [](unsigned target, const WeightedItemIndex &value) { return target < value.cumulativeWeight; })->index;
+		};
+		std::uniform_int_distribution<unsigned> target(0, table.totalWeight() - 1);
+		for (int i = 0; i < 200; i++) {
+			const unsigned targetWeight = target(rng);
+			ASSERT_EQ(table.pick(targetWeight), search(targetWeight)) << "table " << tableIndex << ", target " << targetWeight;
+		}
+		// Right at the edges between items
+		for (const WeightedItemIndex &item : table.items) {
+			for (const unsigned targetWeight : { item.cumulativeWeight - 1, item.cumulativeWeight }) {
+				if (item.cumulativeWeight == 0 || targetWeight >= table.totalWeight())
+					continue;
+				ASSERT_EQ(table.pick(targetWeight), search(targetWeight)) << "table " << tableIndex << ", target " << targetWeight;
+			}
+		}
+	}
+}
+
 } // namespace
 } // namespace devilution
@@ -0,0 +1,122 @@
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/direction.hpp"
+#include "engine/displacement.hpp"
+#include "engine/point.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+
+namespace devilution {
+namespace {
+
+// More than MAXLIGHTS, to see how the light map update scales with busy levels.
+constexpr size_t NumLights = 128;
+constexpr int MinLightCoord = 16;
+constexpr int MaxLightCoord = MAXDUNX - 16;
+
+struct MovingLight {
+	Light light;
+	Direction direction;
+};
+
+std::array<MovingLight, NumLights> MovingLights;
+std::array<Light *, NumLights> LightPointers;
+
+void InitLights()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		leveltype = DTYPE_CATHEDRAL;
+		MakeLightTable();
+		return true;
+	}();
+
+	std::memset(dPreLight, LightsMax, sizeof(dPreLight));
+	RestorePreLighting();
+
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> coord(MinLightCoord, MaxLightCoord);
+	std::uniform_int_distribution<int> radius(1, 10);
+	std::uniform_int_distribution<int> direction(0, 7);
+	for (size_t i = 0; i < NumLights; i++) {
+		MovingLight &moving = MovingLights[i];
+		const Point position { coord(rng), coord(rng) };
+		moving.light = {};
+		moving.light.position.tile = position;
+		moving.light.position.old = position;
+		moving.light.radius = static_cast<uint8_t>(radius(rng));
+		moving.light.oldRadius = moving.light.radius;
+		moving.light.hasChanged = true;
+		moving.direction = static_cast<Direction>(direction(rng));
+		LightPointers[i] = &moving.light;
+	}
+	UpdateLightMap(LightPointers);
+}
+
+/** @brief Moves a light one tile, the same way ChangeLightXY does, turning around at the edges of the area. */
+void MoveLight(MovingLight &moving)
+{
+	Light &light = moving.light;
+	Point next = light.position.tile + moving.direction;
+	if (next.x < MinLightCoord || next.x > MaxLightCoord || next.y < MinLightCoord || next.y > MaxLightCoord) {
+		moving.direction = Opposite(moving.direction);
+		next = light.position.tile + moving.direction;
+	}
+	light.position.old = light.position.tile;
+	light.oldRadius = light.radius;
+	light.position.tile = next;
+	light.hasChanged = true;
+}
+
+void RunMovingLights(benchmark::State &state, size_t numMoving)
+{
+	InitLights();
+	for (auto _ : state) {
+		for (size_t i = 0; i < numMoving; i++)
+			MoveLight(MovingLights[i]);
+		UpdateLightMap(LightPointers);
+		benchmark::DoNotOptimize(dLight);
+	}
+	state.SetItemsProcessed(state.iterations() * NumLights);
+}
+
+void BM_AllLightsMoving(benchmark::State &state)
+{
+	RunMovingLights(state, NumLights);
+}
+
+void BM_FewLightsMoving(benchmark::State &state)
+{
+	RunMovingLights(state, 8);
+}
+
+void BM_NoLightsMoving(benchmark::State &state)
+{
+	RunMovingLights(state, 0);
+}
+
+/** @brief Re-lights the whole level every tick, which is what happens after loading a level. */
+void BM_RelightWholeLevel(benchmark::State &state)
+{
+	InitLights();
+	for (auto _ : state) {
+		for (MovingLight &moving : MovingLights)
+			MoveLight(moving);
+		RestorePreLighting();
+		UpdateLightMap(LightPointers);
+		benchmark::DoNotOptimize(dLight);
+	}
+	state.SetItemsProcessed(state.iterations() * NumLights);
+}
+
+BENCHMARK(BM_AllLightsMoving);
+BENCHMARK(BM_FewLightsMoving);
+BENCHMARK(BM_NoLightsMoving);
+BENCHMARK(BM_RelightWholeLevel);
+
+} // namespace
+} // namespace devilution
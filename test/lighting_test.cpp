@@ -0,0 +1,277 @@
+#include "lighting.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "engine/point.hpp"
+#include "engine/points_in_rectangle_range.hpp"
+#include "levels/gendung.h"
+#include "levels/tile_properties.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr uint16_t OpenPiece = 0;
+constexpr uint16_t WallPiece = 1;
+
+void InitLevel()
+{
+	leveltype = DTYPE_CATHEDRAL;
+	MakeLightTable();
+	SOLData[OpenPiece] = TileProperties::None;
+	SOLData[WallPiece] = TileProperties::Solid;
+	std::memset(dPiece, 0, sizeof(dPiece));
+	std::memset(dPreLight, LightsMax, sizeof(dPreLight));
+	RestorePreLighting();
+}
+
+/** @brief The light map as the lights were applied before they were cached in masks and only re-lit where they changed. */
+uint8_t BaselineLight[MAXDUNX][MAXDUNY];
+
+void BaselineRotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist, DisplacementOf<int8_t> &light, DisplacementOf<int8_t> &block)
+{
+	dist = { static_cast<int8_t>(7 - dist.deltaY), dist.deltaX };
+	light = { static_cast<int8_t>(7 - light.deltaY), light.deltaX };
+	offset = { static_cast<int8_t>(dist.deltaX - light.deltaX), static_cast<int8_t>(dist.deltaY - light.deltaY) };
+
+	block.deltaX = 0;
+	if (offset.deltaX < 0) {
+		offset.deltaX += 8;
+		block.deltaX = 1;
+	}
+	block.deltaY = 0;
+	if (offset.deltaY < 0) {
+		offset.deltaY += 8;
+		block.deltaY = 1;
+	}
+}
+
+void BaselineDoUnLight(Point position, uint8_t radius)
+{
+	for (const Point targetPosition : PointsInRectangle(Rectangle { position, radius + 2 })) {
+		if (InDungeonBounds(targetPosition))
+			BaselineLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
+	}
+}
+
+void BaselineDoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
+{
+	DisplacementOf<int8_t> light = {};
+	DisplacementOf<int8_t> block = {};
+
+	if (offset.deltaX < 0) {
+		offset.deltaX += 8;
+		position -= { 1, 0 };
+	}
+	if (offset.deltaY < 0) {
+		offset.deltaY += 8;
+		position -= { 0, 1 };
+	}
+
+	DisplacementOf<int8_t> dist = offset;
+
+	int minX = 15;
+	if (position.x - 15 < 0) {
+		minX = position.x + 1;
+	}
+	int maxX = 15;
+	if (position.x + 15 > MAXDUNX) {
+		maxX = MAXDUNX - position.x;
+	}
+	int minY = 15;
+	if (position.y - 15 < 0) {
+		minY = position.y + 1;
+	}
+	int maxY = 15;
+	if (position.y + 15 > MAXDUNY) {
+		maxY = MAXDUNY - position.y;
+	}
+
+	BaselineLight[position.x][position.y] = 0;
+
+	for (int i = 0; i < 4; i++) {
+		int yBound = i > 0 && i < 3 ? maxY : minY;
+		int xBound = i < 2 ? maxX : minX;
+		for (int y = 0; y < yBound; y++) {
+			for (int x = 1; x < xBound; x++) {
+				int linearDistance = LightConeInterpolations[offset.deltaX][offset.deltaY][x + block.deltaX][y + block.deltaY];
+				if (linearDistance >= 128)
+					continue;
+				Point temp = position + (Displacement { x, y }).Rotate(-i);
+				uint8_t v = LightFalloffs[radius][linearDistance];
+				if (!InDungeonBounds(temp))
+					continue;
+				if (v < BaselineLight[temp.x][temp.y])
+					BaselineLight[temp.x][temp.y] = v;
+			}
+		}
+		BaselineRotateRadius(offset, dist, light, block);
+	}
+}
+
+/** @brief Applies the lights to BaselineLight the way ProcessLightList used to, call before UpdateLightMap clears the changes. */
+void BaselineProcessLights(std::span<Light *const> lights)
+{
+	for (const Light *light : lights) {
+		if (light->isInvalid)
+			BaselineDoUnLight(light->position.tile, light->radius);
+		if (light->hasChanged)
+			BaselineDoUnLight(light->position.old, light->oldRadius);
+	}
+	for (const Light *light : lights) {
+		if (light->isInvalid)
+			continue;
+		if (TileHasAny(light->position.tile, TileProperties::Solid))
+			continue;
+		BaselineDoLighting(light->position.tile, light->radius, light->position.offset);
+	}
+}
+
+void ExpectSameAsBaseline(const std::string &when)
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			ASSERT_EQ(dLight[x][y], BaselineLight[x][y]) << "Tile " << x << ", " << y << " differs " << when;
+		}
+	}
+}
+
+TEST(LightingTest, DoLightingMatchesBaseline)
+{
+	InitLevel();
+
+	// Every quadrant of a light cone gets clipped differently near the edges, so those get checked tile by tile.
+	const int coords[] = { 0, 1, 2, 5, 8, 13, 14, 15, 16, 30, 56, 95, 96, 97, 98, 99, 104, 109, 110, 111 };
+	const DisplacementOf<int8_t> offsets[] = { { 0, 0 }, { 3, 5 }, { 7, 1 }, { -3, 2 }, { 4, -6 }, { -7, -7 } };
+	for (const int x : coords) {
+		for (const int y : coords) {
+			for (uint8_t radius = 0; radius < NumLightRadiuses; radius += 3) {
+				for (const DisplacementOf<int8_t> offset : offsets) {
+					// Negative offsets move the light to the previous tile, which must still be on the map.
+					if ((x == 0 && offset.deltaX < 0) || (y == 0 && offset.deltaY < 0))
+						continue;
+					std::memset(dLight, LightsMax, sizeof(dLight));
+					std::memset(BaselineLight, LightsMax, sizeof(BaselineLight));
+					DoLighting({ x, y }, radius, offset);
+					BaselineDoLighting({ x, y }, radius, offset);
+					ExpectSameAsBaseline("for a light at " + std::to_string(x) + ", " + std::to_string(y) + " with radius " + std::to_string(radius) + " and offset " + std::to_string(offset.deltaX) + ", " + std::to_string(offset.deltaY));
+					if (HasFatalFailure())
+						return;
+				}
+			}
+		}
+	}
+}
+
+TEST(LightingTest, IncrementalUpdateMatchesBaseline)
+{
+	InitLevel();
+	std::memcpy(BaselineLight, dPreLight, sizeof(BaselineLight));
+
+	constexpr size_t NumLights = 24;
+	std::array<Light, NumLights> lights {};
+	std::array<Light *, NumLights> lightPointers;
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> coord(1, MAXDUNX - 2);
+	std::uniform_int_distribution<int> radius(0, 10);
+	std::uniform_int_distribution<int> step(-1, 1);
+	std::uniform_int_distribution<int> offset(-7, 7);
+	// Most lights stay put, so that only parts of the level are re-lit.
+	std::uniform_int_distribution<int> action(0, 19);
+
+	for (size_t i = 0; i < NumLights; i++) {
+		Light &light = lights[i];
+		light.position.tile = { coord(rng), coord(rng) };
+		light.position.old = light.position.tile;
+		light.radius = static_cast<uint8_t>(radius(rng));
+		light.oldRadius = light.radius;
+		light.hasChanged = true;
+		lightPointers[i] = &light;
+	}
+	BaselineProcessLights(lightPointers);
+	UpdateLightMap(lightPointers);
+
+	for (int tick = 0; tick < 200; tick++) {
+		for (Light &light : lights) {
+			switch (action(rng)) {
+			case 0:
+				light.isInvalid = !light.isInvalid;
+				light.hasChanged = true;
+				light.position.old = light.position.tile;
+				light.oldRadius = light.radius;
+				break;
+			case 1:
+				light.hasChanged = true;
+				light.position.old = light.position.tile;
+				light.oldRadius = light.radius;
+				light.radius = static_cast<uint8_t>(radius(rng));
+				break;
+			case 2:
+				light.hasChanged = true;
+				light.position.old = light.position.tile;
+				light.oldRadius = light.radius;
+				light.position.offset = { static_cast<int8_t>(offset(rng)), static_cast<int8_t>(offset(rng)) };
+				break;
+			case 3: {
+				// Walls appear and disappear under the light without the light changing
+				uint16_t &piece = dPiece[light.position.tile.x][light.position.tile.y];
+				piece = piece == WallPiece ? OpenPiece : WallPiece;
+				break;
+			}
+			case 4:
+			case 5: {
+				const Point next = light.position.tile + Displacement { step(rng), step(rng) };
+				if (next.x < 1 || next.y < 1 || next.x > MAXDUNX - 2 || next.y > MAXDUNY - 2)
+					break;
+				light.hasChanged = true;
+				light.position.old = light.position.tile;
+				light.oldRadius = light.radius;
+				light.position.tile = next;
+				break;
+			}
+			default:
+				// Stays where it is
+				break;
+			}
+		}
+		BaselineProcessLights(lightPointers);
+		UpdateLightMap(lightPointers);
+		ExpectSameAsBaseline("after tick " + std::to_string(tick));
+		if (HasFatalFailure())
+			return;
+	}
+}
+
+TEST(LightingTest, LightComesOutWhenWallIsRemoved)
+{
+	InitLevel();
+
+	constexpr Point Position { 40, 40 };
+	dPiece[Position.x][Position.y] = WallPiece;
+	Light light {};
+	light.position.tile = Position;
+	light.position.old = Position;
+	light.radius = 5;
+	light.oldRadius = 5;
+	light.hasChanged = true;
+	Light *const lights[] = { &light };
+	UpdateLightMap(lights);
+	EXPECT_EQ(dLight[Position.x][Position.y], LightsMax) << "Lights inside walls are hidden";
+
+	dPiece[Position.x][Position.y] = OpenPiece;
+	UpdateLightMap(lights);
+	EXPECT_EQ(dLight[Position.x][Position.y], 0) << "The light shows once the wall is gone";
+
+	dPiece[Position.x][Position.y] = WallPiece;
+	UpdateLightMap(lights);
+	EXPECT_EQ(dLight[Position.x][Position.y], 0) << "A wall coming back leaves the light in place until it changes";
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "mpq/mpq_block_cache.hpp"
+
+using namespace devilution;
+
+namespace {
+
+class MpqBlockCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		SetMpqBlockCacheBudget(3 * BlockSize);
+		ClearMpqBlockCache();
+	}
+
+	void TearDown() override
+	{
+		ClearMpqBlockCache();
+		SetMpqBlockCacheBudget(4 * 1024 * 1024);
+	}
+
+	static constexpr size_t BlockSize = 16;
+
+	static std::array<uint8_t, BlockSize> MakeBlock(uint8_t value)
+	{
+		std::array<uint8_t, BlockSize> block;
+		block.fill(value);
+		return block;
+	}
+};
+
+TEST_F(MpqBlockCacheTest, ReturnsCachedBlocks)
+{
+	const auto block = MakeBlock(7);
+	std::array<uint8_t, BlockSize> out {};
+	EXPECT_FALSE(ReadCachedMpqBlock(1, 2, 3, out.data(), out.size()));
+	CacheMpqBlock(1, 2, 3, block.data(), block.size());
+	ASSERT_TRUE(ReadCachedMpqBlock(1, 2, 3, out.data(), out.size()));
+	EXPECT_EQ(out, block);
+
+	// Other archives, files and blocks have separate entries.
+	EXPECT_FALSE(ReadCachedMpqBlock(2, 2, 3, out.data(), out.size()));
+	EXPECT_FALSE(ReadCachedMpqBlock(1, 3, 3, out.data(), out.size()));
+	EXPECT_FALSE(ReadCachedMpqBlock(1, 2, 4, out.data(), out.size()));
+
+	const MpqBlockCacheStats stats = GetMpqBlockCacheStats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 4);
+	EXPECT_EQ(stats.numBlocks, 1);
+	EXPECT_EQ(stats.usedBytes, BlockSize);
+}
+
+TEST_F(MpqBlockCacheTest, EvictsLeastRecentlyUsedBlocks)
+{
+	std::array<uint8_t, BlockSize> out {};
+	for (uint32_t i = 0; i < 3; ++i) {
+		const auto block = MakeBlock(static_cast<uint8_t>(i));
+		CacheMpqBlock(0, 0, i, block.data(), block.size());
+	}
+	// Block 0 becomes the most recently used, so adding block 3 evicts block 1.
+	ASSERT_TRUE(ReadCachedMpqBlock(0, 0, 0, out.data(), out.size()));
+	const auto block = MakeBlock(3);
+	CacheMpqBlock(0, 0, 3, block.data(), block.size());
+
+	EXPECT_TRUE(ReadCachedMpqBlock(0, 0, 0, out.data(), out.size()));
+	EXPECT_FALSE(ReadCachedMpqBlock(0, 0, 1, out.data(), out.size()));
+	EXPECT_TRUE(ReadCachedMpqBlock(0, 0, 2, out.data(), out.size()));
+	EXPECT_TRUE(ReadCachedMpqBlock(0, 0, 3, out.data(), out.size()));
+
+	const MpqBlockCacheStats stats = GetMpqBlockCacheStats();
+	EXPECT_EQ(stats.evictions, 1);
+	EXPECT_EQ(stats.usedBytes, 3 * BlockSize);
+}
+
+TEST_F(MpqBlockCacheTest, ZeroBudgetDisablesCaching)
+{
+	SetMpqBlockCacheBudget(0);
+	const auto block = MakeBlock(1);
+	std::array<uint8_t, BlockSize> out {};
+	CacheMpqBlock(0, 0, 0, block.data(), block.size());
+	EXPECT_FALSE(ReadCachedMpqBlock(0, 0, 0, out.data(), out.size()));
+	EXPECT_EQ(GetMpqBlockCacheStats().numBlocks, 0);
+}
+
+} // namespace
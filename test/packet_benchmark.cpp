@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "dvlnet/frame_queue.h"
+#include "dvlnet/packet.h"
+
+namespace devilution::net {
+namespace {
+
+/** @brief Without PACKET_ENCRYPTION, the password factory doesn't encrypt either. */
+std::unique_ptr<packet_factory> MakeFactory(bool withPassword)
+{
+	if (withPassword)
+		return std::make_unique<packet_factory>("benchmark");
+	return std::make_unique<packet_factory>();
+}
+
+buffer_t MakeMessage(size_t size)
+{
+	buffer_t message(size);
+	for (size_t i = 0; i < size; ++i)
+		message[i] = static_cast<unsigned char>(i);
+	return message;
+}
+
+void BM_EncodeMessage(benchmark::State &state, bool withPassword)
+{
+	std::unique_ptr<packet_factory> factory = MakeFactory(withPassword);
+	const buffer_t message = MakeMessage(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		tl::expected<std::unique_ptr<packet>, PacketError> pkt = factory->make_packet<PT_MESSAGE>(plr_t { 0 }, PLR_BROADCAST, message);
+		if (!pkt.has_value()) {
+			state.SkipWithError(std::string(pkt.error().what()).c_str());
+			break;
+		}
+		tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame((*pkt)->Data());
+		benchmark::DoNotOptimize(frame);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_DecodeMessage(benchmark::State &state, bool withPassword)
+{
+	std::unique_ptr<packet_factory> factory = MakeFactory(withPassword);
+	tl::expected<std::unique_ptr<packet>, PacketError> outPkt = factory->make_packet<PT_MESSAGE>(
+	    plr_t { 0 }, PLR_BROADCAST, MakeMessage(static_cast<size_t>(state.range(0))));
+	if (!outPkt.has_value()) {
+		state.SkipWithError(std::string(outPkt.error().what()).c_str());
+		return;
+	}
+	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame((*outPkt)->Data());
+	if (!frame.has_value()) {
+		state.SkipWithError(std::string(frame.error().what()).c_str());
+		return;
+	}
+
+	frame_queue queue;
+	for (auto _ : state) {
+		buffer_t chunk = queue.AcquireBuffer();
+		chunk.assign(frame->begin(), frame->end());
+		queue.Write(std::move(chunk));
+		tl::expected<std::unique_ptr<packet>, PacketError> inPkt
+		    = queue.PacketReady()
+		          .and_then([&](bool) { return queue.ReadPacket(); })
+		          .and_then([&](buffer_t &&pktData) { return factory->make_packet(std::move(pktData)); });
+		if (!inPkt.has_value()) {
+			state.SkipWithError(std::string(inPkt.error().what()).c_str());
+			break;
+		}
+		benchmark::DoNotOptimize((*inPkt)->Message());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_EncodeMessage, plain, false)->Arg(16)->Arg(512)->Arg(8192);
+BENCHMARK_CAPTURE(BM_EncodeMessage, password, true)->Arg(16)->Arg(512)->Arg(8192);
+BENCHMARK_CAPTURE(BM_DecodeMessage, plain, false)->Arg(16)->Arg(512)->Arg(8192);
+BENCHMARK_CAPTURE(BM_DecodeMessage, password, true)->Arg(16)->Arg(512)->Arg(8192);
+
+} // namespace
+} // namespace devilution::net
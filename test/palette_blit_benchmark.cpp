@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <random>
+
+#include <SDL.h>
+#include <benchmark/benchmark.h>
+
+#include "engine/render/blit_simd.hpp"
+#include "engine/render/palette_blit.hpp"
+#include "utils/sdl_wrap.h"
+
+namespace devilution {
+namespace {
+
+struct Surfaces {
+	SDLSurfaceUniquePtr src;
+	SDLSurfaceUniquePtr dst;
+	SDLPaletteUniquePtr palette;
+};
+
+/** @brief An 8-bit back buffer with random contents and the 32-bit output surface it is presented through. */
+Surfaces CreateSurfaces(int width, int height)
+{
+	Surfaces result;
+	result.src = SDLWrap::CreateRGBSurfaceWithFormat(0, width, height, 8, SDL_PIXELFORMAT_INDEX8);
+	result.dst = SDLWrap::CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+	result.palette = SDLWrap::AllocPalette();
+
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> dist(0, 255);
+	SDL_Color colors[256];
+	for (SDL_Color &color : colors)
+		color = { static_cast<Uint8>(dist(rng)), static_cast<Uint8>(dist(rng)), static_cast<Uint8>(dist(rng)), SDL_ALPHA_OPAQUE };
+	SDL_SetPaletteColors(result.palette.get(), colors, 0, 256);
+	SDL_SetSurfacePalette(result.src.get(), result.palette.get());
+
+	for (int y = 0; y < height; y++) {
+		auto *row = static_cast<uint8_t *>(result.src->pixels) + static_cast<ptrdiff_t>(y) * result.src->pitch;
+		for (int x = 0; x < width; x++)
+			row[x] = static_cast<uint8_t>(dist(rng));
+	}
+	return result;
+}
+
+void BM_SdlBlitSurface(benchmark::State &state)
+{
+	const Surfaces surfaces = CreateSurfaces(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+	for (auto _ : state) {
+		SDL_BlitSurface(surfaces.src.get(), nullptr, surfaces.dst.get(), nullptr);
+		benchmark::DoNotOptimize(surfaces.dst->pixels);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+template <BlitIsa IsaT>
+void BM_BlitPalettedSurface(benchmark::State &state)
+{
+	if (!IsBlitIsaSupported(IsaT)) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	const BlitIsa isa = GetBlitIsa();
+	SetBlitIsa(IsaT);
+	const Surfaces surfaces = CreateSurfaces(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+	for (auto _ : state) {
+		BlitPalettedSurface(surfaces.src.get(), nullptr, surfaces.dst.get(), nullptr);
+		benchmark::DoNotOptimize(surfaces.dst->pixels);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+	SetBlitIsa(isa);
+}
+
+// Define aliases in order to have shorter benchmark names.
+constexpr auto Scalar = BlitIsa::Scalar;
+constexpr auto Avx2 = BlitIsa::Avx2;
+
+void ScreenSizes(benchmark::internal::Benchmark *benchmark)
+{
+	benchmark->Args({ 640, 480 })->Args({ 1920, 1080 })->Args({ 2560, 1440 });
+}
+
+BENCHMARK(BM_SdlBlitSurface)->Apply(ScreenSizes);
+BENCHMARK_TEMPLATE(BM_BlitPalettedSurface, Scalar)->Apply(ScreenSizes);
+BENCHMARK_TEMPLATE(BM_BlitPalettedSurface, Avx2)->Apply(ScreenSizes);
+
+} // namespace
+} // namespace devilution
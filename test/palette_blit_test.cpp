@@ -0,0 +1,145 @@
+#include "engine/render/palette_blit.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+#include <gtest/gtest.h>
+
+#include "engine/render/blit_simd.hpp"
+#include "utils/sdl_wrap.h"
+
+#ifndef USE_SDL1
+namespace devilution {
+namespace {
+
+constexpr int SrcWidth = 53;
+constexpr int SrcHeight = 31;
+constexpr int DstWidth = 67;
+constexpr int DstHeight = 41;
+/** @brief Pixels the blit must not touch keep this value. */
+constexpr uint32_t Untouched = 0x12345678;
+
+struct BlitCase {
+	const char *name;
+	std::optional<SDL_Rect> srcRect;
+	std::optional<SDL_Rect> dstRect;
+	std::optional<SDL_Rect> clipRect;
+};
+
+const BlitCase Cases[] = {
+	{ "full", std::nullopt, std::nullopt, std::nullopt },
+	{ "offset", SDL_Rect { 3, 5, 37, 19 }, SDL_Rect { 11, 7, 0, 0 }, std::nullopt },
+	{ "negative destination origin", std::nullopt, SDL_Rect { -9, -4, 0, 0 }, std::nullopt },
+	{ "negative source origin", SDL_Rect { -6, -3, 40, 20 }, SDL_Rect { 2, 1, 0, 0 }, std::nullopt },
+	{ "past the destination edges", std::nullopt, SDL_Rect { 40, 25, 0, 0 }, std::nullopt },
+	{ "clipped", SDL_Rect { 1, 2, 50, 28 }, SDL_Rect { 4, 3, 0, 0 }, SDL_Rect { 9, 6, 33, 17 } },
+	{ "clipped on the right", std::nullopt, SDL_Rect { 20, 10, 0, 0 }, SDL_Rect { 0, 0, 45, 30 } },
+	{ "outside the clip rect", std::nullopt, SDL_Rect { 50, 35, 0, 0 }, SDL_Rect { 0, 0, 20, 20 } },
+};
+
+class PaletteBlitTest : public ::testing::TestWithParam<BlitIsa> {
+public:
+	void SetUp() override
+	{
+		if (!IsBlitIsaSupported(GetParam()))
+			GTEST_SKIP() << BlitIsaName(GetParam()) << " is not supported by this CPU";
+		previousIsa_ = GetBlitIsa();
+		SetBlitIsa(GetParam());
+
+		src_ = SDLWrap::CreateRGBSurfaceWithFormat(0, SrcWidth, SrcHeight, 8, SDL_PIXELFORMAT_INDEX8);
+		palette_ = SDLWrap::AllocPalette();
+		std::mt19937 rng(GetParam() == BlitIsa::Scalar ? 1 : 2);
+		std::uniform_int_distribution<int> dist(0, 255);
+		SDL_Color colors[256];
+		for (SDL_Color &color : colors)
+			color = { static_cast<Uint8>(dist(rng)), static_cast<Uint8>(dist(rng)), static_cast<Uint8>(dist(rng)), SDL_ALPHA_OPAQUE };
+		SDL_SetPaletteColors(palette_.get(), colors, 0, 256);
+		SDL_SetSurfacePalette(src_.get(), palette_.get());
+		for (int y = 0; y < SrcHeight; y++) {
+			auto *row = static_cast<uint8_t *>(src_->pixels) + static_cast<ptrdiff_t>(y) * src_->pitch;
+			for (int x = 0; x < SrcWidth; x++)
+				row[x] = static_cast<uint8_t>(dist(rng));
+		}
+	}
+
+	void TearDown() override
+	{
+		SetBlitIsa(previousIsa_);
+	}
+
+protected:
+	static SDLSurfaceUniquePtr CreateDestination(const BlitCase &blitCase)
+	{
+		SDLSurfaceUniquePtr dst = SDLWrap::CreateRGBSurfaceWithFormat(0, DstWidth, DstHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+		SDL_FillRect(dst.get(), nullptr, Untouched);
+		if (blitCase.clipRect)
+			SDL_SetClipRect(dst.get(), &*blitCase.clipRect);
+		return dst;
+	}
+
+	BlitIsa previousIsa_ = BlitIsa::Scalar;
+	SDLSurfaceUniquePtr src_;
+	SDLPaletteUniquePtr palette_;
+};
+
+TEST_P(PaletteBlitTest, MatchesSdlBlitSurface)
+{
+	for (const BlitCase &blitCase : Cases) {
+		SCOPED_TRACE(blitCase.name);
+		const SDL_Rect *srcRect = blitCase.srcRect ? &*blitCase.srcRect : nullptr;
+
+		SDLSurfaceUniquePtr expected = CreateDestination(blitCase);
+		std::optional<SDL_Rect> expectedRect = blitCase.dstRect;
+		ASSERT_EQ(SDL_BlitSurface(src_.get(), srcRect, expected.get(), expectedRect ? &*expectedRect : nullptr), 0) << SDL_GetError();
+
+		SDLSurfaceUniquePtr actual = CreateDestination(blitCase);
+		std::optional<SDL_Rect> actualRect = blitCase.dstRect;
+		ASSERT_TRUE(BlitPalettedSurface(src_.get(), srcRect, actual.get(), actualRect ? &*actualRect : nullptr));
+
+		if (expectedRect) {
+			EXPECT_EQ(actualRect->x, expectedRect->x);
+			EXPECT_EQ(actualRect->y, expectedRect->y);
+			EXPECT_EQ(actualRect->w, expectedRect->w);
+			EXPECT_EQ(actualRect->h, expectedRect->h);
+		}
+		for (int y = 0; y < DstHeight; y++) {
+			const auto *expectedRow = reinterpret_cast<const uint32_t *>(static_cast<const uint8_t *>(expected->pixels) + static_cast<ptrdiff_t>(y) * expected->pitch);
+			const auto *actualRow = reinterpret_cast<const uint32_t *>(static_cast<const uint8_t *>(actual->pixels) + static_cast<ptrdiff_t>(y) * actual->pitch);
+			for (int x = 0; x < DstWidth; x++) {
+				ASSERT_EQ(actualRow[x], expectedRow[x]) << "Pixel " << x << ", " << y << " differs";
+			}
+		}
+	}
+}
+
+TEST_P(PaletteBlitTest, PaletteChangesAreApplied)
+{
+	const BlitCase &blitCase = Cases[0];
+	SDLSurfaceUniquePtr first = CreateDestination(blitCase);
+	ASSERT_TRUE(BlitPalettedSurface(src_.get(), nullptr, first.get(), nullptr));
+
+	// Only the version changes, the palette stays at the same address.
+	const uint8_t index = *static_cast<const uint8_t *>(src_->pixels);
+	SDL_Color color = palette_->colors[index];
+	color.r ^= 0xFF;
+	SDL_SetPaletteColors(palette_.get(), &color, index, 1);
+
+	SDLSurfaceUniquePtr expected = CreateDestination(blitCase);
+	ASSERT_EQ(SDL_BlitSurface(src_.get(), nullptr, expected.get(), nullptr), 0) << SDL_GetError();
+	SDLSurfaceUniquePtr actual = CreateDestination(blitCase);
+	ASSERT_TRUE(BlitPalettedSurface(src_.get(), nullptr, actual.get(), nullptr));
+	EXPECT_EQ(std::memcmp(actual->pixels, expected->pixels, static_cast<size_t>(actual->pitch) * DstHeight), 0);
+	EXPECT_NE(*static_cast<const uint32_t *>(actual->pixels), *static_cast<const uint32_t *>(first->pixels));
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, PaletteBlitTest, ::testing::Values(BlitIsa::Scalar, BlitIsa::Avx2),
+    [](const ::testing::TestParamInfo<BlitIsa> &info) { return std::string(BlitIsaName(info.param)); });
+
+} // namespace
+} // namespace devilution
+#endif
@@ -1,9 +1,11 @@
 #include <cstddef>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include <benchmark/benchmark.h>
-#include <utility>
 
+#include "engine/flow_field.hpp"
 #include "engine/path.h"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
@@ -34,22 +36,43 @@ std::pair<Point, Point> FindStartDest(const Map &m)
 	return { start, dest };
 }
 
+/** @brief The pathfinding entry points to compare. */
+enum class PathApi : uint8_t {
+	/** @brief FindPath, with the predicates called through tl::function_ref. */
+	FunctionRef,
+	/** @brief PathSearchContext::findPath, with the predicates inlined. */
+	Inlined,
+};
+
+template <PathApi Api, typename PosOk>
+int RunFindPath(PathSearchContext &context, PosOk &&posOk, Point start, Point dest, int8_t *path, size_t maxPathLength)
+{
+	const auto canStep = [](Point, Point) { return true; };
+	if constexpr (Api == PathApi::FunctionRef) {
+		return FindPath(canStep, posOk, start, dest, path, maxPathLength);
+	} else {
+		return context.findPath(canStep, posOk, start, dest, path, maxPathLength);
+	}
+}
+
+template <PathApi Api>
 void BenchmarkMap(const Map &map, benchmark::State &state)
 {
 	const auto [start, dest] = FindStartDest(map);
 	const auto posOk = /*posOk=*/[&map](Point p) { return map[p] != '#'; };
 	constexpr size_t MaxPathLength = 25;
+	PathSearchContext context;
 	for (auto _ : state) {
 		int8_t path[MaxPathLength];
-		int result = FindPath(/*canStep=*/[](Point, Point) { return true; },
-		    posOk, start, dest, path, MaxPathLength);
+		int result = RunFindPath<Api>(context, posOk, start, dest, path, MaxPathLength);
 		benchmark::DoNotOptimize(result);
 	}
 }
 
+template <PathApi Api>
 void BM_SinglePath(benchmark::State &state)
 {
-	BenchmarkMap(
+	BenchmarkMap<Api>(
 	    Map {
 	        Size { 15, 15 },
 	        "###############"
@@ -70,9 +93,10 @@ void BM_SinglePath(benchmark::State &state)
 	    state);
 }
 
+template <PathApi Api>
 void BM_Bridges(benchmark::State &state)
 {
-	BenchmarkMap(
+	BenchmarkMap<Api>(
 	    Map {
 	        Size { 15, 15 },
 	        "###############"
@@ -93,9 +117,10 @@ void BM_Bridges(benchmark::State &state)
 	    state);
 }
 
+template <PathApi Api>
 void BM_NoPath(benchmark::State &state)
 {
-	BenchmarkMap(
+	BenchmarkMap<Api>(
 	    Map {
 	        Size { 15, 15 },
 	        "###############"
@@ -116,9 +141,10 @@ void BM_NoPath(benchmark::State &state)
 	    state);
 }
 
+template <PathApi Api>
 void BM_NoPathBig(benchmark::State &state)
 {
-	BenchmarkMap(
+	BenchmarkMap<Api>(
 	    Map {
 	        Size { 30, 30 },
 	        "##############################"
@@ -154,10 +180,76 @@ void BM_NoPathBig(benchmark::State &state)
 	    state);
 }
 
-BENCHMARK(BM_SinglePath);
-BENCHMARK(BM_Bridges);
-BENCHMARK(BM_NoPath);
-BENCHMARK(BM_NoPathBig);
+constexpr Point PackTarget { 56, 56 };
+
+/** @brief An open 112x112 level with pillars every few tiles, so that the searches have to go around something. */
+bool IsPackLevelPosOk(Point p)
+{
+	return p.x >= 0 && p.y >= 0 && p.x < 112 && p.y < 112 && (p.x % 6 != 0 || p.y % 6 != 0);
+}
+
+std::vector<Point> GetPack()
+{
+	std::vector<Point> pack;
+	for (int y = PackTarget.y - 18; y <= PackTarget.y + 18; y += 4) {
+		for (int x = PackTarget.x - 18; x <= PackTarget.x + 18; x += 4) {
+			if (Point { x, y } != PackTarget && IsPackLevelPosOk({ x, y }))
+				pack.push_back({ x, y });
+		}
+	}
+	return pack;
+}
+
+/**
+ * @brief A pack of monsters closing in on a player across the level, one search per monster.
+ *
+ * Every search reuses the same context, which is what the game does on every tick.
+ */
+template <PathApi Api>
+void BM_MonsterPack(benchmark::State &state)
+{
+	constexpr size_t MaxPathLength = 25;
+	const std::vector<Point> pack = GetPack();
+
+	PathSearchContext context;
+	for (auto _ : state) {
+		for (const Point monster : pack) {
+			int8_t path[MaxPathLength];
+			int result = RunFindPath<Api>(context, IsPackLevelPosOk, monster, PackTarget, path, MaxPathLength);
+			benchmark::DoNotOptimize(result);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pack.size()));
+}
+
+/** @brief The same pack sharing a single flow field, rebuilt once per tick. */
+void BM_MonsterPackFlowField(benchmark::State &state)
+{
+	const auto canStep = [](Point, Point) { return true; };
+	const std::vector<Point> pack = GetPack();
+
+	FlowField field;
+	for (auto _ : state) {
+		field.build(canStep, IsPackLevelPosOk, PackTarget);
+		for (const Point monster : pack) {
+			int8_t step = field.nextStep(canStep, IsPackLevelPosOk, monster);
+			benchmark::DoNotOptimize(step);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pack.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_SinglePath, PathApi::FunctionRef);
+BENCHMARK_TEMPLATE(BM_SinglePath, PathApi::Inlined);
+BENCHMARK_TEMPLATE(BM_Bridges, PathApi::FunctionRef);
+BENCHMARK_TEMPLATE(BM_Bridges, PathApi::Inlined);
+BENCHMARK_TEMPLATE(BM_NoPath, PathApi::FunctionRef);
+BENCHMARK_TEMPLATE(BM_NoPath, PathApi::Inlined);
+BENCHMARK_TEMPLATE(BM_NoPathBig, PathApi::FunctionRef);
+BENCHMARK_TEMPLATE(BM_NoPathBig, PathApi::Inlined);
+BENCHMARK_TEMPLATE(BM_MonsterPack, PathApi::FunctionRef);
+BENCHMARK_TEMPLATE(BM_MonsterPack, PathApi::Inlined);
+BENCHMARK(BM_MonsterPackFlowField);
 
 } // namespace
 } // namespace devilution
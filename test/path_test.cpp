@@ -3,12 +3,16 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <memory>
+#include <random>
 #include <span>
+#include <utility>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "engine/direction.hpp"
+#include "engine/flow_field.hpp"
 #include "utils/algorithm/container.hpp"
 
 namespace devilution {
@@ -162,6 +166,154 @@ TEST(PathTest, LongPaths)
 	CheckPath(startingPosition, startingPosition + Displacement { 25, 25 }, {});
 }
 
+TEST(PathTest, ReusedContextMatchesFreshContext)
+{
+	constexpr size_t MaxPathLength = 24;
+	const auto canStep = [](Point, Point) { return true; };
+
+	// A single context is reused for every search, so it is left dirty by searches over other maps and
+	// other start/target pairs. Every search is repeated on a context that has never been used.
+	const auto reused = std::make_unique<PathSearchContext>();
+	std::mt19937 rng(1234);
+	for (int map = 0; map < 20; map++) {
+		std::array<std::array<bool, PathSearchGridSize>, PathSearchGridSize> solid {};
+		std::uniform_int_distribution<int> coord(0, PathSearchGridSize - 1);
+		const int obstacles = map * 300;
+		for (int i = 0; i < obstacles; i++)
+			solid[coord(rng)][coord(rng)] = true;
+		const auto posOk = [&solid](Point p) { return !solid[p.x][p.y]; };
+
+		std::uniform_int_distribution<int> offset(-20, 20);
+		for (int search = 0; search < 50; search++) {
+			const Point start { coord(rng), coord(rng) };
+			const Point dest {
+				std::clamp(start.x + offset(rng), 0, PathSearchGridSize - 1),
+				std::clamp(start.y + offset(rng), 0, PathSearchGridSize - 1),
+			};
+
+			int8_t expected[MaxPathLength];
+			int8_t actual[MaxPathLength];
+			const auto fresh = std::make_unique<PathSearchContext>();
+			const int expectedLength = fresh->findPath(canStep, posOk, start, dest, expected, MaxPathLength);
+			const int actualLength = reused->findPath(canStep, posOk, start, dest, actual, MaxPathLength);
+			ASSERT_EQ(actualLength, expectedLength) << "Path length differs for a path from " << start << " to " << dest << " on map " << map;
+			EXPECT_THAT(ToSyms(std::span<const int8_t>(actual, actualLength)), ElementsAreArray(ToSyms(std::span<const int8_t>(expected, expectedLength))))
+			    << "Path steps differ for a path from " << start << " to " << dest << " on map " << map;
+		}
+	}
+}
+
+/** @brief Maps the steps returned by FindPath to their displacements. */
+constexpr std::array<Displacement, 9> StepDisplacements = { {
+    { 0, 0 },
+    { 0, -1 },
+    { -1, 0 },
+    { 1, 0 },
+    { 0, 1 },
+    { -1, -1 },
+    { 1, -1 },
+    { 1, 1 },
+    { -1, 1 },
+} };
+
+TEST(PathTest, FlowFieldMatchesFindPath)
+{
+	// Walls along x == 20 and y == 30 with a gap at { 20, 24 }, and a pillar next to the target
+	const auto posOk = [](Point p) { return !((p.x == 20 && p.y != 24) || (p.y == 30 && p.x > 10) || p == Point { 26, 25 }); };
+	const auto canStep = [](Point, Point) { return true; };
+	constexpr Point Target { 25, 25 };
+
+	FlowField field;
+	field.build(canStep, posOk, Target);
+	EXPECT_EQ(field.distance(Target), 0);
+	EXPECT_EQ(field.distance(Target + Displacement { FlowField::Radius + 1, 0 }), FlowField::Unreachable);
+
+	for (int x = Target.x - FlowField::Radius; x <= Target.x + FlowField::Radius; x++) {
+		for (int y = Target.y - FlowField::Radius; y <= Target.y + FlowField::Radius; y++) {
+			const Point start { x, y };
+			if (start == Target || !posOk(start))
+				continue;
+
+			int8_t path[MaxPathLengthMonsters];
+			const int pathLength = FindPath(canStep, posOk, start, Target, path, MaxPathLengthMonsters);
+			if (pathLength == 0)
+				continue;
+			int pathCost = 0;
+			for (Point p = start; const int8_t step : std::span<const int8_t>(path, pathLength)) {
+				const Point next = p + StepDisplacements[step];
+				pathCost += (p.x != next.x && p.y != next.y) ? PathDiagonalStepCost : PathAxisAlignedStepCost;
+				p = next;
+			}
+			ASSERT_EQ(field.distance(start), pathCost) << "Wrong cost for walking from " << start;
+
+			// Following the field takes as many steps as the path.
+			int steps = 0;
+			for (Point p = start; p != Target; steps++) {
+				const int8_t step = field.nextStep(canStep, posOk, p);
+				ASSERT_NE(step, 0) << "No step from " << p << " when walking from " << start;
+				p += StepDisplacements[step];
+			}
+			EXPECT_EQ(steps, pathLength) << "Wrong number of steps when walking from " << start;
+		}
+	}
+}
+
+TEST(PathTest, FlowFieldStepsAroundOccupiedTiles)
+{
+	const auto canStep = [](Point, Point) { return true; };
+	constexpr Point Target { 50, 50 };
+	constexpr Point Start { 50, 54 };
+
+	FlowField field;
+	field.build(canStep, [](Point) { return true; }, Target);
+
+	const int8_t straight = field.nextStep(canStep, [](Point) { return true; }, Start);
+	EXPECT_EQ(ToSyms(std::span<const int8_t>(&straight, 1)), ToSyms(std::vector<std::string> { "↑" }));
+
+	// With the tile in front taken, the next best steps are diagonals.
+	const int8_t blocked = field.nextStep(
+	    canStep, [](Point p) { return p != Point { 50, 53 }; }, Start);
+	EXPECT_THAT(ToSyms(std::span<const int8_t>(&blocked, 1)), ::testing::AnyOf(ToSyms(std::vector<std::string> { "↖" }), ToSyms(std::vector<std::string> { "↗" })));
+
+	// Sideways steps do not get any closer, so there is nowhere to go.
+	EXPECT_EQ(field.nextStep(canStep, [](Point p) { return p.y != 53; }, Start), 0);
+}
+
+TEST(PathTest, FlowFieldReachesEverythingFindPathDoes)
+{
+	// Monsters skip FindPath when the field towards their enemy says they cannot get there. The field only knows about
+	// walls, FindPath also has to walk around whoever is standing in the way, so it must never find a path the field missed.
+	constexpr Point Target { 56, 56 };
+	const auto canStep = [](Point from, Point to) { return (from.x + to.y) % 7 != 0; };
+	const auto fieldCanStep = [&](Point from, Point to) { return to == Target || canStep(from, to); };
+
+	std::mt19937 rng(4321);
+	for (int map = 0; map < 20; map++) {
+		std::array<std::array<bool, PathSearchGridSize>, PathSearchGridSize> solid {};
+		std::array<std::array<bool, PathSearchGridSize>, PathSearchGridSize> occupied {};
+		std::uniform_int_distribution<int> coord(0, PathSearchGridSize - 1);
+		for (int i = 0; i < map * 200; i++)
+			solid[coord(rng)][coord(rng)] = true;
+		for (int i = 0; i < 500; i++)
+			occupied[coord(rng)][coord(rng)] = true;
+		const auto walkable = [&solid](Point p) { return !solid[p.x][p.y]; };
+		const auto accessible = [&](Point p) { return walkable(p) && !occupied[p.x][p.y]; };
+
+		FlowField field;
+		field.build(fieldCanStep, walkable, Target);
+		for (int x = Target.x - FlowField::Radius - 1; x <= Target.x + FlowField::Radius + 1; x++) {
+			for (int y = Target.y - FlowField::Radius - 1; y <= Target.y + FlowField::Radius + 1; y++) {
+				const Point start { x, y };
+				if (start == Target || field.distance(start) != FlowField::Unreachable)
+					continue;
+				int8_t path[MaxPathLengthMonsters];
+				ASSERT_EQ(FindPath(canStep, accessible, start, Target, path, MaxPathLengthMonsters), 0)
+				    << "FindPath reaches the target from " << start << " on map " << map;
+			}
+		}
+	}
+}
+
 TEST(PathTest, FindClosest)
 {
 	{
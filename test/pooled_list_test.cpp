@@ -0,0 +1,80 @@
+#include <iterator>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "utils/pooled_list.hpp"
+
+namespace devilution {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<int> ToVector(const PooledList<int, 4> &list)
+{
+	return { list.begin(), list.end() };
+}
+
+TEST(PooledListTest, KeepsInsertionOrder)
+{
+	PooledList<int, 4> list;
+	for (int i = 0; i < 10; i++)
+		list.emplace_back(i);
+	EXPECT_EQ(list.size(), 10);
+	EXPECT_THAT(ToVector(list), ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(PooledListTest, RemoveIfKeepsOrderAndAddresses)
+{
+	PooledList<int, 4> list;
+	std::vector<int *> addresses;
+	for (int i = 0; i < 10; i++)
+		addresses.push_back(&list.emplace_back(i));
+
+	EXPECT_EQ(list.remove_if([](int value) { return value % 3 == 0; }), 4);
+	EXPECT_THAT(ToVector(list), ElementsAre(1, 2, 4, 5, 7, 8));
+	EXPECT_EQ(&list.front(), addresses[1]);
+	EXPECT_EQ(&list.back(), addresses[8]);
+}
+
+TEST(PooledListTest, ReusesRemovedElements)
+{
+	PooledList<int, 4> list;
+	int *first = &list.emplace_back(1);
+	list.emplace_back(2);
+	list.remove_if([](int value) { return value == 1; });
+	EXPECT_EQ(&list.emplace_back(3), first);
+	EXPECT_THAT(ToVector(list), ElementsAre(2, 3));
+}
+
+TEST(PooledListTest, VisitsElementsAddedWhileIterating)
+{
+	PooledList<int, 4> list;
+	list.emplace_back(3);
+	std::vector<int> visited;
+	for (int &value : list) {
+		visited.push_back(value);
+		if (value > 0)
+			list.emplace_back(value - 1);
+	}
+	EXPECT_THAT(visited, ElementsAre(3, 2, 1, 0));
+}
+
+TEST(PooledListTest, AdvanceFromBegin)
+{
+	PooledList<int, 4> list;
+	for (int i = 0; i < 6; i++)
+		list.emplace_back(i);
+	auto it = list.cbegin();
+	std::advance(it, 4);
+	EXPECT_EQ(*it, 4);
+	EXPECT_EQ(std::distance(it, list.cend()), 2);
+
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.begin(), list.end());
+}
+
+} // namespace
+} // namespace devilution
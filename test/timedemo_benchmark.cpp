@@ -0,0 +1,309 @@
+/**
+ * Replays every recording in test/fixtures/timedemo as fast as possible, running only the game logic like
+ * devilutionx-sim, and compares the throughput with test/fixtures/timedemo/benchmark_baseline.json.
+ *
+ * The process fails if a result is slower than its baseline by more than the tolerance stored in the baseline.
+ * Results without a baseline are only printed, so new recordings can be added before their numbers are recorded.
+ * Run with --timedemo_update_baseline to write the measured results to the baseline file instead,
+ * by default that is the copy in the build directory which then needs to be copied back to test/fixtures.
+ * Use --timedemo_baseline=<path> to compare against a different file.
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL.h>
+#include <benchmark/benchmark.h>
+#include <expected.hpp>
+#include <fmt/format.h>
+
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "engine/demomode.h"
+#include "game_mode.hpp"
+#include "headless_mode.hpp"
+#include "init.h"
+#include "items.h"
+#include "lua/lua.hpp"
+#include "monstdat.h"
+#include "options.h"
+#include "pfile.h"
+#include "playerdat.hpp"
+#include "utils/display.h"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+/** @brief Measured results by name, e.g. "WarriorLevel1to2/headless/ticks_per_second". */
+std::map<std::string, double> MeasuredResults;
+
+bool DummyGetHeroInfo(_uiheroinfo * /*pInfo*/)
+{
+	return true;
+}
+
+std::string TimedemoFixturesPath()
+{
+	return paths::BasePath() + "test/fixtures/timedemo/";
+}
+
+/** @brief Every folder with a recording, see timedemo_test for how they are laid out. */
+std::vector<std::string> FindRecordings()
+{
+	std::vector<std::string> recordings;
+	std::error_code error;
+	for (const auto &entry : std::filesystem::directory_iterator(TimedemoFixturesPath(), error)) {
+		if (entry.is_directory() && std::filesystem::exists(entry.path() / "demo_0.dmo"))
+			recordings.push_back(entry.path().filename().string());
+	}
+	std::sort(recordings.begin(), recordings.end());
+	return recordings;
+}
+
+tl::expected<demo::PlaybackStats, std::string> ReplayDemo(const std::string &recording)
+{
+	if (SDL_Init(
+#ifdef USE_SDL1
+	        0
+#else
+	        SDL_INIT_EVENTS
+#endif
+	        )
+	    <= -1) {
+		return tl::make_unexpected(std::string(SDL_GetError()));
+	}
+
+	HeadlessMode = true;
+	LoadCoreArchives();
+	LoadGameArchives();
+	if (!HaveSpawn() && !HaveDiabdat())
+		return tl::make_unexpected(std::string("This benchmark needs spawn.mpq or diabdat.mpq"));
+
+	const std::string recordingPath = TimedemoFixturesPath() + recording;
+	paths::SetPrefPath(recordingPath);
+	paths::SetConfigPath(recordingPath);
+
+	// Registers the actions with the options, doing it again for the next replay would add them twice
+	[[maybe_unused]] static const bool KeymapActionsDone = []() {
+		InitKeymapActions();
+		return true;
+	}();
+	LoadOptions();
+	demo::OverrideOptions();
+	LuaInitialize();
+
+	const int demoNumber = 0;
+
+	Players.resize(1);
+	MyPlayerId = demoNumber;
+	MyPlayer = &Players[MyPlayerId];
+	*MyPlayer = {};
+
+	gbIsSpawn = !HaveDiabdat();
+	gbIsHellfire = false;
+	gbMusicOn = false;
+	gbSoundOn = false;
+	demo::InitPlayBack(demoNumber, true);
+
+	LoadSpellData();
+	LoadPlayerDataFiles();
+	LoadMissileData();
+	LoadMonsterData();
+	LoadItemData();
+	LoadObjectData();
+	pfile_ui_set_hero_infos(DummyGetHeroInfo);
+	gbLoadGame = true;
+
+	demo::OverrideOptions();
+
+	AdjustToScreenGeometry(forceResolution);
+
+	StartGame(false, true);
+
+	const demo::PlaybackStats stats = demo::GetLastPlaybackStats();
+	const HeroCompareResult result = pfile_compare_hero_demo(demoNumber, true);
+	gbRunGame = false;
+	LuaShutdown();
+	init_cleanup();
+	SDL_Quit();
+
+	// A replay that went differently than when it was recorded doesn't measure the same work
+	if (result.status == HeroCompareResult::Difference)
+		return tl::make_unexpected(result.message);
+	return stats;
+}
+
+void BM_Timedemo(benchmark::State &state, const std::string &recording)
+{
+	const std::string prefix = fmt::format("{}/headless/", recording);
+	int64_t ticks = 0;
+	double seconds = 0;
+	for (auto _ : state) {
+		const tl::expected<demo::PlaybackStats, std::string> stats = ReplayDemo(recording);
+		if (!stats.has_value()) {
+			state.SkipWithError(stats.error().c_str());
+			return;
+		}
+		ticks += stats->logicTicks;
+		seconds += stats->milliseconds / 1000.0;
+		state.SetIterationTime(stats->milliseconds / 1000.0);
+	}
+	if (seconds <= 0)
+		return;
+
+	state.counters["ticks_per_second"] = static_cast<double>(ticks) / seconds;
+	MeasuredResults[prefix + "ticks_per_second"] = static_cast<double>(ticks) / seconds;
+}
+
+void RegisterTimedemoBenchmarks()
+{
+	for (const std::string &recording : FindRecordings()) {
+		const std::string name = fmt::format("BM_Timedemo/{}/headless", recording);
+		benchmark::RegisterBenchmark(name.c_str(), BM_Timedemo, recording)
+		    ->UseManualTime()
+		    ->Iterations(1)
+		    ->Unit(benchmark::kMillisecond);
+	}
+}
+
+struct Baseline {
+	/** @brief How much slower than the baseline a result may be, e.g. 0.15 for 15%. */
+	double tolerance = 0.15;
+	std::map<std::string, double> results;
+};
+
+/**
+ * @brief Reads a baseline written by WriteBaseline.
+ *
+ * The file is a flat JSON object, so this only looks for `"name": number` pairs rather than parsing arbitrary JSON.
+ */
+tl::expected<Baseline, std::string> ReadBaseline(const std::string &path)
+{
+	std::ifstream file(path);
+	if (!file)
+		return tl::make_unexpected(fmt::format("Failed to open {}", path));
+	const std::string contents { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+	Baseline baseline;
+	size_t pos = 0;
+	while ((pos = contents.find('"', pos)) != std::string::npos) {
+		const size_t nameEnd = contents.find('"', pos + 1);
+		if (nameEnd == std::string::npos)
+			break;
+		const std::string name = contents.substr(pos + 1, nameEnd - pos - 1);
+		pos = nameEnd + 1;
+		while (pos < contents.size() && std::isspace(static_cast<unsigned char>(contents[pos])) != 0)
+			pos++;
+		if (pos >= contents.size() || contents[pos] != ':')
+			continue;
+		pos++;
+		char *valueEnd;
+		const double value = std::strtod(contents.c_str() + pos, &valueEnd);
+		if (valueEnd == contents.c_str() + pos)
+			continue; // e.g. the "results" object
+		pos = valueEnd - contents.c_str();
+		if (name == "tolerance")
+			baseline.tolerance = value;
+		else
+			baseline.results[name] = value;
+	}
+	return baseline;
+}
+
+bool WriteBaseline(const std::string &path, double tolerance)
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+		return false;
+	file << "{\n";
+	file << fmt::format("  \"tolerance\": {},\n", tolerance);
+	file << "  \"results\": {";
+	const char *separator = "\n";
+	for (const auto &[name, value] : MeasuredResults) {
+		file << fmt::format("{}    \"{}\": {:.1f}", separator, name, value);
+		separator = ",\n";
+	}
+	file << (MeasuredResults.empty() ? "}\n" : "\n  }\n");
+	file << "}\n";
+	return static_cast<bool>(file);
+}
+
+/** @brief Returns false if any result is slower than the baseline allows. */
+bool CheckBaseline(const Baseline &baseline)
+{
+	bool ok = true;
+	for (const auto &[name, measured] : MeasuredResults) {
+		const auto it = baseline.results.find(name);
+		if (it == baseline.results.end()) {
+			fmt::print("{}: {:.1f}, no baseline, record one with --timedemo_update_baseline\n", name, measured);
+			continue;
+		}
+		const double minimum = it->second * (1.0 - baseline.tolerance);
+		const bool regressed = measured < minimum;
+		fmt::print("{}: {:.1f}, baseline {:.1f}{}\n", name, measured, it->second, regressed ? " REGRESSED" : "");
+		ok = ok && !regressed;
+	}
+	return ok;
+}
+
+int RunTimedemoBenchmarks(int argc, char **argv)
+{
+	benchmark::Initialize(&argc, argv);
+
+	std::string baselinePath;
+	bool updateBaseline = false;
+	int remaining = 1;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		if (arg == "--timedemo_update_baseline") {
+			updateBaseline = true;
+		} else if (arg.starts_with("--timedemo_baseline=")) {
+			baselinePath = arg.substr(std::string_view("--timedemo_baseline=").size());
+		} else {
+			argv[remaining++] = argv[i];
+		}
+	}
+	argc = remaining;
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	if (baselinePath.empty())
+		baselinePath = TimedemoFixturesPath() + "benchmark_baseline.json";
+
+	const tl::expected<Baseline, std::string> baseline = ReadBaseline(baselinePath);
+	if (!baseline.has_value() && !updateBaseline) {
+		fmt::print(stderr, "{}\n", baseline.error());
+		return 1;
+	}
+
+	RegisterTimedemoBenchmarks();
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	if (updateBaseline) {
+		const double tolerance = baseline.has_value() ? baseline->tolerance : Baseline {}.tolerance;
+		if (!WriteBaseline(baselinePath, tolerance)) {
+			fmt::print(stderr, "Failed to write {}\n", baselinePath);
+			return 1;
+		}
+		fmt::print("Wrote {}\n", baselinePath);
+		return 0;
+	}
+	return CheckBaseline(*baseline) ? 0 : 1;
+}
+
+} // namespace
+} // namespace devilution
+
+// Has its own main instead of benchmark_main, to fail when a result regressed.
+int main(int argc, char **argv)
+{
+	return devilution::RunTimedemoBenchmarks(argc, argv);
+}
@@ -0,0 +1,43 @@
+#include "utils/worker_pool.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(WorkerPoolTest, RunsEveryIteration)
+{
+	WorkerPool pool { 3 };
+	std::vector<std::atomic<int>> calls(1000);
+	for (int loop = 0; loop < 100; loop++) {
+		pool.parallelFor(static_cast<unsigned>(calls.size()), [&](unsigned i) { calls[i]++; });
+	}
+	for (const std::atomic<int> &count : calls)
+		EXPECT_EQ(count, 100);
+}
+
+TEST(WorkerPoolTest, LoopRightAfterConstruction)
+{
+	// The workers may not have started waiting yet when the first loop begins.
+	for (int attempt = 0; attempt < 200; attempt++) {
+		WorkerPool pool { 4 };
+		std::atomic<unsigned> sum = 0;
+		pool.parallelFor(64, [&](unsigned i) { sum += i; });
+		ASSERT_EQ(sum, 64 * 63 / 2) << "attempt " << attempt;
+	}
+}
+
+TEST(WorkerPoolTest, WithoutWorkerThreads)
+{
+	WorkerPool pool { 0 };
+	EXPECT_EQ(pool.concurrency(), 1);
+	unsigned calls = 0;
+	pool.parallelFor(5, [&](unsigned) { calls++; });
+	EXPECT_EQ(calls, 5);
+}
+
+} // namespace
+} // namespace devilution